@@ -58,6 +58,30 @@ def build_lib():
         extra_cmake="",
     )
 
+    # Second runtime variant with the compact Value layout, linked by
+    # `nbis build --compact-values` (the layouts are not ABI-compatible).
+    _build_static_lib(
+        name="runtime_compact",
+        sources=runtime_sources,
+        runtime_root=runtime_root,
+        dest=dest_runtime,
+        extra_cmake="",
+        extra_cflags="-DNBIS_COMPACT_VALUE",
+    )
+
+    # LTO variant linked by `nbis build --pgo` so runtime hot paths
+    # (number_binop, the values.h dispatch shims) can inline into
+    # generated code at final link. Fat objects keep the archive usable
+    # with plain ar/ranlib and in non-LTO links.
+    _build_static_lib(
+        name="runtime_lto",
+        sources=runtime_sources,
+        runtime_root=runtime_root,
+        dest=dest_runtime,
+        extra_cmake="",
+        extra_cflags="-flto -ffat-lto-objects",
+    )
+
     if graphics_sources:
         _build_static_lib(
             name="graphics",
@@ -67,6 +91,24 @@ def build_lib():
             extra_cmake=_graphics_pkgconfig_cmake,
         )
 
+        _build_static_lib(
+            name="graphics_compact",
+            sources=graphics_sources,
+            runtime_root=runtime_root,
+            dest=dest_runtime,
+            extra_cmake=_graphics_pkgconfig_cmake,
+            extra_cflags="-DNBIS_COMPACT_VALUE",
+        )
+
+        _build_static_lib(
+            name="graphics_lto",
+            sources=graphics_sources,
+            runtime_root=runtime_root,
+            dest=dest_runtime,
+            extra_cmake=_graphics_pkgconfig_cmake,
+            extra_cflags="-flto -ffat-lto-objects",
+        )
+
     for file in runtime_root.rglob("*"):
         if file.is_file() and (
             file.suffix == ".h"
@@ -87,6 +129,7 @@ def _build_static_lib(
     runtime_root: Path,
     dest: Path,
     extra_cmake: str,
+    extra_cflags: str = "",
 ) -> None:
     """Compile sources into lib{name}.a and copy it to dest."""
     if not sources:
@@ -100,7 +143,7 @@ def _build_static_lib(
 
     fno_plt = "-fno-plt" if is_unix else ""
 
-    if name == "graphics":
+    if name.startswith("graphics"):
         include_extras = """\
     ${SDL2_INCLUDE_DIRS}
     ${SDL2_TTF_INCLUDE_DIRS}"""
@@ -133,7 +176,7 @@ target_include_directories({name} PRIVATE
 )
 
 target_compile_options({name} PRIVATE
-    -fPIC -O3 {fno_plt} -march=native
+    -fPIC -O3 {fno_plt} -march=native {extra_cflags}
 {compile_extras}
 )
 
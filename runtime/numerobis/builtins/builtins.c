@@ -4,19 +4,30 @@
 #include "../libs/sds.h"
 #include "../runtime.h"
 #include "../types/list.h"
+#include "../types/map.h"
+#include "../types/strbuilder.h"
 #include "../types/number.h"
 #include "../types/str.h"
 #include "../units/units.h"
 #include "../utils/utils.h"
 #include "../values.h"
+#include "../types/file.h"
+#include "../types/task.h"
+#include "../types/vec.h"
 #include "echo.h"
+#include "file_builtins.h"
+#include "gc_builtins.h"
+#include "json_builtins.h"
 #include "math_builtins.h"
+#include "parallel_builtins.h"
 #include "random_builtins.h"
 #include "time_builtins.h"
 
+#include "../libs/bdwgc/include/gc.h"
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -52,7 +63,7 @@ static Value numerobis_builtin_input(Value *args) {
 }
 
 static Value numerobis_builtin_indexof(Value *args) {
-  Value *self = args[2].list->items;
+  Value *self = list_items(args[2].list);
   Value target = args[1];
 
   for (unsigned int i = 0; i < arrlen(self); i++) {
@@ -67,46 +78,182 @@ static Value numerobis_builtin_indexof(Value *args) {
   return int__init__(-1L, U_ONE);
 }
 
+// All fragments of one split are carved out of a single GC block (see
+// str_carve in types/str.c) instead of one allocation each.
 static Value numerobis_builtin_split(Value *args) {
   sds self = args[2].str;
-  sds sep = args[1].type == VALUE_EMPTY ? sdsnew(" ") : args[1].str;
+  const char *sep = args[1].type == VALUE_EMPTY ? " " : args[1].str;
+  size_t sep_len = strlen(sep);
+  size_t self_len = sdslen(self);
 
   Value *result_arr = NULL;
 
-  if (sdslen(sep) == 0) {
+  if (sep_len == 0) {
+    // Empty separator: one fragment per code point.
+    size_t n = count_utf8_code_points(self);
+    char *block = GC_MALLOC_ATOMIC(self_len + n * str_carve_size(0));
+    size_t off = 0;
+    arrsetcap(result_arr, n);
+
     const char *p = self;
-    const char *end = self + sdslen(self);
+    const char *end = self + self_len;
     while (p < end) {
       const char *next = utf8_next_char(p, end);
-      size_t char_len = (size_t)(next - p);
-
-      sds char_sds = sdsnewlen(p, char_len);
-      Value val = str__init__(char_sds);
-      arrput(result_arr, val);
-
+      arrput(result_arr, str__init__(str_carve(block, &off, p, next - p)));
       p = next;
     }
-  } else {
-    int count;
-    sds *parts =
-        sdssplitlen(self, (int)sdslen(self), sep, (int)sdslen(sep), &count);
-
-    if (parts) {
-      for (int i = 0; i < count; i++) {
-        Value val = str__init__(sdsnew(parts[i]));
-        arrput(result_arr, val);
-      }
-      sdsfreesplitres(parts, count);
+    return list__init__(result_arr);
+  }
+
+  // Count separator occurrences first to size the block exactly.
+  size_t count = 0;
+  for (size_t i = 0; sep_len <= self_len && i <= self_len - sep_len;) {
+    if (memcmp(self + i, sep, sep_len) == 0) {
+      count++;
+      i += sep_len;
+    } else {
+      i++;
     }
   }
 
-  if (args[1].type == VALUE_EMPTY) {
-    sdsfree(sep);
+  size_t n = count + 1;
+  char *block =
+      GC_MALLOC_ATOMIC(self_len - count * sep_len + n * str_carve_size(0));
+  size_t off = 0;
+  arrsetcap(result_arr, n);
+
+  size_t start = 0;
+  for (size_t i = 0; sep_len <= self_len && i <= self_len - sep_len;) {
+    if (memcmp(self + i, sep, sep_len) == 0) {
+      arrput(result_arr,
+             str__init__(str_carve(block, &off, self + start, i - start)));
+      i += sep_len;
+      start = i;
+    } else {
+      i++;
+    }
   }
+  arrput(result_arr,
+         str__init__(str_carve(block, &off, self + start, self_len - start)));
 
   return list__init__(result_arr);
 }
 
+// Substring search
+//
+// All four builtins run over raw sds bytes: a UTF-8 code point never
+// matches in the middle of another, so byte search finds exactly the
+// code point occurrences. The core is memchr-anchored — libc's memchr
+// is vectorized, so candidate positions arrive a cache line at a time
+// and memcmp only runs on real first-byte hits.
+
+static const char *_str_search(const char *hay, size_t hlen,
+                               const char *needle, size_t nlen) {
+  if (nlen == 0)
+    return hay;
+  if (nlen > hlen)
+    return NULL;
+
+  const char *p = hay;
+  const char *last = hay + hlen - nlen;
+  while (p <= last) {
+    p = memchr(p, needle[0], (size_t)(last - p) + 1);
+    if (!p)
+      return NULL;
+    if (memcmp(p + 1, needle + 1, nlen - 1) == 0)
+      return p;
+    p++;
+  }
+  return NULL;
+}
+
+/* Code point index of the first occurrence, -1 if absent. */
+static Value numerobis_builtin_find(Value *args) {
+  sds self = args[2].str;
+  sds sub = args[1].str;
+
+  const char *hit = _str_search(self, sdslen(self), sub, sdslen(sub));
+  if (!hit)
+    return int__init__(-1L, U_ONE);
+
+  // Indexing is by code point, so translate the byte offset.
+  long index = 0;
+  for (const char *p = self; p < hit; p++)
+    index += (*p & 0xC0) != 0x80;
+  return int__init__(index, U_ONE);
+}
+
+static Value numerobis_builtin_contains(Value *args) {
+  sds self = args[2].str;
+  sds sub = args[1].str;
+  return bool__init__(_str_search(self, sdslen(self), sub, sdslen(sub)) !=
+                      NULL);
+}
+
+/* Non-overlapping occurrence count; the empty pattern counts one match
+ * per gap, like slicing semantics would suggest. */
+static Value numerobis_builtin_count(Value *args) {
+  sds self = args[2].str;
+  sds sub = args[1].str;
+  size_t nlen = sdslen(sub);
+
+  if (nlen == 0)
+    return int__init__((long)_str_len(self) + 1, U_ONE);
+
+  long count = 0;
+  const char *p = self;
+  size_t left = sdslen(self);
+  const char *hit;
+  while ((hit = _str_search(p, left, sub, nlen)) != NULL) {
+    count++;
+    left -= (size_t)(hit - p) + nlen;
+    p = hit + nlen;
+  }
+  return int__init__(count, U_ONE);
+}
+
+/* Replaces every non-overlapping occurrence; the output is sized exactly
+ * and written in one pass. */
+static Value numerobis_builtin_replace(Value *args) {
+  sds self = args[3].str;
+  sds old = args[1].str;
+  sds new = args[2].str;
+  size_t self_len = sdslen(self);
+  size_t old_len = sdslen(old);
+  size_t new_len = sdslen(new);
+
+  if (old_len == 0 || old_len > self_len)
+    return str__init__(sdsdup(self));
+
+  size_t count = 0;
+  const char *p = self;
+  size_t left = self_len;
+  const char *hit;
+  while ((hit = _str_search(p, left, old, old_len)) != NULL) {
+    count++;
+    left -= (size_t)(hit - p) + old_len;
+    p = hit + old_len;
+  }
+  if (count == 0)
+    return str__init__(sdsdup(self));
+
+  sds out = sdsnewlen(NULL, self_len + count * (new_len - old_len));
+  char *w = out;
+  p = self;
+  left = self_len;
+  while ((hit = _str_search(p, left, old, old_len)) != NULL) {
+    memcpy(w, p, (size_t)(hit - p));
+    w += hit - p;
+    memcpy(w, new, new_len);
+    w += new_len;
+    left -= (size_t)(hit - p) + old_len;
+    p = hit + old_len;
+  }
+  memcpy(w, p, left);
+
+  return str__init__(out);
+}
+
 static inline Value numerobis_builtin_list_len(Value *args) {
   return int__init__((long)_list_len(args[1].list), U_ONE);
 }
@@ -132,11 +279,162 @@ static Value numerobis_builtin_cli_args(Value *args) {
   return list__init__(result_arr);
 }
 
+// Memoization
+//
+// memoize! wraps a callable in a closure whose env carries a native
+// open-addressing cache (linear probing, power-of-two capacity, same
+// family as Map), keyed on a combined hash of the argument values.
+// Repeat calls with the same arguments return the cached result without
+// entering the wrapped function. Note that a function's internal
+// recursion goes through its own closure, not the wrapper; for
+// memoized recursion, recurse through the memoized binding.
+
+typedef struct {
+  uint64_t hash;
+  Value *key; /* copy of the argument values, arity entries */
+  Value result;
+  bool full;
+} MemoSlot;
+
+typedef struct {
+  Value fn;
+  long arity;
+  MemoSlot *slots;
+  uint32_t cap; /* always a power of two */
+  uint32_t used;
+} MemoEnv;
+
+static inline uint64_t _memo_mix(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+static uint64_t _memo_hash_arg(Value v) {
+  switch (v.type) {
+  case VALUE_NUMBER: {
+    /* Integral doubles hash like the equal integer, matching __eq__. */
+    uint64_t bits;
+    if (v.number.kind == NUM_INT64) {
+      bits = (uint64_t)v.number.i64;
+    } else {
+      double d = v.number.f64;
+      if (d == (double)(long)d)
+        bits = (uint64_t)(long)d;
+      else
+        memcpy(&bits, &d, sizeof(bits));
+    }
+    return _memo_mix(bits ^ v.number.unit);
+  }
+  case VALUE_BOOL:
+    return _memo_mix(2 + (uint64_t)v.boolean);
+  case VALUE_STR: {
+    uint64_t h = 0xcbf29ce484222325;
+    size_t n = v.str ? sdslen(v.str) : 0;
+    for (size_t i = 0; i < n; i++)
+      h = (h ^ (unsigned char)v.str[i]) * 0x100000001b3;
+    return h;
+  }
+  case VALUE_NONE:
+  case VALUE_EMPTY:
+    /* No payload to hash — the zeroed pointer field would alias an
+     * identity hash. One fixed value per type. */
+    return _memo_mix(3 + (uint64_t)v.type);
+  default:
+    /* Reference types key on identity. */
+    return _memo_mix((uint64_t)(uintptr_t)v.list);
+  }
+}
+
+static uint64_t _memo_hash(const Value *args, long arity) {
+  uint64_t h = 0x9e3779b97f4a7c15;
+  for (long i = 0; i < arity; i++)
+    h = _memo_mix(h ^ _memo_hash_arg(args[i]));
+  return h;
+}
+
+static bool _memo_key_eq(const Value *a, const Value *b, long arity) {
+  for (long i = 0; i < arity; i++) {
+    if (a[i].type != b[i].type)
+      return false;
+    /* NONE/EMPTY have no __eq__ entry in NUMEROBIS_METHODS; same type
+     * means equal (an omitted optional arrives as EMPTY). */
+    if (a[i].type == VALUE_NONE || a[i].type == VALUE_EMPTY)
+      continue;
+    if (!__eq__(a[i], b[i]).boolean)
+      return false;
+  }
+  return true;
+}
+
+static void _memo_insert(MemoEnv *m, uint64_t h, const Value *key,
+                         Value result);
+
+static void _memo_grow(MemoEnv *m) {
+  MemoSlot *old = m->slots;
+  uint32_t old_cap = m->cap;
+  m->cap *= 2;
+  m->used = 0;
+  m->slots = GC_MALLOC(m->cap * sizeof(MemoSlot));
+  for (uint32_t i = 0; i < old_cap; i++)
+    if (old[i].full)
+      _memo_insert(m, old[i].hash, old[i].key, old[i].result);
+}
+
+static void _memo_insert(MemoEnv *m, uint64_t h, const Value *key,
+                         Value result) {
+  if (m->used * 2 >= m->cap)
+    _memo_grow(m);
+  uint32_t mask = m->cap - 1;
+  uint32_t i = (uint32_t)h & mask;
+  while (m->slots[i].full)
+    i = (i + 1) & mask;
+  Value *copy = GC_MALLOC(m->arity * sizeof(Value));
+  memcpy(copy, key, m->arity * sizeof(Value));
+  m->slots[i] = (MemoSlot){.hash = h, .key = copy, .result = result,
+                           .full = true};
+  m->used++;
+}
+
+static Value _memo_call(void *env, Value *args) {
+  MemoEnv *m = env;
+  uint64_t h = _memo_hash(args + 1, m->arity);
+  uint32_t mask = m->cap - 1;
+
+  for (uint32_t i = (uint32_t)h & mask; m->slots[i].full;
+       i = (i + 1) & mask)
+    if (m->slots[i].hash == h &&
+        _memo_key_eq(m->slots[i].key, args + 1, m->arity))
+      return m->slots[i].result;
+
+  /* The wrapped callee reads args[0] as its own closure (self-recursion
+   * goes through it), so swap the wrapper out before forwarding. */
+  args[0] = m->fn;
+  Value result = __call__(m->fn, args, (size_t)m->arity);
+  _memo_insert(m, h, args + 1, result);
+  return result;
+}
+
+static Value numerobis_builtin_memoize(Value *args) {
+  MemoEnv *m = GC_MALLOC(sizeof(MemoEnv));
+  m->fn = args[1];
+  m->arity = _i64(args[2]);
+  m->cap = 64;
+  m->used = 0;
+  m->slots = GC_MALLOC(m->cap * sizeof(MemoSlot));
+  return closure__init__(_memo_call, m, EMPTY);
+}
+
 void u_register_builtin_externs(void) {
+  u_extern_register("memoize", numerobis_builtin_memoize);
   u_extern_register("echo", echo);
   u_extern_register("input", numerobis_builtin_input);
   u_extern_register("List.indexof", numerobis_builtin_indexof);
   u_extern_register("Str.split", numerobis_builtin_split);
+  u_extern_register("Str.find", numerobis_builtin_find);
+  u_extern_register("Str.contains", numerobis_builtin_contains);
+  u_extern_register("Str.count", numerobis_builtin_count);
+  u_extern_register("Str.replace", numerobis_builtin_replace);
 
   u_extern_register("Str.len", numerobis_builtin_str_len);
   u_extern_register("List.len", numerobis_builtin_list_len);
@@ -147,5 +445,14 @@ void u_register_builtin_externs(void) {
   numerobis_math_register_builtins();
   numerobis_random_register_builtins();
   numerobis_time_register_builtins();
+  numerobis_file_register_builtins();
+  numerobis_gc_register_builtins();
+  numerobis_json_register_builtins();
+  numerobis_parallel_register_builtins();
   numerobis_list_register_externs();
+  numerobis_map_register_externs();
+  numerobis_strbuilder_register_externs();
+  numerobis_file_register_externs();
+  numerobis_task_register_externs();
+  numerobis_vec_register_externs();
 }
@@ -2,6 +2,7 @@
 #include "../constants.h"
 #include "../libs/gc_stb_ds.h"
 #include "../libs/sds.h"
+#include "../types/list.h"
 #include "../types/str.h"
 #include "../types/struct.h"
 #include "../units/eval.h"
@@ -10,76 +11,83 @@
 #include <stdbool.h>
 #include <stdio.h>
 
-static __thread bool _echo_in_list = false;
+// The whole value — nested lists included — is rendered into one sds and
+// flushed with a single fwrite, instead of one printf per element under
+// the stdio lock.
 
-static inline void echo_array(Value *arr) {
-  if (!arr) {
-    printf("[]");
-    return;
-  }
-  bool was_in_list = _echo_in_list;
-  _echo_in_list = true;
+static void echo_cat(sds *out, Value val, bool in_list);
 
-  printf("[");
+static void echo_array(sds *out, Value *arr) {
+  *out = sdscatlen(*out, "[", 1);
   for (size_t i = 0; i < arrlen(arr); i++) {
     if (i > 0)
-      printf(", ");
-    Value elem = arr[i];
-    Value args[4] = {EMPTY, elem, EMPTY_STR, EMPTY};
-    echo(args);
+      *out = sdscatlen(*out, ", ", 2);
+    echo_cat(out, arr[i], true);
   }
-  printf("]");
-
-  _echo_in_list = was_in_list;
+  *out = sdscatlen(*out, "]", 1);
 }
 
-Value echo(Value *args) {
-  Value val = args[1];
-  Value end = args[2];
-
+static void echo_cat(sds *out, Value val, bool in_list) {
   switch (val.type) {
-  case VALUE_NUMBER: {
-    sds num_str = print_number(&val.number);
-    printf("%s", num_str);
+  case VALUE_NUMBER:
+    *out = print_number_cat(*out, &val.number);
     break;
-  }
   case VALUE_STR:
-    if (_echo_in_list)
-      printf("\"%s\"", val.str);
+    if (in_list)
+      *out = sdscatfmt(*out, "\"%S\"", val.str);
     else
-      printf("%s", val.str);
+      *out = sdscatlen(*out, val.str, sdslen(val.str));
     break;
   case VALUE_BOOL:
-    printf("%s", val.boolean ? "true" : "false");
+    *out = sdscat(*out, val.boolean ? "true" : "false");
     break;
   case VALUE_LIST:
-    echo_array(val.list->items);
+    echo_array(out, list_items(val.list));
     break;
   case VALUE_RANGE:
-    printf("<Range %p>", (void *)val.range);
+    *out = sdscatprintf(*out, "<Range %p>", (void *)val.range);
     break;
   case VALUE_CLOSURE:
-    printf("<Function %p>", (void *)val.closure);
+    *out = sdscatprintf(*out, "<Function %p>", (void *)val.closure);
     break;
   case VALUE_EXTERN_FN:
-    printf("<Extern Function %p>", (void *)val.extern_fn);
+    *out = sdscatprintf(*out, "<Extern Function %p>", (void *)val.extern_fn);
     break;
   case VALUE_STRUCT: {
     sds struct_str = struct__cstr__(val);
-    printf("%s", struct_str);
+    *out = sdscatlen(*out, struct_str, sdslen(struct_str));
     sdsfree(struct_str);
     break;
   }
+  case VALUE_MAP:
+  case VALUE_STRBUILDER:
+  case VALUE_FILE:
+  case VALUE_TASK:
+  case VALUE_VEC: {
+    Value s = __str__(val, NULL);
+    *out = sdscatlen(*out, s.str, sdslen(s.str));
+    break;
+  }
   case VALUE_NONE:
   case VALUE_EMPTY:
-    printf("None");
+    *out = sdscatlen(*out, "None", 4);
     break;
   }
+}
 
-  if (end.type == VALUE_STR) {
-    printf("%s", end.str);
-  } else {
-    printf("\n");
-  }
+Value echo(Value *args) {
+  Value val = args[1];
+  Value end = args[2];
+
+  sds out = sdsempty();
+  echo_cat(&out, val, false);
+
+  if (end.type == VALUE_STR)
+    out = sdscatlen(out, end.str, sdslen(end.str));
+  else
+    out = sdscatlen(out, "\n", 1);
+
+  fwrite(out, 1, sdslen(out), stdout);
+  sdsfree(out);
   return val;
 }
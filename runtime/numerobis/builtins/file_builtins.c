@@ -0,0 +1,565 @@
+#include "file_builtins.h"
+
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/gc_stb_ds.h"
+#include "../libs/sds.h"
+#include "../types/bool.h"
+#include "../types/file.h"
+#include "../types/list.h"
+#include "../types/map.h"
+#include "../types/number.h"
+#include "../types/str.h"
+#include "../types/struct.h"
+#include "../values.h"
+
+#include "../libs/bdwgc/include/gc.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/* Whole-file helpers. Reads map the file instead of looping over
+ * read(2): the kernel hands the page cache to us directly and a single
+ * copy moves the bytes into their final allocation (a string must carry
+ * its inline sds header, so a true zero-copy view is off the table —
+ * see str_carve in types/str.c). Streaming access goes through the
+ * buffered File handle in types/file.c instead. */
+
+/* Maps `path` read-only. Returns NULL (with *size set) for an empty or
+ * missing file so callers can distinguish the two via *ok. */
+static char *_map_file(const char *path, size_t *size, int *fd_out) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    u_throw(909, NULL, NULL);
+
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    close(fd);
+    u_throw(909, NULL, NULL);
+  }
+
+  *size = (size_t)st.st_size;
+  *fd_out = fd;
+  if (*size == 0)
+    return NULL;
+
+  char *map = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED) {
+    close(fd);
+    u_throw(910, NULL, NULL);
+  }
+  madvise(map, *size, MADV_SEQUENTIAL);
+  return map;
+}
+
+static Value numerobis_builtin_read(Value *args) {
+  size_t size;
+  int fd;
+  char *map = _map_file(args[1].str, &size, &fd);
+
+  if (map == NULL) {
+    close(fd);
+    return str__init__(sdsempty());
+  }
+
+  sds out = sdsnewlen(map, size);
+  munmap(map, size);
+  close(fd);
+  return str__init__(out);
+}
+
+// Like Str.split, every line is carved out of one GC block sized in a
+// counting pass; line terminators ('\n' and "\r\n") are dropped and a
+// trailing newline does not produce an empty last element.
+static Value numerobis_builtin_read_lines(Value *args) {
+  size_t size;
+  int fd;
+  char *map = _map_file(args[1].str, &size, &fd);
+
+  Value *result_arr = NULL;
+  if (map == NULL) {
+    close(fd);
+    return list__init__(result_arr);
+  }
+
+  size_t n = 0, dropped = 0;
+  for (size_t i = 0; i < size; i++) {
+    if (map[i] == '\n') {
+      n++;
+      dropped += (i > 0 && map[i - 1] == '\r') ? 2 : 1;
+    }
+  }
+  if (map[size - 1] != '\n')
+    n++;
+
+  char *block = GC_MALLOC_ATOMIC(size - dropped + n * str_carve_size(0));
+  size_t off = 0;
+  arrsetcap(result_arr, n);
+
+  const char *p = map;
+  const char *end = map + size;
+  while (p < end) {
+    const char *nl = memchr(p, '\n', (size_t)(end - p));
+    const char *stop = nl != NULL ? nl : end;
+    if (stop > p && stop[-1] == '\r')
+      stop--;
+    arrput(result_arr,
+           str__init__(str_carve(block, &off, p, (size_t)(stop - p))));
+    p = nl != NULL ? nl + 1 : end;
+  }
+
+  munmap(map, size);
+  close(fd);
+  return list__init__(result_arr);
+}
+
+static void _write_file(const char *path, int flags, const char *data,
+                        size_t len) {
+  int fd = open(path, flags, 0644);
+  if (fd < 0)
+    u_throw(909, NULL, NULL);
+  file_write_all(fd, data, len);
+  close(fd);
+}
+
+static Value numerobis_builtin_write(Value *args) {
+  _write_file(args[1].str, O_WRONLY | O_CREAT | O_TRUNC, args[2].str,
+              sdslen(args[2].str));
+  return NONE;
+}
+
+static Value numerobis_builtin_append(Value *args) {
+  _write_file(args[1].str, O_WRONLY | O_CREAT | O_APPEND, args[2].str,
+              sdslen(args[2].str));
+  return NONE;
+}
+
+// One writev per 256 fragments instead of one write per line; the
+// batching itself lives in file_writev_all (types/file.c).
+static Value numerobis_builtin_write_lines(Value *args) {
+  int fd = open(args[1].str, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    u_throw(909, NULL, NULL);
+
+  Value *items = list_items(args[2].list);
+  const char *end = args[3].type == VALUE_EMPTY ? "\n" : args[3].str;
+  size_t end_len = args[3].type == VALUE_EMPTY ? 1 : sdslen(args[3].str);
+
+  struct iovec iov[256];
+  int cnt = 0;
+  for (size_t i = 0; i < arrlen(items); i++) {
+    iov[cnt].iov_base = items[i].str;
+    iov[cnt].iov_len = sdslen(items[i].str);
+    cnt++;
+    if (end_len > 0) {
+      iov[cnt].iov_base = (void *)end;
+      iov[cnt].iov_len = end_len;
+      cnt++;
+    }
+    if (cnt > 254) {
+      file_writev_all(fd, iov, cnt);
+      cnt = 0;
+    }
+  }
+  if (cnt > 0)
+    file_writev_all(fd, iov, cnt);
+
+  close(fd);
+  return NONE;
+}
+
+// Binary checkpointing
+//
+// `save` walks a Value tree once and streams a tagged binary form;
+// packed numeric lists go out as one fwrite of the raw f64 payload
+// (unit hash and length in the tag header), so a checkpoint dominated
+// by numeric state moves at disk bandwidth instead of being formatted
+// and re-parsed as text. `load` maps the file and rebuilds the tree:
+// packed payloads land in packed storage with a single memcpy, which
+// keeps element boxing as lazy as it was before the round-trip (the
+// stb_ds header in front of the payload is why the copy exists at all —
+// the same constraint that rules out zero-copy strings above).
+//
+// Struct values are recorded against a name table and remapped to the
+// running program's STRUCT_REGISTRY ids on load, so a checkpoint
+// survives recompilation as long as the struct shapes still match.
+// Unit hashes are stored verbatim: they are stable for a given program
+// and only label the payload, never its layout.
+
+enum {
+  CK_INT = 0,
+  CK_NUM,
+  CK_BOOL,
+  CK_STR,
+  CK_LIST_PACKED,
+  CK_LIST,
+  CK_LIST_COLS,
+  CK_STRUCT,
+  CK_MAP,
+  CK_NONE,
+};
+
+#define CK_MAGIC "NBCK"
+#define CK_VERSION 1u
+
+static void _ck_collect(Value v, bool *seen) {
+  switch (v.type) {
+  case VALUE_LIST: {
+    List *l = v.list;
+    if (l == NULL || l->packed != NULL)
+      break;
+    if (l->cols != NULL) {
+      seen[l->cstruct] = true;
+      size_t fieldc = STRUCT_REGISTRY[l->cstruct].fieldc;
+      size_t len = _list_len(l);
+      for (size_t f = 0; f < fieldc; f++)
+        for (size_t i = 0; i < len; i++)
+          _ck_collect(l->cols[f][i], seen);
+      break;
+    }
+    Value *items = list_items(l);
+    for (size_t i = 0; i < arrlen(items); i++)
+      _ck_collect(items[i], seen);
+    break;
+  }
+  case VALUE_STRUCT: {
+    long id = v.strukt[0].number.i64;
+    seen[id] = true;
+    for (size_t i = 1; i <= STRUCT_REGISTRY[id].fieldc; i++)
+      _ck_collect(v.strukt[i], seen);
+    break;
+  }
+  case VALUE_MAP: {
+    Map *m = v.map;
+    for (uint32_t i = 0; i < m->cap; i++) {
+      if (m->state[i] != 1)
+        continue;
+      _ck_collect(m->slots[i].key, seen);
+      _ck_collect(m->slots[i].val, seen);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+static void _ck_w(FILE *fp, const void *p, size_t len) {
+  if (fwrite(p, 1, len, fp) != len)
+    u_throw(910, NULL, NULL);
+}
+
+static void _ck_w_u8(FILE *fp, uint8_t v) { _ck_w(fp, &v, 1); }
+static void _ck_w_u32(FILE *fp, uint32_t v) { _ck_w(fp, &v, 4); }
+static void _ck_w_u64(FILE *fp, uint64_t v) { _ck_w(fp, &v, 8); }
+
+static void _ck_write(FILE *fp, Value v) {
+  switch (v.type) {
+  case VALUE_NUMBER:
+    _ck_w_u8(fp, v.number.kind == NUM_INT64 ? CK_INT : CK_NUM);
+    _ck_w_u64(fp, v.number.unit);
+    _ck_w(fp, v.number.kind == NUM_INT64 ? (void *)&v.number.i64
+                                         : (void *)&v.number.f64,
+          8);
+    break;
+  case VALUE_BOOL:
+    _ck_w_u8(fp, CK_BOOL);
+    _ck_w_u8(fp, v.boolean ? 1 : 0);
+    break;
+  case VALUE_STR:
+    _ck_w_u8(fp, CK_STR);
+    _ck_w_u64(fp, sdslen(v.str));
+    _ck_w(fp, v.str, sdslen(v.str));
+    break;
+  case VALUE_LIST: {
+    List *l = v.list;
+    size_t len = _list_len(l);
+    if (l != NULL && l->packed != NULL) {
+      _ck_w_u8(fp, CK_LIST_PACKED);
+      _ck_w_u64(fp, l->unit);
+      _ck_w_u64(fp, len);
+      _ck_w(fp, l->packed + _list_off(l), len * sizeof(double));
+      break;
+    }
+    if (l != NULL && l->cols != NULL) {
+      size_t fieldc = STRUCT_REGISTRY[l->cstruct].fieldc;
+      _ck_w_u8(fp, CK_LIST_COLS);
+      _ck_w_u32(fp, (uint32_t)l->cstruct);
+      _ck_w_u64(fp, len);
+      for (size_t f = 0; f < fieldc; f++)
+        for (size_t i = 0; i < len; i++)
+          _ck_write(fp, l->cols[f][i]);
+      break;
+    }
+    Value *items = l != NULL ? list_items(l) : NULL;
+    _ck_w_u8(fp, CK_LIST);
+    _ck_w_u64(fp, items != NULL ? arrlen(items) : 0);
+    for (size_t i = 0; items != NULL && i < arrlen(items); i++)
+      _ck_write(fp, items[i]);
+    break;
+  }
+  case VALUE_STRUCT: {
+    long id = v.strukt[0].number.i64;
+    _ck_w_u8(fp, CK_STRUCT);
+    _ck_w_u32(fp, (uint32_t)id);
+    for (size_t i = 1; i <= STRUCT_REGISTRY[id].fieldc; i++)
+      _ck_write(fp, v.strukt[i]);
+    break;
+  }
+  case VALUE_MAP: {
+    Map *m = v.map;
+    _ck_w_u8(fp, CK_MAP);
+    _ck_w_u64(fp, m->used);
+    for (uint32_t i = 0; i < m->cap; i++) {
+      if (m->state[i] != 1)
+        continue;
+      _ck_write(fp, m->slots[i].key);
+      _ck_write(fp, m->slots[i].val);
+    }
+    break;
+  }
+  default:
+    _ck_w_u8(fp, CK_NONE);
+    break;
+  }
+}
+
+static Value numerobis_builtin_save(Value *args) {
+  FILE *fp = fopen(args[1].str, "wb");
+  if (fp == NULL)
+    u_throw(909, NULL, NULL);
+
+  _ck_w(fp, CK_MAGIC, 4);
+  _ck_w_u32(fp, CK_VERSION);
+
+  // Name table for every struct id the tree references, so load can
+  // remap ids even if the program was recompiled in between.
+  bool *seen = GC_MALLOC_ATOMIC(STRUCT_REGISTRY_LEN * sizeof(bool));
+  memset(seen, 0, STRUCT_REGISTRY_LEN * sizeof(bool));
+  _ck_collect(args[2], seen);
+
+  uint32_t count = 0;
+  for (size_t id = 0; id < STRUCT_REGISTRY_LEN; id++)
+    count += seen[id];
+  _ck_w_u32(fp, count);
+  for (size_t id = 0; id < STRUCT_REGISTRY_LEN; id++) {
+    if (!seen[id])
+      continue;
+    const StructInfo *meta = &STRUCT_REGISTRY[id];
+    _ck_w_u32(fp, (uint32_t)id);
+    _ck_w_u64(fp, strlen(meta->name));
+    _ck_w(fp, meta->name, strlen(meta->name));
+    _ck_w_u32(fp, (uint32_t)meta->fieldc);
+  }
+
+  _ck_write(fp, args[2]);
+
+  if (fclose(fp) != 0)
+    u_throw(910, NULL, NULL);
+  return NONE;
+}
+
+typedef struct {
+  const char *p;
+  const char *end;
+  long *remap; /* saved struct id -> STRUCT_REGISTRY id */
+  size_t remap_len;
+} CkReader;
+
+static void _ck_need(CkReader *r, size_t n) {
+  if ((size_t)(r->end - r->p) < n)
+    u_throw(911, NULL, NULL);
+}
+
+static uint8_t _ck_u8(CkReader *r) {
+  _ck_need(r, 1);
+  return (uint8_t)*r->p++;
+}
+
+static uint32_t _ck_u32(CkReader *r) {
+  _ck_need(r, 4);
+  uint32_t v;
+  memcpy(&v, r->p, 4);
+  r->p += 4;
+  return v;
+}
+
+static uint64_t _ck_u64(CkReader *r) {
+  _ck_need(r, 8);
+  uint64_t v;
+  memcpy(&v, r->p, 8);
+  r->p += 8;
+  return v;
+}
+
+static long _ck_struct_id(CkReader *r) {
+  uint32_t saved = _ck_u32(r);
+  if (saved >= r->remap_len || r->remap[saved] < 0)
+    u_throw(911, NULL, NULL);
+  return r->remap[saved];
+}
+
+static Value _ck_read(CkReader *r) {
+  switch (_ck_u8(r)) {
+  case CK_INT: {
+    uint64_t unit = _ck_u64(r);
+    uint64_t raw = _ck_u64(r);
+    long i64;
+    memcpy(&i64, &raw, 8);
+    return int__init__(i64, unit);
+  }
+  case CK_NUM: {
+    uint64_t unit = _ck_u64(r);
+    uint64_t raw = _ck_u64(r);
+    double f64;
+    memcpy(&f64, &raw, 8);
+    return num__init__(f64, unit);
+  }
+  case CK_BOOL:
+    return bool__init__(_ck_u8(r) != 0);
+  case CK_STR: {
+    uint64_t len = _ck_u64(r);
+    _ck_need(r, len);
+    sds s = sdsnewlen(r->p, len);
+    r->p += len;
+    return str__init__(s);
+  }
+  case CK_LIST_PACKED: {
+    uint64_t unit = _ck_u64(r);
+    uint64_t len = _ck_u64(r);
+    // Validate by division: len comes from the stream, and
+    // len * sizeof(double) can wrap for huge counts, letting a corrupt
+    // length pass the bounds check and read out of bounds.
+    if (len > (uint64_t)(r->end - r->p) / sizeof(double))
+      u_throw(911, NULL, NULL);
+    double *packed = NULL;
+    arrsetlen(packed, len);
+    memcpy(packed, r->p, len * sizeof(double));
+    r->p += len * sizeof(double);
+    return list_packed__init__(packed, unit);
+  }
+  case CK_LIST: {
+    uint64_t len = _ck_u64(r);
+    // Every element occupies at least its tag byte, so the remaining
+    // stream bounds the count; reject before preallocating from it.
+    if (len > (uint64_t)(r->end - r->p))
+      u_throw(911, NULL, NULL);
+    Value *items = NULL;
+    arrsetcap(items, len);
+    for (uint64_t i = 0; i < len; i++)
+      arrput(items, _ck_read(r));
+    return list__init__(items);
+  }
+  case CK_LIST_COLS: {
+    long id = _ck_struct_id(r);
+    uint64_t len = _ck_u64(r);
+    if (len > (uint64_t)(r->end - r->p))
+      u_throw(911, NULL, NULL);
+    size_t fieldc = STRUCT_REGISTRY[id].fieldc;
+    Value **cols = GC_MALLOC(fieldc * sizeof(Value *));
+    for (size_t f = 0; f < fieldc; f++) {
+      cols[f] = NULL;
+      arrsetcap(cols[f], len);
+      for (uint64_t i = 0; i < len; i++)
+        arrput(cols[f], _ck_read(r));
+    }
+    return list_cols__init__(cols, id);
+  }
+  case CK_STRUCT: {
+    long id = _ck_struct_id(r);
+    size_t fieldc = STRUCT_REGISTRY[id].fieldc;
+    Value v = struct__init__(id, (long)fieldc);
+    for (size_t i = 1; i <= fieldc; i++)
+      v.strukt[i] = _ck_read(r);
+    return v;
+  }
+  case CK_MAP: {
+    uint64_t len = _ck_u64(r);
+    Value m = map__init__();
+    for (uint64_t i = 0; i < len; i++) {
+      Value key = _ck_read(r);
+      Value val = _ck_read(r);
+      __setitem__(m, key, val, NULL);
+    }
+    return m;
+  }
+  case CK_NONE:
+    return NONE;
+  default:
+    u_throw(911, NULL, NULL);
+  }
+  return NONE;
+}
+
+static Value numerobis_builtin_load(Value *args) {
+  size_t size;
+  int fd;
+  char *map = _map_file(args[1].str, &size, &fd);
+  if (map == NULL) {
+    close(fd);
+    u_throw(911, NULL, NULL);
+  }
+
+  CkReader r = {map, map + size, NULL, 0};
+  if (size < 8 || memcmp(r.p, CK_MAGIC, 4) != 0)
+    u_throw(911, NULL, NULL);
+  r.p += 4;
+  if (_ck_u32(&r) != CK_VERSION)
+    u_throw(911, NULL, NULL);
+
+  // Rebuild the struct id mapping from the name table.
+  uint32_t count = _ck_u32(&r);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t saved = _ck_u32(&r);
+    uint64_t name_len = _ck_u64(&r);
+    _ck_need(&r, name_len);
+    const char *name = r.p;
+    r.p += name_len;
+    uint32_t fieldc = _ck_u32(&r);
+
+    if (saved >= r.remap_len) {
+      size_t old = r.remap_len;
+      r.remap_len = saved + 1;
+      r.remap = GC_REALLOC(r.remap, r.remap_len * sizeof(long));
+      for (size_t j = old; j < r.remap_len; j++)
+        r.remap[j] = -1;
+    }
+    r.remap[saved] = -1;
+    for (size_t id = 0; id < STRUCT_REGISTRY_LEN; id++) {
+      const StructInfo *meta = &STRUCT_REGISTRY[id];
+      if (strlen(meta->name) == name_len &&
+          memcmp(meta->name, name, name_len) == 0 && meta->fieldc == fieldc) {
+        r.remap[saved] = (long)id;
+        break;
+      }
+    }
+    if (r.remap[saved] < 0)
+      u_throw(911, NULL, NULL);
+  }
+
+  Value result = _ck_read(&r);
+
+  munmap(map, size);
+  close(fd);
+  return result;
+}
+
+static Value numerobis_builtin_exists(Value *args) {
+  return bool__init__(access(args[1].str, F_OK) == 0);
+}
+
+void numerobis_file_register_builtins(void) {
+  u_extern_register("read", numerobis_builtin_read);
+  u_extern_register("read__lines", numerobis_builtin_read_lines);
+  u_extern_register("write", numerobis_builtin_write);
+  u_extern_register("write__lines", numerobis_builtin_write_lines);
+  u_extern_register("append", numerobis_builtin_append);
+  u_extern_register("exists", numerobis_builtin_exists);
+  u_extern_register("save", numerobis_builtin_save);
+  u_extern_register("load", numerobis_builtin_load);
+}
@@ -0,0 +1,6 @@
+#ifndef NUMEROBIS_FILE_BUILTINS_H
+#define NUMEROBIS_FILE_BUILTINS_H
+
+void numerobis_file_register_builtins(void);
+
+#endif
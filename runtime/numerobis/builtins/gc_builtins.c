@@ -0,0 +1,70 @@
+#include "gc_builtins.h"
+
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/sds.h"
+#include "../types/map.h"
+#include "../types/number.h"
+#include "../types/str.h"
+#include "../units/units.h"
+#include "../values.h"
+
+#include "../libs/bdwgc/include/gc.h"
+
+// Runtime knobs for the collector, mirroring the bdwgc environment
+// variables (GC_INITIAL_HEAP_SIZE, GC_FREE_SPACE_DIVISOR, GC_MARKERS,
+// GC_ENABLE_INCREMENTAL) so deployments can tune without re-launching
+// under a different environment.
+
+static Value numerobis_builtin_gc_collect(Value *args) {
+  GC_gcollect();
+  return NONE;
+}
+
+static Value numerobis_builtin_gc_enable_incremental(Value *args) {
+  GC_enable_incremental();
+  return NONE;
+}
+
+// Lower divisor = more free space kept after a collection = fewer
+// collections for allocation-heavy phases (bdwgc default is 3).
+static Value numerobis_builtin_gc_set_free_space_divisor(Value *args) {
+  long d = args[1].number.i64;
+  if (d >= 1)
+    GC_set_free_space_divisor((unsigned long)d);
+  return NONE;
+}
+
+// Grows the heap up front so a known allocation burst never triggers
+// growth-by-collection.
+static Value numerobis_builtin_gc_expand_heap(Value *args) {
+  long bytes = args[1].number.i64;
+  if (bytes > 0)
+    GC_expand_hp((size_t)bytes);
+  return NONE;
+}
+
+static void _gc_stat(Value m, const char *key, long val) {
+  __setitem__(m, str__init__(sdsnew(key)), int__init__(val, U_ONE), NULL);
+}
+
+static Value numerobis_builtin_gc_stats(Value *args) {
+  Value m = map__init__();
+  _gc_stat(m, "collections", (long)GC_get_gc_no());
+  _gc_stat(m, "heap_bytes", (long)GC_get_heap_size());
+  _gc_stat(m, "free_bytes", (long)GC_get_free_bytes());
+  _gc_stat(m, "full_gc_time_ms", (long)GC_get_full_gc_total_time());
+  _gc_stat(m, "free_space_divisor", (long)GC_get_free_space_divisor());
+  _gc_stat(m, "parallel_markers", (long)GC_get_parallel());
+  return m;
+}
+
+void numerobis_gc_register_builtins(void) {
+  u_extern_register("gc__collect", numerobis_builtin_gc_collect);
+  u_extern_register("gc__enable__incremental",
+                    numerobis_builtin_gc_enable_incremental);
+  u_extern_register("gc__set__free__space__divisor",
+                    numerobis_builtin_gc_set_free_space_divisor);
+  u_extern_register("gc__expand__heap", numerobis_builtin_gc_expand_heap);
+  u_extern_register("gc__stats", numerobis_builtin_gc_stats);
+}
@@ -0,0 +1,6 @@
+#ifndef NUMEROBIS_GC_BUILTINS_H
+#define NUMEROBIS_GC_BUILTINS_H
+
+void numerobis_gc_register_builtins(void);
+
+#endif
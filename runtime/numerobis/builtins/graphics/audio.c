@@ -0,0 +1,163 @@
+#include "audio.h"
+
+#include "../../libs/gc_stb_ds.h"
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AUDIO_FREQ 44100
+#define AUDIO_CHANNELS 2
+#define AUDIO_VOICES 16
+
+/* Decoded sound, already in the device format (interleaved f32). */
+typedef struct {
+  char *path;
+  float *samples;
+  Uint32 len; /* in floats */
+} SoundEntry;
+
+/* A playing instance. The main thread fills the fields while `active`
+ * is 0, publishes with an atomic store; the callback owns the voice
+ * until it finishes and clears `active`. Sample buffers are immutable
+ * once loaded, so no other synchronization is needed. */
+typedef struct {
+  const float *samples;
+  Uint32 len;
+  Uint32 pos;
+  SDL_atomic_t active;
+} Voice;
+
+static SoundEntry *_sounds = NULL;
+static Voice _voices[AUDIO_VOICES];
+static SDL_AudioDeviceID _audio_dev = 0;
+
+static void _audio_callback(void *userdata, Uint8 *stream, int len) {
+  (void)userdata;
+  float *out = (float *)stream;
+  int n = len / (int)sizeof(float);
+  SDL_memset(stream, 0, len);
+
+  for (int v = 0; v < AUDIO_VOICES; v++) {
+    Voice *voice = &_voices[v];
+    if (!SDL_AtomicGet(&voice->active))
+      continue;
+
+    Uint32 remain = voice->len - voice->pos;
+    Uint32 take = (Uint32)n < remain ? (Uint32)n : remain;
+    const float *src = voice->samples + voice->pos;
+    for (Uint32 i = 0; i < take; i++)
+      out[i] += src[i];
+    voice->pos += take;
+    if (voice->pos >= voice->len)
+      SDL_AtomicSet(&voice->active, 0);
+  }
+
+  for (int i = 0; i < n; i++) {
+    if (out[i] > 1.f)
+      out[i] = 1.f;
+    else if (out[i] < -1.f)
+      out[i] = -1.f;
+  }
+}
+
+static bool _audio_ensure_device(void) {
+  if (_audio_dev)
+    return true;
+
+  if (!SDL_WasInit(SDL_INIT_AUDIO) && SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+    fprintf(stderr, "audio: SDL_InitSubSystem: %s\n", SDL_GetError());
+    return false;
+  }
+
+  SDL_AudioSpec want = {.freq = AUDIO_FREQ,
+                        .format = AUDIO_F32SYS,
+                        .channels = AUDIO_CHANNELS,
+                        .samples = 1024,
+                        .callback = _audio_callback};
+  _audio_dev = SDL_OpenAudioDevice(NULL, 0, &want, NULL, 0);
+  if (!_audio_dev) {
+    fprintf(stderr, "audio: SDL_OpenAudioDevice: %s\n", SDL_GetError());
+    return false;
+  }
+  SDL_PauseAudioDevice(_audio_dev, 0);
+  return true;
+}
+
+static SoundEntry *_load_sound(const char *path) {
+  for (ptrdiff_t i = 0; i < arrlen(_sounds); i++)
+    if (strcmp(_sounds[i].path, path) == 0)
+      return &_sounds[i];
+
+  SDL_AudioSpec spec;
+  Uint8 *buf;
+  Uint32 len;
+  if (!SDL_LoadWAV(path, &spec, &buf, &len)) {
+    fprintf(stderr, "audio: SDL_LoadWAV(%s): %s\n", path, SDL_GetError());
+    return NULL;
+  }
+
+  SDL_AudioCVT cvt;
+  int rc = SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq,
+                             AUDIO_F32SYS, AUDIO_CHANNELS, AUDIO_FREQ);
+  if (rc < 0) {
+    fprintf(stderr, "audio: SDL_BuildAudioCVT: %s\n", SDL_GetError());
+    SDL_FreeWAV(buf);
+    return NULL;
+  }
+
+  float *samples;
+  Uint32 out_len;
+  if (rc > 0) {
+    cvt.len = (int)len;
+    cvt.buf = malloc((size_t)cvt.len * cvt.len_mult);
+    memcpy(cvt.buf, buf, len);
+    SDL_ConvertAudio(&cvt);
+    samples = (float *)cvt.buf;
+    out_len = (Uint32)(cvt.len_cvt / sizeof(float));
+  } else {
+    samples = malloc(len);
+    memcpy(samples, buf, len);
+    out_len = len / sizeof(float);
+  }
+  SDL_FreeWAV(buf);
+
+  SoundEntry e = {.path = strdup(path), .samples = samples, .len = out_len};
+  arrput(_sounds, e);
+  return &_sounds[arrlen(_sounds) - 1];
+}
+
+void _audio_play(const char *path) {
+  if (!_audio_ensure_device())
+    return;
+  SoundEntry *s = _load_sound(path);
+  if (!s)
+    return;
+
+  for (int v = 0; v < AUDIO_VOICES; v++) {
+    Voice *voice = &_voices[v];
+    if (SDL_AtomicGet(&voice->active))
+      continue;
+    voice->samples = s->samples;
+    voice->len = s->len;
+    voice->pos = 0;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&voice->active, 1);
+    return;
+  }
+  /* All voices busy: drop the sound rather than cut one off. */
+}
+
+void _cleanup_audio(void) {
+  if (_audio_dev) {
+    SDL_CloseAudioDevice(_audio_dev);
+    _audio_dev = 0;
+  }
+  for (ptrdiff_t i = 0; i < arrlen(_sounds); i++) {
+    free(_sounds[i].samples);
+    free(_sounds[i].path);
+  }
+  arrfree(_sounds);
+  _sounds = NULL;
+}
@@ -0,0 +1,13 @@
+#ifndef NUMEROBIS_AUDIO_H
+#define NUMEROBIS_AUDIO_H
+
+/* Mixing audio backend. Sounds are decoded and converted to the device
+ * format once, then played through a fixed pool of voices mixed in the
+ * audio callback, so overlapping sounds neither fail nor reload the
+ * file. Voice handoff to the callback is a single atomic flag — no
+ * locks on either side. */
+
+void _audio_play(const char *path);
+void _cleanup_audio(void);
+
+#endif
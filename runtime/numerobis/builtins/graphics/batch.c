@@ -0,0 +1,49 @@
+#include "batch.h"
+#include "state.h"
+
+#include "../../libs/gc_stb_ds.h"
+#include <SDL2/SDL.h>
+
+static SDL_Vertex *_verts;
+static SDL_Color _color;
+
+void _batch_set_color(Color c) {
+  _color = (SDL_Color){c.r, c.g, c.b, c.a};
+}
+
+static inline void _vtx(float x, float y) {
+  SDL_Vertex v = {
+      .position = {x, y}, .color = _color, .tex_coord = {0.f, 0.f}};
+  arrput(_verts, v);
+}
+
+void _batch_rect(float x, float y, float w, float h) {
+  _vtx(x, y);
+  _vtx(x + w, y);
+  _vtx(x, y + h);
+  _vtx(x + w, y);
+  _vtx(x + w, y + h);
+  _vtx(x, y + h);
+}
+
+/* Same pixel coverage as SDL_RenderDrawLine(x0, y, x1, y): endpoints
+ * inclusive, one pixel tall. */
+void _batch_hline(int x0, int x1, int y) {
+  if (x0 > x1) {
+    int t = x0;
+    x0 = x1;
+    x1 = t;
+  }
+  _batch_rect((float)x0, (float)y, (float)(x1 - x0 + 1), 1.f);
+}
+
+void _batch_point(int x, int y) {
+  _batch_rect((float)x, (float)y, 1.f, 1.f);
+}
+
+void _batch_flush(void) {
+  if (!_renderer || !_verts || arrlen(_verts) == 0)
+    return;
+  SDL_RenderGeometry(_renderer, NULL, _verts, (int)arrlen(_verts), NULL, 0);
+  arrsetlen(_verts, 0);
+}
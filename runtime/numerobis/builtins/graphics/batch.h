@@ -0,0 +1,20 @@
+#ifndef NUMEROBIS_GFX_BATCH_H
+#define NUMEROBIS_GFX_BATCH_H
+
+#include "color.h"
+
+/* Geometry batching for the frame render. Filled primitives decompose
+ * into axis-aligned spans (hlines, quads, points), which accumulate
+ * here as colored triangles and hit the driver in one
+ * SDL_RenderGeometry call instead of one SDL_Render* call per span.
+ * Colors ride on the vertices, so color changes do not split the
+ * batch; only genuinely immediate output (diagonal outlines, text
+ * textures) forces a flush first, which keeps draw order intact. */
+
+void _batch_set_color(Color c);
+void _batch_rect(float x, float y, float w, float h);
+void _batch_hline(int x0, int x1, int y);
+void _batch_point(int x, int y);
+void _batch_flush(void);
+
+#endif
@@ -1,4 +1,6 @@
 #include "fonts.h"
+#include "state.h"
+
 #include "../../libs/gc_stb_ds.h"
 #include "../../libs/sds.h"
 
@@ -193,7 +195,83 @@ TTF_Font *_get_font(const char *path, int size, int style) {
   return font;
 }
 
+/* Text runs repeat across frames (HUD labels, counters), so a fresh
+ * rasterization and GPU upload per draw is mostly wasted work. Cached
+ * runs cost a texture blit instead. Bounded by LRU so churning text
+ * (e.g. a frame counter) cannot grow the cache without limit. */
+#define TEXT_CACHE_MAX 256
+
+static TextRunEntry *_text_cache = NULL;
+static unsigned long _text_clock = 0;
+
+static void _text_entry_free(TextRunEntry *e) {
+  SDL_DestroyTexture(e->tex);
+  free(e->str);
+  free(e->path);
+}
+
+SDL_Texture *_get_text_texture(const char *str, const char *path, int size,
+                               int style, int *w, int *h) {
+  _text_clock++;
+
+  for (ptrdiff_t i = 0; i < arrlen(_text_cache); i++) {
+    TextRunEntry *e = &_text_cache[i];
+    if (e->size == size && e->style == style && strcmp(e->str, str) == 0 &&
+        strcmp(e->path, path) == 0) {
+      e->last_used = _text_clock;
+      *w = e->w;
+      *h = e->h;
+      return e->tex;
+    }
+  }
+
+  TTF_Font *font = _get_font(path, size, style);
+  if (!font)
+    return NULL;
+
+  SDL_Color white = {255, 255, 255, 255};
+  SDL_Surface *surf = TTF_RenderUTF8_Blended(font, str, white);
+  if (!surf)
+    return NULL;
+
+  SDL_Texture *tex = SDL_CreateTextureFromSurface(_renderer, surf);
+  TextRunEntry e = {.str = strdup(str),
+                    .path = strdup(path),
+                    .size = size,
+                    .style = style,
+                    .tex = tex,
+                    .w = surf->w,
+                    .h = surf->h,
+                    .last_used = _text_clock};
+  SDL_FreeSurface(surf);
+  if (!tex) {
+    free(e.str);
+    free(e.path);
+    return NULL;
+  }
+
+  if (arrlen(_text_cache) >= TEXT_CACHE_MAX) {
+    ptrdiff_t oldest = 0;
+    for (ptrdiff_t i = 1; i < arrlen(_text_cache); i++)
+      if (_text_cache[i].last_used < _text_cache[oldest].last_used)
+        oldest = i;
+    _text_entry_free(&_text_cache[oldest]);
+    _text_cache[oldest] = e;
+  } else {
+    arrput(_text_cache, e);
+  }
+
+  *w = e.w;
+  *h = e.h;
+  return e.tex;
+}
+
 void _cleanup_fonts(void) {
+  for (ptrdiff_t i = 0; i < arrlen(_text_cache); i++)
+    _text_entry_free(&_text_cache[i]);
+  arrfree(_text_cache);
+  _text_cache = NULL;
+
   for (ptrdiff_t i = 0; i < arrlen(_font_cache); i++) {
     TTF_CloseFont(_font_cache[i].value);
     free(_font_cache[i].key.path);
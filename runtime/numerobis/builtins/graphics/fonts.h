@@ -23,9 +23,24 @@ typedef struct {
   TTF_Font *value;
 } FontEntry;
 
+/* Cached shaped text run: rasterized once (white, full alpha) and
+ * colorized per draw with texture color/alpha mod, so color is not
+ * part of the key. */
+typedef struct {
+  char *str;
+  char *path;
+  int size;
+  int style;
+  SDL_Texture *tex;
+  int w, h;
+  unsigned long last_used;
+} TextRunEntry;
+
 const char *_default_font(void);
 const char *_resolve_font_name(const char *name);
 TTF_Font *_get_font(const char *path, int size, int style);
+SDL_Texture *_get_text_texture(const char *str, const char *path, int size,
+                               int style, int *w, int *h);
 
 void _cleanup_fonts(void);
 
@@ -2,10 +2,13 @@
 #include "../../extern.h"
 #include "../../libs/gc_stb_ds.h"
 #include "../../types/bool.h"
+#include "../../types/list.h"
 #include "../../types/number.h"
 #include "../../units/units.h"
 #include "../../utils/utils.h"
 #include "../../values.h"
+#include "audio.h"
+#include "batch.h"
 #include "fonts.h"
 #include "primitives.h"
 #include "state.h"
@@ -22,12 +25,11 @@
 static inline int _tx_x(double x) { return (int)((x * _scale)) + _tx; }
 static inline int _tx_y(double y) { return (int)((y * _scale)) + _ty; }
 static inline int _tx_dim(double dim) { return (int)(dim * _scale); }
-volatile Uint8 *audio_pos; // global pointer to the audio buffer to be played
-volatile Uint32 audio_len; // remaining length of the sample we have to play
-static Uint32 wav_length;  // length of our sample
-static Uint8 *wav_buffer;  // buffer containing our audio file
-static SDL_AudioSpec wav_spec; // the specs of our piece of music
-static volatile int audio_device_open = 0;
+
+static inline void _queue_push(DrawCmd cmd) {
+  cmd.layer = _cur_layer;
+  arrput(_queue, cmd);
+}
 
 static inline bool _arg_filled(Value v) {
   return v.type != VALUE_EMPTY ? _bool(v) : true;
@@ -40,7 +42,7 @@ static inline Color _arg_color(Value v) {
 static int _parse_style_list(Value style_val) {
   if (style_val.type != VALUE_LIST)
     return TTF_STYLE_NORMAL;
-  Value *arr = style_val.list->items;
+  Value *arr = list_items(style_val.list);
   int flags = TTF_STYLE_NORMAL;
   for (unsigned int i = 0; i < arrlen(arr); i++) {
     Value item = arr[i];
@@ -117,7 +119,7 @@ static Value numerobis_builtin_rect(Value *args) {
                  .rect = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2])),
                           _tx_dim(_f64(args[3])), _tx_dim(_f64(args[4])),
                           _arg_filled(args[6])}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -128,7 +130,7 @@ static Value numerobis_builtin_rounded_rect(Value *args) {
                  .rrect = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2])),
                            _tx_dim(_f64(args[3])), _tx_dim(_f64(args[4])),
                            _tx_dim(_f64(args[5])), _arg_filled(args[7])}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -138,7 +140,7 @@ static Value numerobis_builtin_circle(Value *args) {
                  .color = _arg_color(args[4]),
                  .circle = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2])),
                             _tx_dim(_f64(args[3])), _arg_filled(args[5])}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -149,7 +151,7 @@ static Value numerobis_builtin_ellipse(Value *args) {
                  .ellipse = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2])),
                              _tx_dim(_f64(args[3])), _tx_dim(_f64(args[4])),
                              _arg_filled(args[6])}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -161,13 +163,13 @@ static Value numerobis_builtin_line(Value *args) {
                  .line = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2])),
                           _tx_x(_f64(args[3])), _tx_y(_f64(args[4])),
                           thickness}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
 /* polygon!(points: List[Num], color, filled, closed) */
 static Value numerobis_builtin_polygon(Value *args) {
-  Value *arr = args[1].list->items;
+  Value *arr = list_items(args[1].list);
   int n = (int)(arrlen(arr) / 2);
   SDL_Point *pts = GC_MALLOC(n * sizeof(SDL_Point));
 
@@ -181,7 +183,7 @@ static Value numerobis_builtin_polygon(Value *args) {
   DrawCmd cmd = {.kind = CMD_POLYGON,
                  .color = _arg_color(args[2]),
                  .polygon = {pts, n, _arg_filled(args[3]), _arg_filled(args[4])}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -192,7 +194,7 @@ static Value numerobis_builtin_arc(Value *args) {
                  .arc = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2])),
                          _tx_dim(_f64(args[3])), (float)_f64(args[4]),
                          (float)_f64(args[5]), _arg_filled(args[7])}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -201,7 +203,7 @@ static Value numerobis_builtin_point(Value *args) {
   DrawCmd cmd = {.kind = CMD_POINT,
                  .color = _arg_color(args[3]),
                  .point = {_tx_x(_f64(args[1])), _tx_y(_f64(args[2]))}};
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
@@ -233,89 +235,208 @@ static Value numerobis_builtin_text(Value *args) {
               .angle = angle_arg,
           },
   };
-  arrput(_queue, cmd);
+  _queue_push(cmd);
   return NONE;
 }
 
-static Value numerobis_builtin_blit(Value *args) {
-  (void)args;
-  if (!_renderer || !_queue)
-    return NONE;
-
-  _set_color(_bg);
-  SDL_RenderClear(_renderer);
-
-  for (unsigned int qi = 0; qi < arrlen(_queue); qi++) {
-    DrawCmd *c = &_queue[qi];
-    _set_color(c->color);
-
-    switch (c->kind) {
-    case CMD_RECT: {
+static void _replay_cmd(DrawCmd *c) {
+  _set_color(c->color);
+  _batch_set_color(c->color);
+
+  switch (c->kind) {
+  case CMD_RECT: {
+    if (c->rect.filled) {
+      _batch_rect((float)c->rect.x, (float)c->rect.y, (float)c->rect.w,
+                  (float)c->rect.h);
+    } else {
+      _batch_flush();
       SDL_Rect r = {c->rect.x, c->rect.y, c->rect.w, c->rect.h};
-      if (c->rect.filled)
-        SDL_RenderFillRect(_renderer, &r);
-      else
-        SDL_RenderDrawRect(_renderer, &r);
-      break;
+      SDL_RenderDrawRect(_renderer, &r);
     }
-    case CMD_ROUNDED_RECT:
-      _prim_rounded_rect(c->rrect.x, c->rrect.y, c->rrect.w, c->rrect.h,
-                         c->rrect.radius, c->rrect.filled);
-      break;
-    case CMD_CIRCLE:
-      _prim_circle(c->circle.x, c->circle.y, c->circle.radius,
-                   c->circle.filled);
-      break;
-    case CMD_ELLIPSE:
-      _prim_ellipse(c->ellipse.x, c->ellipse.y, c->ellipse.rx, c->ellipse.ry,
-                    c->ellipse.filled);
-      break;
-    case CMD_LINE:
-      _prim_thick_line(c->line.x1, c->line.y1, c->line.x2, c->line.y2,
-                       c->line.thickness);
-      break;
-    case CMD_POLYGON:
-      _prim_polygon(c->polygon.pts, c->polygon.n, c->polygon.filled, c->polygon.closed);
-      break;
-    case CMD_ARC:
-      _prim_arc(c->arc.x, c->arc.y, c->arc.radius, c->arc.start, c->arc.end,
-                c->arc.filled);
-      break;
-    case CMD_POINT:
-      SDL_RenderDrawPoint(_renderer, c->point.x, c->point.y);
+    break;
+  }
+  case CMD_ROUNDED_RECT:
+    _prim_rounded_rect(c->rrect.x, c->rrect.y, c->rrect.w, c->rrect.h,
+                       c->rrect.radius, c->rrect.filled);
+    break;
+  case CMD_CIRCLE:
+    _prim_circle(c->circle.x, c->circle.y, c->circle.radius,
+                 c->circle.filled);
+    break;
+  case CMD_ELLIPSE:
+    _prim_ellipse(c->ellipse.x, c->ellipse.y, c->ellipse.rx, c->ellipse.ry,
+                  c->ellipse.filled);
+    break;
+  case CMD_LINE:
+    _prim_thick_line(c->line.x1, c->line.y1, c->line.x2, c->line.y2,
+                     c->line.thickness);
+    break;
+  case CMD_POLYGON:
+    _prim_polygon(c->polygon.pts, c->polygon.n, c->polygon.filled, c->polygon.closed);
+    break;
+  case CMD_ARC:
+    _prim_arc(c->arc.x, c->arc.y, c->arc.radius, c->arc.start, c->arc.end,
+              c->arc.filled);
+    break;
+  case CMD_POINT:
+    _batch_point(c->point.x, c->point.y);
+    break;
+  case CMD_TEXT: {
+    _batch_flush();
+    if (!c->text.font_path) {
+      fprintf(stderr, "graphics: no font available\n");
       break;
-    case CMD_TEXT: {
-      if (!c->text.font_path) {
-        fprintf(stderr, "graphics: no font available\n");
-        break;
-      }
-      TTF_Font *font =
-          _get_font(c->text.font_path, c->text.size, c->text.style);
-      if (!font)
-        break;
-
-      SDL_Color sdl_c = {c->color.r, c->color.g, c->color.b, c->color.a};
-      SDL_Surface *surf = TTF_RenderUTF8_Blended(font, c->text.str, sdl_c);
-      if (!surf)
-        break;
-
-      SDL_Texture *tex = SDL_CreateTextureFromSurface(_renderer, surf);
-      SDL_Rect dst = {c->text.x, c->text.y, surf->w, surf->h};
-      SDL_FreeSurface(surf);
-
-      if (tex) {
-        if (c->text.angle != 0.0) {
-          SDL_Point origin = {0, 0};
-          SDL_RenderCopyEx(_renderer, tex, NULL, &dst, c->text.angle, &origin,
-                           SDL_FLIP_NONE);
-        } else {
-          SDL_RenderCopy(_renderer, tex, NULL, &dst);
-        }
-        SDL_DestroyTexture(tex);
-      }
+    }
+    int tw, th;
+    SDL_Texture *tex = _get_text_texture(c->text.str, c->text.font_path,
+                                         c->text.size, c->text.style, &tw,
+                                         &th);
+    if (!tex)
       break;
+
+    SDL_SetTextureColorMod(tex, c->color.r, c->color.g, c->color.b);
+    SDL_SetTextureAlphaMod(tex, c->color.a);
+    SDL_Rect dst = {c->text.x, c->text.y, tw, th};
+
+    if (c->text.angle != 0.0) {
+      SDL_Point origin = {0, 0};
+      SDL_RenderCopyEx(_renderer, tex, NULL, &dst, c->text.angle, &origin,
+                       SDL_FLIP_NONE);
+    } else {
+      SDL_RenderCopy(_renderer, tex, NULL, &dst);
     }
+    break;
+  }
+  }
+}
+
+/* FNV-1a over the fields that determine a command's pixels. Pointer
+ * payloads (polygon points, text strings) are hashed by content —
+ * the queue builders duplicate them per call, so addresses differ
+ * between identical frames. */
+static unsigned long _mix(unsigned long h, const void *p, size_t n) {
+  const unsigned char *b = p;
+  for (size_t i = 0; i < n; i++) {
+    h ^= b[i];
+    h *= 1099511628211UL;
+  }
+  return h;
+}
+
+#define MIX(v) (h = _mix(h, &(v), sizeof(v)))
+
+static unsigned long _cmd_hash(unsigned long h, const DrawCmd *c) {
+  int kind = (int)c->kind;
+  MIX(kind);
+  MIX(c->color);
+  switch (c->kind) {
+  case CMD_RECT:
+    MIX(c->rect.x), MIX(c->rect.y), MIX(c->rect.w), MIX(c->rect.h);
+    MIX(c->rect.filled);
+    break;
+  case CMD_ROUNDED_RECT:
+    MIX(c->rrect.x), MIX(c->rrect.y), MIX(c->rrect.w), MIX(c->rrect.h);
+    MIX(c->rrect.radius), MIX(c->rrect.filled);
+    break;
+  case CMD_CIRCLE:
+    MIX(c->circle.x), MIX(c->circle.y), MIX(c->circle.radius);
+    MIX(c->circle.filled);
+    break;
+  case CMD_ELLIPSE:
+    MIX(c->ellipse.x), MIX(c->ellipse.y), MIX(c->ellipse.rx);
+    MIX(c->ellipse.ry), MIX(c->ellipse.filled);
+    break;
+  case CMD_LINE:
+    MIX(c->line.x1), MIX(c->line.y1), MIX(c->line.x2), MIX(c->line.y2);
+    MIX(c->line.thickness);
+    break;
+  case CMD_POLYGON:
+    MIX(c->polygon.n), MIX(c->polygon.filled), MIX(c->polygon.closed);
+    h = _mix(h, c->polygon.pts, (size_t)c->polygon.n * sizeof(SDL_Point));
+    break;
+  case CMD_ARC:
+    MIX(c->arc.x), MIX(c->arc.y), MIX(c->arc.radius);
+    MIX(c->arc.start), MIX(c->arc.end), MIX(c->arc.filled);
+    break;
+  case CMD_POINT:
+    MIX(c->point.x), MIX(c->point.y);
+    break;
+  case CMD_TEXT:
+    MIX(c->text.x), MIX(c->text.y), MIX(c->text.size), MIX(c->text.style);
+    MIX(c->text.angle);
+    h = _mix(h, c->text.str, strlen(c->text.str));
+    if (c->text.font_path)
+      h = _mix(h, c->text.font_path, strlen(c->text.font_path));
+    break;
+  }
+  return h;
+}
+
+#undef MIX
+
+static void _blit_retained(void) {
+  int out_w, out_h;
+  SDL_GetRendererOutputSize(_renderer, &out_w, &out_h);
+
+  for (int l = 0; l < GFX_MAX_LAYERS; l++) {
+    Layer *layer = &_layers[l];
+
+    unsigned long h = 14695981039346656037UL;
+    for (unsigned int qi = 0; qi < arrlen(_queue); qi++)
+      if (_queue[qi].layer == l)
+        h = _cmd_hash(h, &_queue[qi]);
+
+    if (!layer->tex && h == 14695981039346656037UL)
+      continue; /* never drawn to */
+
+    bool resized = layer->tex && (layer->w != out_w || layer->h != out_h);
+    if (layer->tex && layer->hash == h && !resized)
+      continue; /* unchanged since last frame */
+
+    if (!layer->tex || resized) {
+      if (layer->tex)
+        SDL_DestroyTexture(layer->tex);
+      layer->tex =
+          SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888,
+                            SDL_TEXTUREACCESS_TARGET, out_w, out_h);
+      if (!layer->tex)
+        continue;
+      SDL_SetTextureBlendMode(layer->tex, SDL_BLENDMODE_BLEND);
+      layer->w = out_w;
+      layer->h = out_h;
     }
+
+    SDL_SetRenderTarget(_renderer, layer->tex);
+    SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(_renderer);
+    for (unsigned int qi = 0; qi < arrlen(_queue); qi++)
+      if (_queue[qi].layer == l)
+        _replay_cmd(&_queue[qi]);
+    _batch_flush();
+    SDL_SetRenderTarget(_renderer, NULL);
+    layer->hash = h;
+  }
+
+  _set_color(_bg);
+  SDL_RenderClear(_renderer);
+  for (int l = 0; l < GFX_MAX_LAYERS; l++)
+    if (_layers[l].tex)
+      SDL_RenderCopy(_renderer, _layers[l].tex, NULL, NULL);
+}
+
+static Value numerobis_builtin_blit(Value *args) {
+  (void)args;
+  if (!_renderer || !_queue)
+    return NONE;
+
+  if (_retained) {
+    _blit_retained();
+  } else {
+    _set_color(_bg);
+    SDL_RenderClear(_renderer);
+    for (unsigned int qi = 0; qi < arrlen(_queue); qi++)
+      _replay_cmd(&_queue[qi]);
+    _batch_flush();
   }
 
   SDL_RenderPresent(_renderer);
@@ -326,6 +447,23 @@ static Value numerobis_builtin_blit(Value *args) {
   return NONE;
 }
 
+/* set_retained!(on: Bool) — opt into retained layer rendering */
+static Value numerobis_builtin_set_retained(Value *args) {
+  _retained = _bool(args[1]);
+  return NONE;
+}
+
+/* set_layer!(index: Int) — subsequent draws target this layer */
+static Value numerobis_builtin_set_layer(Value *args) {
+  int l = (int)_i64(args[1]);
+  if (l < 0)
+    l = 0;
+  if (l >= GFX_MAX_LAYERS)
+    l = GFX_MAX_LAYERS - 1;
+  _cur_layer = l;
+  return NONE;
+}
+
 /* mouse_down!(): Bool */
 static Value numerobis_builtin_mouse_down(Value *args) {
   _update_input_state();
@@ -388,56 +526,10 @@ static Value numerobis_builtin_set_origin(Value *args) {
   return NONE;
 }
 
-void audio_callback(void *userdata, Uint8 *stream, int len) {
-  if (audio_len == 0) {
-    return;
-  }
-  len = (len > audio_len ? audio_len : len);
-  SDL_memcpy(stream, audio_pos, len);
-  audio_pos += len;
-  audio_len -= len;
-}
-
-int audio_wait_thread(void *arg) {
-  while (audio_device_open) {
-    SDL_Delay(5);
-  }
-
-  SDL_LoadWAV(arg, &wav_spec, &wav_buffer, &wav_length);
-
-  wav_spec.callback = audio_callback;
-  wav_spec.userdata = NULL;
-  audio_pos = wav_buffer;
-  audio_len = wav_length;
-
-  if (SDL_OpenAudio(&wav_spec, NULL) < 0) {
-    fprintf(stderr, "Couldn't open audio: %s\n", SDL_GetError());
-    return -1;
-  }
-
-  audio_device_open = 1;
-  SDL_PauseAudio(0);
-  while (audio_len > 0) {
-    SDL_Delay(25);
-  }
-
-  SDL_CloseAudio();
-  audio_device_open = 0;
-  SDL_free(wav_buffer);
-  wav_buffer = NULL;
-
-  return 1;
-}
-
 static Value numerobis_builtin_play_sound(Value *args) {
   sds path = _str(args[1]);
   path = get_absolute_resource_path(path);
-
-  audio_len = 0; // signal current thread to stop
-
-  SDL_Thread *thread = SDL_CreateThread(audio_wait_thread, "audio_wait", path);
-  SDL_DetachThread(thread);
-
+  _audio_play(path);
   return NONE;
 }
 
@@ -465,10 +557,13 @@ __attribute__((constructor)) void numerobis_graphics_register_builtins(void) {
   u_extern_register("key__pressed", numerobis_builtin_key_pressed);
   u_extern_register("set__scale", numerobis_builtin_set_scale);
   u_extern_register("set__origin", numerobis_builtin_set_origin);
+  u_extern_register("set__retained", numerobis_builtin_set_retained);
+  u_extern_register("set__layer", numerobis_builtin_set_layer);
   u_extern_register("play__sound", numerobis_builtin_play_sound);
 }
 
 __attribute__((destructor)) void numerobis_graphics_cleanup(void) {
+  _cleanup_audio();
   _cleanup_fonts();
   _cleanup_state();
 
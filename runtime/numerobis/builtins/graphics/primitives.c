@@ -2,6 +2,7 @@
  * adapted and optimized with assistance from Claude Opus 4.6. */
 
 #include "primitives.h"
+#include "batch.h"
 #include "state.h"
 
 #include "../../libs/bdwgc/include/gc.h"
@@ -9,20 +10,16 @@
 #include <math.h>
 #include <stdbool.h>
 
-static inline void hline(int x0, int x1, int y) {
-  if (x0 > x1) {
-    int t = x0;
-    x0 = x1;
-    x1 = t;
-  }
-  SDL_RenderDrawLine(_renderer, x0, y, x1, y);
-}
+/* Spans and points go through the geometry batch; only diagonal
+ * outlines still call SDL_Render* directly and must flush first so the
+ * batched geometry underneath them lands in order. */
+static inline void hline(int x0, int x1, int y) { _batch_hline(x0, x1, y); }
 
 static inline void sym4(int cx, int cy, int x, int y) {
-  SDL_RenderDrawPoint(_renderer, cx + x, cy + y);
-  SDL_RenderDrawPoint(_renderer, cx - x, cy + y);
-  SDL_RenderDrawPoint(_renderer, cx + x, cy - y);
-  SDL_RenderDrawPoint(_renderer, cx - x, cy - y);
+  _batch_point(cx + x, cy + y);
+  _batch_point(cx - x, cy + y);
+  _batch_point(cx + x, cy - y);
+  _batch_point(cx - x, cy - y);
 }
 
 #define SWAP(a, b)                                                             \
@@ -35,7 +32,7 @@ static inline void sym4(int cx, int cy, int x, int y) {
 void _prim_circle(int cx, int cy, int r, bool filled) {
   if (r <= 0) {
     if (filled)
-      SDL_RenderDrawPoint(_renderer, cx, cy);
+      _batch_point(cx, cy);
     return;
   }
 
@@ -118,6 +115,7 @@ void _prim_arc(int cx, int cy, int r, float deg0, float deg1, bool filled) {
   float step = (rad1 - rad0) / segs;
 
   if (!filled) {
+    _batch_flush();
     for (int s = 0; s < segs; s++) {
       float a0 = rad0 + step * s, a1 = a0 + step;
       SDL_RenderDrawLine(_renderer, cx + (int)(r * cosf(a0)),
@@ -175,6 +173,7 @@ void _prim_rounded_rect(int x, int y, int w, int h, int r, bool filled) {
     r = h / 2;
 
   if (!filled) {
+    _batch_flush();
     SDL_RenderDrawLine(_renderer, x + r, y, x + w - r, y);
     SDL_RenderDrawLine(_renderer, x + r, y + h, x + w - r, y + h);
     SDL_RenderDrawLine(_renderer, x, y + r, x, y + h - r);
@@ -186,12 +185,10 @@ void _prim_rounded_rect(int x, int y, int w, int h, int r, bool filled) {
     return;
   }
 
-  SDL_Rect rects[3] = {
-      {x + r, y, w - 2 * r, h},
-      {x, y + r, r, h - 2 * r},
-      {x + w - r, y + r, r, h - 2 * r},
-  };
-  SDL_RenderFillRects(_renderer, rects, 3);
+  _batch_rect((float)(x + r), (float)y, (float)(w - 2 * r), (float)h);
+  _batch_rect((float)x, (float)(y + r), (float)r, (float)(h - 2 * r));
+  _batch_rect((float)(x + w - r), (float)(y + r), (float)r,
+              (float)(h - 2 * r));
 
   /* Corner centres */
   const int ccx[] = {x + r, x + w - r, x + r, x + w - r};
@@ -212,6 +209,7 @@ void _prim_rounded_rect(int x, int y, int w, int h, int r, bool filled) {
 
 void _prim_thick_line(int x1, int y1, int x2, int y2, double t) {
   if (t <= 1.0) {
+    _batch_flush();
     SDL_RenderDrawLine(_renderer, x1, y1, x2, y2);
     return;
   }
@@ -236,6 +234,7 @@ void _prim_polygon(SDL_Point *pts, int n, bool filled, bool closed) {
   if (n < 2)
     return;
 
+  _batch_flush();
   for (int i = 0; i < (closed ? n : n - 1); i++)
     SDL_RenderDrawLine(_renderer, pts[i].x, pts[i].y, pts[(i + 1) % n].x,
                        pts[(i + 1) % n].y);
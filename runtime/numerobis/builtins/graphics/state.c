@@ -19,6 +19,10 @@ double _scale = 1.0;
 double _tx = 0.0;
 double _ty = 0.0;
 
+bool _retained = false;
+int _cur_layer = 0;
+Layer _layers[GFX_MAX_LAYERS] = {{0}};
+
 void _update_input_state(void) {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
@@ -55,6 +59,12 @@ void _cleanup_state(void) {
     arrfree(_queue);
     _queue = NULL;
   }
+  for (int i = 0; i < GFX_MAX_LAYERS; i++) {
+    if (_layers[i].tex) {
+      SDL_DestroyTexture(_layers[i].tex);
+      _layers[i] = (Layer){0};
+    }
+  }
   if (_renderer) {
     SDL_DestroyRenderer(_renderer);
     _renderer = NULL;
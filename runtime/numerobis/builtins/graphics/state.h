@@ -35,6 +35,7 @@ typedef enum {
 typedef struct {
   CmdKind kind;
   Color color;
+  int layer;
   union {
     struct {
       int x, y, w, h;
@@ -89,4 +90,20 @@ void _cleanup_state(void);
 
 extern DrawCmd *_queue;
 
+/* Retained mode (opt-in): draws target persistent per-layer textures
+ * and blit re-renders a layer only when its command stream changed
+ * since the last frame, then composites the layer textures. Mostly
+ * static scenes skip nearly all rasterization. */
+#define GFX_MAX_LAYERS 8
+
+typedef struct {
+  SDL_Texture *tex;
+  unsigned long hash;
+  int w, h;
+} Layer;
+
+extern bool _retained;
+extern int _cur_layer;
+extern Layer _layers[GFX_MAX_LAYERS];
+
 #endif
@@ -0,0 +1,502 @@
+#include "json_builtins.h"
+
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/gc_stb_ds.h"
+#include "../libs/sds.h"
+#include "../types/bool.h"
+#include "../types/list.h"
+#include "../types/map.h"
+#include "../types/number.h"
+#include "../types/str.h"
+#include "../types/struct.h"
+#include "../units/eval.h"
+#include "../units/units.h"
+#include "../utils/dtoa.h"
+#include "../values.h"
+
+#include "../libs/bdwgc/include/gc.h"
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// to_json streams the Value tree into one growing sds — numbers through
+// the Grisu formatter (utils/dtoa.c), packed and columnar lists straight
+// from their unboxed storage — instead of concatenating Str values in
+// source, which is quadratic in str__add__. Units are evaluated away:
+// the wire format carries the represented magnitude, nothing else.
+
+static sds _json_escape(sds out, const char *s, size_t len) {
+  out = sdscatlen(out, "\"", 1);
+  size_t start = 0;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = (unsigned char)s[i];
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    out = sdscatlen(out, s + start, i - start);
+    switch (c) {
+    case '"':
+      out = sdscatlen(out, "\\\"", 2);
+      break;
+    case '\\':
+      out = sdscatlen(out, "\\\\", 2);
+      break;
+    case '\n':
+      out = sdscatlen(out, "\\n", 2);
+      break;
+    case '\r':
+      out = sdscatlen(out, "\\r", 2);
+      break;
+    case '\t':
+      out = sdscatlen(out, "\\t", 2);
+      break;
+    case '\b':
+      out = sdscatlen(out, "\\b", 2);
+      break;
+    case '\f':
+      out = sdscatlen(out, "\\f", 2);
+      break;
+    default:
+      out = sdscatprintf(out, "\\u%04x", c);
+      break;
+    }
+    start = i + 1;
+  }
+  out = sdscatlen(out, s + start, len - start);
+  return sdscatlen(out, "\"", 1);
+}
+
+static sds _json_f64(sds out, double d) {
+  // JSON has no NaN/Infinity.
+  if (isnan(d) || isinf(d))
+    return sdscatlen(out, "null", 4);
+  char buf[DTOA_BUF_SIZE];
+  return sdscatlen(out, buf, dtoa_shortest(d, buf));
+}
+
+static sds _json_number(sds out, Number *n) {
+  const Unit *u = unit_get(n->unit);
+  if (n->kind == NUM_INT64 && is_one(u) && u->scalar == 1.0) {
+    char buf[DTOA_BUF_SIZE];
+    return sdscatlen(out, buf, i64toa(n->i64, buf));
+  }
+  return _json_f64(out, eval_number(n, NULL));
+}
+
+static sds _json_value(sds out, Value v);
+
+static sds _json_key(sds out, Value key) {
+  if (key.type == VALUE_STR)
+    return _json_escape(out, key.str, sdslen(key.str));
+  if (key.type == VALUE_NUMBER) {
+    out = sdscatlen(out, "\"", 1);
+    out = _json_number(out, &key.number);
+    return sdscatlen(out, "\"", 1);
+  }
+  u_throw(912, NULL, NULL);
+  return out;
+}
+
+static sds _json_struct_fields(sds out, const StructInfo *meta,
+                               const Value *fields) {
+  out = sdscatlen(out, "{", 1);
+  for (size_t i = 0; i < meta->fieldc; i++) {
+    if (i > 0)
+      out = sdscatlen(out, ",", 1);
+    out = _json_escape(out, meta->field_names[i], strlen(meta->field_names[i]));
+    out = sdscatlen(out, ":", 1);
+    out = _json_value(out, fields[i]);
+  }
+  return sdscatlen(out, "}", 1);
+}
+
+static sds _json_value(sds out, Value v) {
+  switch (v.type) {
+  case VALUE_NUMBER:
+    return _json_number(out, &v.number);
+  case VALUE_BOOL:
+    return sdscatlen(out, v.boolean ? "true" : "false", v.boolean ? 4 : 5);
+  case VALUE_STR:
+    return _json_escape(out, v.str, sdslen(v.str));
+  case VALUE_LIST: {
+    List *l = v.list;
+    size_t len = _list_len(l);
+    out = sdscatlen(out, "[", 1);
+    if (l != NULL && l->packed != NULL) {
+      // Unboxed fast path: one unit hash for the whole payload.
+      const double *p = l->packed + _list_off(l);
+      const Unit *u = unit_get(l->unit);
+      bool identity = is_one(u) && u->scalar == 1.0;
+      for (size_t i = 0; i < len; i++) {
+        if (i > 0)
+          out = sdscatlen(out, ",", 1);
+        if (identity) {
+          out = _json_f64(out, p[i]);
+        } else {
+          Number n = {.kind = NUM_DOUBLE, .unit = l->unit, .f64 = p[i]};
+          out = _json_number(out, &n);
+        }
+      }
+    } else if (l != NULL && l->cols != NULL) {
+      // Columnar structs render without materializing element boxes.
+      const StructInfo *meta = &STRUCT_REGISTRY[l->cstruct];
+      Value *fields = GC_MALLOC(meta->fieldc * sizeof(Value));
+      for (size_t i = 0; i < len; i++) {
+        if (i > 0)
+          out = sdscatlen(out, ",", 1);
+        for (size_t f = 0; f < meta->fieldc; f++)
+          fields[f] = l->cols[f][i];
+        out = _json_struct_fields(out, meta, fields);
+      }
+    } else {
+      Value *items = l != NULL ? list_items(l) : NULL;
+      for (size_t i = 0; i < len; i++) {
+        if (i > 0)
+          out = sdscatlen(out, ",", 1);
+        out = _json_value(out, items[i]);
+      }
+    }
+    return sdscatlen(out, "]", 1);
+  }
+  case VALUE_STRUCT: {
+    long id = v.strukt[0].number.i64;
+    return _json_struct_fields(out, &STRUCT_REGISTRY[id], v.strukt + 1);
+  }
+  case VALUE_MAP: {
+    Map *m = v.map;
+    out = sdscatlen(out, "{", 1);
+    bool first = true;
+    for (uint32_t i = 0; i < m->cap; i++) {
+      if (m->state[i] != 1)
+        continue;
+      if (!first)
+        out = sdscatlen(out, ",", 1);
+      first = false;
+      out = _json_key(out, m->slots[i].key);
+      out = sdscatlen(out, ":", 1);
+      out = _json_value(out, m->slots[i].val);
+    }
+    return sdscatlen(out, "}", 1);
+  }
+  case VALUE_NONE:
+  case VALUE_EMPTY:
+    return sdscatlen(out, "null", 4);
+  default:
+    u_throw(912, NULL, NULL);
+  }
+  return out;
+}
+
+static Value numerobis_builtin_to_json(Value *args) {
+  return str__init__(_json_value(sdsempty(), args[1]));
+}
+
+// from_json scans the input in place. Clean strings (no escapes) are
+// carved out of one GC block sized up front — the same single-block
+// strategy as Str.split — and all-numeric arrays accumulate straight
+// into packed f64 storage without boxing a single element.
+
+typedef struct {
+  const char *p;
+  const char *end;
+  char *block; /* carve arena for unescaped string fragments */
+  size_t off;
+} JParser;
+
+static void _j_ws(JParser *j) {
+  while (j->p < j->end &&
+         (*j->p == ' ' || *j->p == '\t' || *j->p == '\n' || *j->p == '\r'))
+    j->p++;
+}
+
+static void _j_expect(JParser *j, char c) {
+  if (j->p >= j->end || *j->p != c)
+    u_throw(913, NULL, NULL);
+  j->p++;
+}
+
+static Value _j_value(JParser *j);
+
+static sds _j_append_utf8(sds s, uint32_t cp) {
+  char b[4];
+  if (cp < 0x80) {
+    b[0] = (char)cp;
+    return sdscatlen(s, b, 1);
+  }
+  if (cp < 0x800) {
+    b[0] = (char)(0xC0 | (cp >> 6));
+    b[1] = (char)(0x80 | (cp & 0x3F));
+    return sdscatlen(s, b, 2);
+  }
+  if (cp < 0x10000) {
+    b[0] = (char)(0xE0 | (cp >> 12));
+    b[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    b[2] = (char)(0x80 | (cp & 0x3F));
+    return sdscatlen(s, b, 3);
+  }
+  b[0] = (char)(0xF0 | (cp >> 18));
+  b[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+  b[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+  b[3] = (char)(0x80 | (cp & 0x3F));
+  return sdscatlen(s, b, 4);
+}
+
+static uint32_t _j_hex4(JParser *j) {
+  if ((size_t)(j->end - j->p) < 4)
+    u_throw(913, NULL, NULL);
+  uint32_t v = 0;
+  for (int i = 0; i < 4; i++) {
+    char c = *j->p++;
+    v <<= 4;
+    if (c >= '0' && c <= '9')
+      v |= (uint32_t)(c - '0');
+    else if (c >= 'a' && c <= 'f')
+      v |= (uint32_t)(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F')
+      v |= (uint32_t)(c - 'A' + 10);
+    else
+      u_throw(913, NULL, NULL);
+  }
+  return v;
+}
+
+static sds _j_string(JParser *j) {
+  _j_expect(j, '"');
+  const char *start = j->p;
+
+  // Common case first: no escapes, the content is carved verbatim.
+  const char *q = start;
+  while (q < j->end && *q != '"' && *q != '\\')
+    q++;
+  if (q >= j->end)
+    u_throw(913, NULL, NULL);
+  if (*q == '"') {
+    j->p = q + 1;
+    return str_carve(j->block, &j->off, start, (size_t)(q - start));
+  }
+
+  sds s = sdsnewlen(start, (size_t)(q - start));
+  j->p = q;
+  while (j->p < j->end && *j->p != '"') {
+    if (*j->p != '\\') {
+      const char *run = j->p;
+      while (j->p < j->end && *j->p != '"' && *j->p != '\\')
+        j->p++;
+      s = sdscatlen(s, run, (size_t)(j->p - run));
+      continue;
+    }
+    j->p++;
+    if (j->p >= j->end)
+      u_throw(913, NULL, NULL);
+    char c = *j->p++;
+    switch (c) {
+    case '"':
+    case '\\':
+    case '/':
+      s = sdscatlen(s, &c, 1);
+      break;
+    case 'n':
+      s = sdscatlen(s, "\n", 1);
+      break;
+    case 'r':
+      s = sdscatlen(s, "\r", 1);
+      break;
+    case 't':
+      s = sdscatlen(s, "\t", 1);
+      break;
+    case 'b':
+      s = sdscatlen(s, "\b", 1);
+      break;
+    case 'f':
+      s = sdscatlen(s, "\f", 1);
+      break;
+    case 'u': {
+      uint32_t cp = _j_hex4(j);
+      if (cp >= 0xD800 && cp <= 0xDBFF && (size_t)(j->end - j->p) >= 6 &&
+          j->p[0] == '\\' && j->p[1] == 'u') {
+        j->p += 2;
+        uint32_t lo = _j_hex4(j);
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+      }
+      s = _j_append_utf8(s, cp);
+      break;
+    }
+    default:
+      u_throw(913, NULL, NULL);
+    }
+  }
+  _j_expect(j, '"');
+  return s;
+}
+
+static Value _j_number(JParser *j) {
+  const char *start = j->p;
+  bool integral = true;
+  if (j->p < j->end && *j->p == '-')
+    j->p++;
+  while (j->p < j->end && (*j->p >= '0' && *j->p <= '9'))
+    j->p++;
+  if (j->p < j->end && (*j->p == '.' || *j->p == 'e' || *j->p == 'E')) {
+    integral = false;
+    while (j->p < j->end &&
+           ((*j->p >= '0' && *j->p <= '9') || *j->p == '.' || *j->p == 'e' ||
+            *j->p == 'E' || *j->p == '+' || *j->p == '-'))
+      j->p++;
+  }
+  if (j->p == start)
+    u_throw(913, NULL, NULL);
+
+  char *endp;
+  if (integral) {
+    errno = 0;
+    long v = strtol(start, &endp, 10);
+    if (endp == j->p && errno != ERANGE)
+      return int__init__(v, U_ONE);
+    // Fell out of long range: keep the value as a double.
+  }
+  double d = strtod(start, &endp);
+  if (endp != j->p)
+    u_throw(913, NULL, NULL);
+  return num__init__(d, U_ONE);
+}
+
+static Value _j_array(JParser *j) {
+  _j_expect(j, '[');
+  _j_ws(j);
+  if (j->p < j->end && *j->p == ']') {
+    j->p++;
+    return list__init__(NULL);
+  }
+
+  // Accumulate unboxed while every element is a plain number; fall back
+  // to boxed items at the first element that is not.
+  double *packed = NULL;
+  Value *items = NULL;
+
+  for (;;) {
+    _j_ws(j);
+    if (j->p >= j->end)
+      u_throw(913, NULL, NULL);
+
+    if (items == NULL && (*j->p == '-' || (*j->p >= '0' && *j->p <= '9'))) {
+      Value v = _j_number(j);
+      arrput(packed, v.number.kind == NUM_INT64 ? (double)v.number.i64
+                                                : v.number.f64);
+    } else {
+      if (items == NULL) {
+        // De-opt: box what has accumulated so far.
+        for (size_t i = 0; i < arrlen(packed); i++)
+          arrput(items, num__init__(packed[i], U_ONE));
+        packed = NULL;
+      }
+      arrput(items, _j_value(j));
+    }
+
+    _j_ws(j);
+    if (j->p < j->end && *j->p == ',') {
+      j->p++;
+      continue;
+    }
+    _j_expect(j, ']');
+    break;
+  }
+
+  if (items != NULL)
+    return list__init__(items);
+  if (arrlen(packed) < 8) {
+    for (size_t i = 0; i < arrlen(packed); i++)
+      arrput(items, num__init__(packed[i], U_ONE));
+    return list__init__(items);
+  }
+  return list_packed__init__(packed, U_ONE);
+}
+
+static Value _j_object(JParser *j) {
+  _j_expect(j, '{');
+  Value m = map__init__();
+  _j_ws(j);
+  if (j->p < j->end && *j->p == '}') {
+    j->p++;
+    return m;
+  }
+  for (;;) {
+    _j_ws(j);
+    Value key = str__init__(_j_string(j));
+    _j_ws(j);
+    _j_expect(j, ':');
+    Value val = _j_value(j);
+    __setitem__(m, key, val, NULL);
+    _j_ws(j);
+    if (j->p < j->end && *j->p == ',') {
+      j->p++;
+      continue;
+    }
+    _j_expect(j, '}');
+    break;
+  }
+  return m;
+}
+
+static Value _j_value(JParser *j) {
+  _j_ws(j);
+  if (j->p >= j->end)
+    u_throw(913, NULL, NULL);
+  switch (*j->p) {
+  case '{':
+    return _j_object(j);
+  case '[':
+    return _j_array(j);
+  case '"':
+    return str__init__(_j_string(j));
+  case 't':
+    if ((size_t)(j->end - j->p) >= 4 && memcmp(j->p, "true", 4) == 0) {
+      j->p += 4;
+      return VTRUE;
+    }
+    u_throw(913, NULL, NULL);
+    return NONE;
+  case 'f':
+    if ((size_t)(j->end - j->p) >= 5 && memcmp(j->p, "false", 5) == 0) {
+      j->p += 5;
+      return VFALSE;
+    }
+    u_throw(913, NULL, NULL);
+    return NONE;
+  case 'n':
+    if ((size_t)(j->end - j->p) >= 4 && memcmp(j->p, "null", 4) == 0) {
+      j->p += 4;
+      return NONE;
+    }
+    u_throw(913, NULL, NULL);
+    return NONE;
+  default:
+    return _j_number(j);
+  }
+}
+
+static Value numerobis_builtin_from_json(Value *args) {
+  sds src = args[1].str;
+  size_t len = sdslen(src);
+
+  // String content never exceeds the input and the quote count bounds
+  // the number of fragments, so one block covers every carved string.
+  size_t quotes = 0;
+  for (size_t i = 0; i < len; i++)
+    quotes += src[i] == '"';
+
+  JParser j = {src, src + len, NULL, 0};
+  j.block = GC_MALLOC_ATOMIC(len + (quotes / 2 + 1) * str_carve_size(0));
+
+  Value result = _j_value(&j);
+  _j_ws(&j);
+  if (j.p != j.end)
+    u_throw(913, NULL, NULL);
+  return result;
+}
+
+void numerobis_json_register_builtins(void) {
+  u_extern_register("to__json", numerobis_builtin_to_json);
+  u_extern_register("from__json", numerobis_builtin_from_json);
+}
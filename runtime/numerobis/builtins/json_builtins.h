@@ -0,0 +1,6 @@
+#ifndef NUMEROBIS_JSON_BUILTINS_H
+#define NUMEROBIS_JSON_BUILTINS_H
+
+void numerobis_json_register_builtins(void);
+
+#endif
@@ -0,0 +1,199 @@
+#include "parallel_builtins.h"
+
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/gc_stb_ds.h"
+#include "../types/list.h"
+#include "../types/number.h"
+#include "../units/units.h"
+#include "../values.h"
+
+#include "../libs/bdwgc/include/gc.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+// A persistent pool of worker threads, spawned once and reused for every
+// parallel call. Work is distributed by self-scheduling: each idle
+// worker grabs the next unclaimed index chunk with one atomic add, which
+// balances uneven per-element cost the way deque stealing would without
+// the deques — every task here is a homogeneous index range, so there is
+// nothing worker-local to steal from.
+//
+// Workers register themselves with bdwgc before touching the heap, and
+// unit interning is already mutex-guarded (units/units.c), so closures
+// may allocate and construct units freely. Mutating a shared list or map
+// from inside the closure is the caller's race to lose, same as any
+// shared-memory parallel-for.
+
+#define PAR_CHUNK 64
+
+typedef struct {
+  Value fn;
+  Value *items;         /* boxed input elements, or NULL when packed */
+  const double *packed; /* unboxed f64 input payload */
+  uint64_t unit;        /* unit hash shared by the packed payload */
+  Value *out;           /* result slots (NULL for parallel_for) */
+  size_t len;
+  _Atomic size_t next;  /* first unclaimed index */
+  _Atomic int active;   /* workers still draining this task */
+} ParTask;
+
+static pthread_mutex_t _par_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _par_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t _par_done = PTHREAD_COND_INITIALIZER;
+static ParTask *_par_task = NULL;
+static unsigned long _par_gen = 0;
+static int _par_threads = 0; /* spawned workers; main participates too */
+/* Set while this thread is draining a task, so a parallel call made from
+ * inside a worker's closure runs serially instead of deadlocking: the
+ * nested dispatch would count this thread among the workers it waits
+ * for, but this thread is blocked on that very wait. */
+static _Thread_local bool _par_in_task = false;
+
+static void _par_run(ParTask *t) {
+  bool outermost = !_par_in_task;
+  _par_in_task = true;
+  for (;;) {
+    size_t start = atomic_fetch_add(&t->next, PAR_CHUNK);
+    if (start >= t->len)
+      break;
+    size_t end = start + PAR_CHUNK < t->len ? start + PAR_CHUNK : t->len;
+    for (size_t i = start; i < end; i++) {
+      Value item =
+          t->packed != NULL ? num__init__(t->packed[i], t->unit) : t->items[i];
+      Value kargs[3] = {t->fn, item, EMPTY};
+      Value r = __call__(t->fn, kargs, 1);
+      if (t->out != NULL)
+        t->out[i] = r;
+    }
+  }
+  if (outermost)
+    _par_in_task = false;
+}
+
+static void *_par_worker(void *arg) {
+  struct GC_stack_base sb;
+  GC_get_stack_base(&sb);
+  GC_register_my_thread(&sb);
+
+  unsigned long seen = _par_gen;
+  pthread_mutex_lock(&_par_lock);
+  for (;;) {
+    while (_par_gen == seen)
+      pthread_cond_wait(&_par_wake, &_par_lock);
+    seen = _par_gen;
+    ParTask *t = _par_task;
+    pthread_mutex_unlock(&_par_lock);
+
+    _par_run(t);
+
+    pthread_mutex_lock(&_par_lock);
+    if (atomic_fetch_sub(&t->active, 1) == 1)
+      pthread_cond_signal(&_par_done);
+  }
+  return NULL;
+}
+
+static void _par_pool_init(long request) {
+  if (_par_threads > 0)
+    return;
+  long n = request > 0 ? request : sysconf(_SC_NPROCESSORS_ONLN);
+  if (n < 1)
+    n = 1;
+  if (n == 1)
+    return;
+
+  GC_allow_register_threads();
+  _par_threads = (int)(n - 1);
+  for (int i = 0; i < _par_threads; i++) {
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, _par_worker, NULL) != 0) {
+      _par_threads = i;
+      break;
+    }
+    pthread_detach(tid);
+  }
+}
+
+static void _par_dispatch(ParTask *t) {
+  atomic_store(&t->next, 0);
+
+  // Tiny inputs are not worth a broadcast round-trip; re-entrant calls
+  // (a parallel call from inside a task closure) must not re-use the
+  // single-task broadcast machinery at all.
+  if (_par_threads == 0 || _par_in_task || t->len < (size_t)PAR_CHUNK * 2) {
+    _par_run(t);
+    return;
+  }
+
+  atomic_store(&t->active, _par_threads);
+  pthread_mutex_lock(&_par_lock);
+  _par_task = t;
+  _par_gen++;
+  pthread_cond_broadcast(&_par_wake);
+  pthread_mutex_unlock(&_par_lock);
+
+  _par_run(t); // the calling thread drains chunks too
+
+  pthread_mutex_lock(&_par_lock);
+  while (atomic_load(&t->active) != 0)
+    pthread_cond_wait(&_par_done, &_par_lock);
+  _par_task = NULL;
+  pthread_mutex_unlock(&_par_lock);
+}
+
+static void _par_task_init(ParTask *t, Value _list, Value fn, Value *out) {
+  List *l = _list.list;
+  t->fn = fn;
+  t->items = NULL;
+  t->packed = NULL;
+  t->unit = 0;
+  t->out = out;
+  t->len = _list_len(l);
+  if (l != NULL && l->packed != NULL) {
+    // Elements box lazily inside the workers, one at a time.
+    t->packed = l->packed + _list_off(l);
+    t->unit = l->unit;
+  } else if (l != NULL) {
+    t->items = list_items(l);
+  }
+}
+
+static Value numerobis_builtin_parallel_map(Value *args) {
+  long workers = args[3].type == VALUE_EMPTY ? 0 : args[3].number.i64;
+  _par_pool_init(workers);
+
+  ParTask t;
+  Value *out = NULL;
+  arrsetlen(out, _list_len(args[1].list));
+  _par_task_init(&t, args[1], args[2], out);
+  _par_dispatch(&t);
+
+  // list_of re-packs all-numeric results into unboxed storage.
+  Value result = list_of(out, t.len);
+  arrfree(out);
+  return result;
+}
+
+static Value numerobis_builtin_parallel_for(Value *args) {
+  long workers = args[3].type == VALUE_EMPTY ? 0 : args[3].number.i64;
+  _par_pool_init(workers);
+
+  ParTask t;
+  _par_task_init(&t, args[1], args[2], NULL);
+  _par_dispatch(&t);
+  return NONE;
+}
+
+static Value numerobis_builtin_parallel_workers(Value *args) {
+  _par_pool_init(0);
+  return int__init__((long)_par_threads + 1, U_ONE);
+}
+
+void numerobis_parallel_register_builtins(void) {
+  u_extern_register("parallel__map", numerobis_builtin_parallel_map);
+  u_extern_register("parallel__for", numerobis_builtin_parallel_for);
+  u_extern_register("parallel__workers", numerobis_builtin_parallel_workers);
+}
@@ -0,0 +1,6 @@
+#ifndef NUMEROBIS_PARALLEL_BUILTINS_H
+#define NUMEROBIS_PARALLEL_BUILTINS_H
+
+void numerobis_parallel_register_builtins(void);
+
+#endif
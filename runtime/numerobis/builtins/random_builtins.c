@@ -1,48 +1,116 @@
 #include "random_builtins.h"
 
+#include "../constants.h"
 #include "../extern.h"
+#include "../libs/gc_stb_ds.h"
+#include "../types/list.h"
 #include "../types/number.h"
 #include "../units/units.h"
 #include "../utils/utils.h"
 #include "../values.h"
 
 #include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include <time.h>
 
-static void rng_seed_once(void) {
-  static int seeded = 0;
-  if (!seeded) {
-    seeded = 1;
-    uintptr_t entropy = (uintptr_t)&seeded;
-    srand((unsigned)(time(NULL) ^ entropy ^ (entropy >> 16)));
+// xoshiro256++ core with per-thread state: full 64-bit output, a
+// ~2^256 period, and no shared-state contention when tasks draw samples
+// concurrently. Each thread seeds itself lazily from wall clock and
+// stack-address entropy; seed! overrides that deterministically for
+// reproducible runs. Doubles come from the top 53 bits of one raw draw
+// (a multiply by 2^-53), not a division.
+
+typedef struct {
+  uint64_t s[4];
+  bool seeded;
+} RngState;
+
+static _Thread_local RngState _rng;
+
+static inline uint64_t _rotl(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+/* splitmix64, used only to expand a seed into the xoshiro state; its
+ * output is well distributed even for small consecutive seeds. */
+static inline uint64_t _splitmix(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+static void rng_seed(uint64_t seed) {
+  for (int i = 0; i < 4; i++)
+    _rng.s[i] = _splitmix(&seed);
+  _rng.seeded = true;
+}
+
+static inline uint64_t rng_next(void) {
+  uint64_t *s = _rng.s;
+  uint64_t result = _rotl(s[0] + s[3], 23) + s[0];
+  uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = _rotl(s[3], 45);
+
+  return result;
+}
+
+static void rng_ensure(void) {
+  if (!_rng.seeded) {
+    uintptr_t entropy = (uintptr_t)&_rng;
+    rng_seed((uint64_t)time(NULL) ^ (uint64_t)entropy ^
+             ((uint64_t)entropy << 32));
   }
 }
 
-static double rand_double(void) {
-  rng_seed_once();
-  return rand() / ((double)RAND_MAX + 1.0);
+static inline double rand_double(void) {
+  return (double)(rng_next() >> 11) * 0x1.0p-53;
 }
 
+/* A 128-bit multiply maps the raw draw onto [0, span) without the
+ * modulo's low-bit bias artifacts. */
 static long rand_int_range(long lo, long hi_exclusive) {
-  rng_seed_once();
   if (hi_exclusive <= lo)
     return lo;
-  long span = hi_exclusive - lo;
-  return lo + (long)(rand_double() * span);
+  uint64_t span = (uint64_t)(hi_exclusive - lo);
+  return lo + (long)(uint64_t)(((__uint128_t)rng_next() * span) >> 64);
 }
 
 static double rand_double_range(double lo, double hi) {
   return lo + (hi - lo) * rand_double();
 }
 
+static double rand_gaussian(double mean, double stddev) {
+  double u1 = rand_double();
+  double u2 = rand_double();
+
+  if (u1 < 1e-12)
+    u1 = 1e-12;
+
+  double z0 = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+  return mean + stddev * z0;
+}
+
 static Value numerobis_builtin_random(Value *args) {
   (void)args;
+  rng_ensure();
   return num__init__(rand_double(), U_ONE);
 }
 
+static Value numerobis_builtin_seed(Value *args) {
+  rng_seed((uint64_t)_i64(args[1]));
+  return NONE;
+}
+
 static Value numerobis_builtin_randint(Value *args) {
+  rng_ensure();
   long lo = _i64(args[1]);
   long hi = _i64(args[2]);
   long result = rand_int_range(lo, hi + 1);
@@ -50,6 +118,7 @@ static Value numerobis_builtin_randint(Value *args) {
 }
 
 static Value numerobis_builtin_uniform(Value *args) {
+  rng_ensure();
   double lo = _f64(args[1]);
   double hi = _f64(args[2]);
   double result = rand_double_range(lo, hi);
@@ -57,27 +126,73 @@ static Value numerobis_builtin_uniform(Value *args) {
 }
 
 static Value numerobis_builtin_gaussian(Value *args) {
+  rng_ensure();
   double mean = 0.0;
   double stddev = 1.0;
+  // Both arguments are optional; the result carries whichever unit was
+  // actually supplied (the typechecker requires them to agree).
+  uint64_t unit = U_ONE;
 
-  if (args[1].type != VALUE_EMPTY)
+  if (args[1].type != VALUE_EMPTY) {
     mean = _f64(args[1]);
-  if (args[2].type != VALUE_EMPTY)
+    unit = args[1].number.unit;
+  }
+  if (args[2].type != VALUE_EMPTY) {
     stddev = _f64(args[2]);
+    if (args[1].type == VALUE_EMPTY)
+      unit = args[2].number.unit;
+  }
 
-  double u1 = rand_double();
-  double u2 = rand_double();
+  return num__init__(rand_gaussian(mean, stddev), unit);
+}
 
-  if (u1 < 1e-12)
-    u1 = 1e-12;
+// Bulk fills: thousands of samples per call straight into packed list
+// storage, skipping the per-call extern dispatch and per-sample boxing.
 
-  double z0 = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
-  return num__init__(mean + stddev * z0, args[1].number.unit);
+static double *_fill_out(long n) {
+  double *out = NULL;
+  arrsetlen(out, n > 0 ? n : 0);
+  return out;
+}
+
+static Value numerobis_builtin_fill(Value *args) {
+  rng_ensure();
+  long n = _i64(args[1]);
+  double *out = _fill_out(n);
+  for (long i = 0; i < n; i++)
+    out[i] = rand_double();
+  return list_packed__init__(out, NUMEROBIS_UNIT_ONE_HASH);
+}
+
+static Value numerobis_builtin_fill_uniform(Value *args) {
+  rng_ensure();
+  double lo = _f64(args[1]);
+  double hi = _f64(args[2]);
+  long n = _i64(args[3]);
+  double *out = _fill_out(n);
+  for (long i = 0; i < n; i++)
+    out[i] = rand_double_range(lo, hi);
+  return list_packed__init__(out, args[1].number.unit);
+}
+
+static Value numerobis_builtin_fill_gaussian(Value *args) {
+  rng_ensure();
+  double mean = _f64(args[1]);
+  double stddev = _f64(args[2]);
+  long n = _i64(args[3]);
+  double *out = _fill_out(n);
+  for (long i = 0; i < n; i++)
+    out[i] = rand_gaussian(mean, stddev);
+  return list_packed__init__(out, args[1].number.unit);
 }
 
 void numerobis_random_register_builtins(void) {
   u_extern_register("random", numerobis_builtin_random);
+  u_extern_register("seed", numerobis_builtin_seed);
   u_extern_register("randint", numerobis_builtin_randint);
   u_extern_register("uniform", numerobis_builtin_uniform);
   u_extern_register("gaussian", numerobis_builtin_gaussian);
+  u_extern_register("fill", numerobis_builtin_fill);
+  u_extern_register("fill__uniform", numerobis_builtin_fill_uniform);
+  u_extern_register("fill__gaussian", numerobis_builtin_fill_gaussian);
 }
@@ -6,10 +6,43 @@
 #include "../utils/utils.h"
 #include "../values.h"
 
+#include "../libs/sds.h"
+#include "../types/str.h"
+
+#include <stdint.h>
+#include <string.h>
 #include <time.h>
 
 struct timespec ts;
 
+// In-program profiling: a monotonic nanosecond clock, a raw cycle
+// counter, and named accumulating timers, so hot loops can be measured
+// from inside a program without an external harness.
+
+static inline long _perf_ns(void) {
+  struct timespec t;
+#ifdef CLOCK_MONOTONIC_RAW
+  clock_gettime(CLOCK_MONOTONIC_RAW, &t);
+#else
+  clock_gettime(CLOCK_MONOTONIC, &t);
+#endif
+  return (long)t.tv_sec * 1000000000L + t.tv_nsec;
+}
+
+static inline uint64_t _cycle_count(void) {
+#if defined(__x86_64__)
+  unsigned lo, hi;
+  __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+  uint64_t v;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  return (uint64_t)_perf_ns();
+#endif
+}
+
 static Value numerobis_builtin_now(Value *args) {
   clock_gettime(CLOCK_REALTIME, &ts);
   double seconds = ts.tv_sec + ts.tv_nsec * 1e-9;
@@ -28,7 +61,93 @@ static Value numerobis_builtin_sleep(Value *args) {
   return NONE;
 }
 
+static Value numerobis_builtin_perf(Value *args) {
+  (void)args;
+  return int__init__(_perf_ns(), U_ONE);
+}
+
+static Value numerobis_builtin_cycles(Value *args) {
+  (void)args;
+  return int__init__((long)_cycle_count(), U_ONE);
+}
+
+// Named interval timers. State is per thread (no locks on the
+// start/stop path); each thread accumulates and reports its own
+// intervals. Slots are found by linear scan — profiling sections are
+// few, and the scan is cheap next to the clock read itself.
+
+#define TIMER_SLOTS 64
+
+typedef struct {
+  sds name;
+  long total_ns;
+  long count;
+  long started; /* perf stamp while running, -1 otherwise */
+} TimerSlot;
+
+static _Thread_local TimerSlot _timers[TIMER_SLOTS];
+static _Thread_local int _timer_count;
+
+static TimerSlot *_timer_slot(const char *name) {
+  for (int i = 0; i < _timer_count; i++)
+    if (strcmp(_timers[i].name, name) == 0)
+      return &_timers[i];
+  if (_timer_count == TIMER_SLOTS)
+    return NULL;
+  TimerSlot *slot = &_timers[_timer_count++];
+  slot->name = sdsnew(name);
+  slot->total_ns = 0;
+  slot->count = 0;
+  slot->started = -1;
+  return slot;
+}
+
+static Value numerobis_builtin_timer_start(Value *args) {
+  TimerSlot *slot = _timer_slot(args[1].str);
+  if (slot)
+    slot->started = _perf_ns();
+  return NONE;
+}
+
+static Value numerobis_builtin_timer_stop(Value *args) {
+  long stamp = _perf_ns();
+  TimerSlot *slot = _timer_slot(args[1].str);
+  if (slot && slot->started >= 0) {
+    slot->total_ns += stamp - slot->started;
+    slot->count++;
+    slot->started = -1;
+  }
+  return NONE;
+}
+
+static Value numerobis_builtin_timer_reset(Value *args) {
+  (void)args;
+  for (int i = 0; i < _timer_count; i++)
+    sdsfree(_timers[i].name);
+  _timer_count = 0;
+  return NONE;
+}
+
+static Value numerobis_builtin_timer_report(Value *args) {
+  (void)args;
+  sds s = sdsempty();
+  for (int i = 0; i < _timer_count; i++) {
+    TimerSlot *slot = &_timers[i];
+    double total_ms = slot->total_ns * 1e-6;
+    double avg_ms = slot->count ? total_ms / slot->count : 0.0;
+    s = sdscatprintf(s, "%-24s %10ld calls %14.3f ms total %12.4f ms avg\n",
+                     slot->name, slot->count, total_ms, avg_ms);
+  }
+  return str__init__(s);
+}
+
 void numerobis_time_register_builtins(void) {
   u_extern_register("now", numerobis_builtin_now);
   u_extern_register("sleep", numerobis_builtin_sleep);
+  u_extern_register("perf", numerobis_builtin_perf);
+  u_extern_register("cycles", numerobis_builtin_cycles);
+  u_extern_register("timer__start", numerobis_builtin_timer_start);
+  u_extern_register("timer__stop", numerobis_builtin_timer_stop);
+  u_extern_register("timer__reset", numerobis_builtin_timer_reset);
+  u_extern_register("timer__report", numerobis_builtin_timer_report);
 }
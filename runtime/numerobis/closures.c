@@ -10,6 +10,8 @@ Value closure__init__(Value (*func)(void *, Value *), void *env,
   c->func = func;
   c->env = env;
   c->bound_arg = bound_arg;
+  c->direct = NULL;
+  c->direct_arity = 0;
 
   Value v;
   v.type = VALUE_CLOSURE;
@@ -17,6 +19,14 @@ Value closure__init__(Value (*func)(void *, Value *), void *env,
   return v;
 }
 
+Value closure__init_direct__(Value (*func)(void *, Value *), void *env,
+                             void *direct, unsigned char arity) {
+  Value v = closure__init__(func, env, (Value){.type = VALUE_EMPTY});
+  v.closure->direct = direct;
+  v.closure->direct_arity = arity;
+  return v;
+}
+
 void *closure_capture(size_t size, void *stack_env) {
   if (size == 0)
     return NULL;
@@ -1,6 +1,7 @@
 #ifndef NUMEROBIS_CLOSURES_H
 #define NUMEROBIS_CLOSURES_H
 
+#include "types/number.h"
 #include "units/units.h"
 #include "values.h"
 
@@ -14,9 +15,16 @@
 #define U_UNPACK_ARG(name, i) Value name = __args[i];
 #define U_UNPACK_OPT_ARG(name, i, def)                                         \
   Value name = (__args[i].type != VALUE_EMPTY ? __args[i] : (def));
+/* Register-convention counterpart of U_UNPACK_OPT_ARG: the parameter
+ * already holds the argument, EMPTY marks an omitted default. */
+#define U_DEFAULT_ARG(name, def)                                               \
+  if (name.type == VALUE_EMPTY)                                                \
+    name = (def);
 
 Value closure__init__(Value (*func)(void *, Value *), void *env,
                       Value bound_arg);
+Value closure__init_direct__(Value (*func)(void *, Value *), void *env,
+                             void *direct, unsigned char arity);
 
 void *closure_capture(size_t size, void *stack_env);
 
@@ -25,6 +33,23 @@ void *closure_capture(size_t size, void *stack_env);
                   closure_capture(sizeof(env_type), &(env_type){__VA_ARGS__}), \
                   EMPTY)
 
+/* Named functions of at most NBIS_DIRECT_MAX_ARITY parameters also carry
+ * their register-convention entry point (__call0d__ .. __call4d__ in
+ * values.h); `impl` stays the array-ABI wrapper indirect callers use. */
+#define U_NEW_DIRECT_CLOSURE(impl, direct, arity, env_type, ...)               \
+  closure__init_direct__(                                                      \
+      impl, closure_capture(sizeof(env_type), &(env_type){__VA_ARGS__}),       \
+      (void *)(direct), arity)
+
+/* Escape-analysis variant: for a lambda passed straight into a callee
+ * that never retains it (NON_RETAINING_CALLEES in compiler/scoping.py),
+ * the Closure and its environment are compound literals on the caller's
+ * stack — no GC_MALLOC, no capture memcpy. Their lifetime is the
+ * enclosing C block, which covers the call and nothing more. */
+#define U_NEW_STACK_CLOSURE(impl, env_type, ...)                               \
+  ((Value){.type = VALUE_CLOSURE,                                              \
+           .closure = &(Closure){impl, &(env_type){__VA_ARGS__}, EMPTY}})
+
 static inline bool _is_plain_int(Value v) {
   return v.type == VALUE_NUMBER && v.number.kind == NUM_INT64 &&
          v.number.unit == NUMEROBIS_UNIT_ONE_HASH;
@@ -45,6 +70,13 @@ static inline bool _is_plain_int(Value v) {
 #define FAST_SUB(a, b) _FAST_INT_BINOP(a, b, -, __sub__)
 #define FAST_MUL(a, b) _FAST_INT_BINOP(a, b, *, __mul__)
 
+// Variants emitted when the typechecker proved both operands numeric:
+// the slow path goes straight to number arithmetic, skipping the
+// NUMEROBIS_METHODS indirection.
+#define FAST_ADD_NUM(a, b) _FAST_INT_BINOP(a, b, +, number__add__)
+#define FAST_SUB_NUM(a, b) _FAST_INT_BINOP(a, b, -, number__sub__)
+#define FAST_MUL_NUM(a, b) _FAST_INT_BINOP(a, b, *, number__mul__)
+
 #define _FAST_CMP_BOOL(a, b, int_op, fallback_fn)                              \
   ({                                                                           \
     Value _fa = (a), _fb = (b);                                                \
@@ -23,7 +23,19 @@ static const RuntimeMessage NUMEROBIS_MESSAGES[] = {
     {901, "IndexError", "list index out of range", NULL},
     {902, "IndexError", "string index out of range", NULL},
     {903, "IndexError", "list assignment index out of range", NULL},
-    {904, "IndexError", "string assignment index out of range", NULL}
+    {904, "IndexError", "string assignment index out of range", NULL},
+    {905, "ValueError", "elementwise operation on lists of different lengths",
+     NULL},
+    {906, "KeyError", "map key not found", NULL},
+    {907, "TypeError", "unhashable type used as map key", NULL},
+    {908, "NameError", "unknown struct field in column access", NULL},
+    {909, "IOError", "could not open file", NULL},
+    {910, "IOError", "file read or write failed", NULL},
+    {911, "ValueError", "invalid or incompatible checkpoint file", NULL},
+    {912, "TypeError", "value cannot be serialized to JSON", NULL},
+    {913, "ValueError", "invalid JSON input", NULL},
+    {914, "IndexError", "vector index out of range", NULL},
+    {915, "ValueError", "reduction of an empty list", NULL}
     /* </CONTENT> */
 };
 
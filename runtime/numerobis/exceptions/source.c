@@ -0,0 +1,72 @@
+#include "source.h"
+#include "../libs/gc_stb_ds.h"
+#include "throw.h"
+
+#include "../libs/bdwgc/include/gc.h"
+#include <string.h>
+
+/* Counterpart of lzss_compress in src/numerobis/compiler/utils.py:
+ * 4 KiB window, 3..18 byte matches. A flag byte precedes eight items,
+ * LSB first; bit 0 = literal, 1 = match pair (lo = distance & 0xFF,
+ * hi = (distance >> 8) << 4 | (length - 3)). */
+static void _lzss_decompress(const unsigned char *src, unsigned int comp_len,
+                             unsigned char *dst, unsigned int raw_len) {
+  unsigned int si = 0, di = 0;
+  while (si < comp_len && di < raw_len) {
+    unsigned int flags = src[si++];
+    for (int bit = 0; bit < 8 && si < comp_len && di < raw_len; bit++) {
+      if (flags & (1u << bit)) {
+        unsigned int lo = src[si++];
+        unsigned int hi = src[si++];
+        unsigned int dist = ((hi >> 4) << 8) | lo;
+        unsigned int len = (hi & 0xF) + 3;
+        for (unsigned int k = 0; k < len && di < raw_len; k++, di++)
+          dst[di] = dst[di - dist];
+      } else {
+        dst[di++] = src[si++];
+      }
+    }
+  }
+}
+
+NumerobisProgram *u_source_load(const char *path) {
+  NumerobisProgram *cached = shget(NUMEROBIS_MODULE_REGISTRY, path);
+  if (cached)
+    return cached;
+
+  const NumerobisSourceBlob *blob = NULL;
+  for (int i = 0; i < NUMEROBIS_SOURCE_BLOB_COUNT; i++) {
+    if (strcmp(NUMEROBIS_SOURCE_BLOBS[i].path, path) == 0) {
+      blob = &NUMEROBIS_SOURCE_BLOBS[i];
+      break;
+    }
+  }
+  if (!blob)
+    return NULL;
+
+  char *text = GC_MALLOC_ATOMIC(blob->raw_len + 1);
+  _lzss_decompress(blob->data, blob->comp_len, (unsigned char *)text,
+                   blob->raw_len);
+  text[blob->raw_len] = '\0';
+
+  int n_lines = blob->n_lines > 0 ? blob->n_lines : 1;
+  const char **lines = GC_MALLOC(sizeof(char *) * (size_t)n_lines);
+  int line = 0;
+  lines[line++] = text;
+  for (unsigned int i = 0; i < blob->raw_len; i++) {
+    if (text[i] == '\n') {
+      text[i] = '\0';
+      if (line < n_lines)
+        lines[line++] = &text[i + 1];
+    }
+  }
+  while (line < n_lines)
+    lines[line++] = "";
+
+  NumerobisProgram *program = GC_MALLOC(sizeof(NumerobisProgram));
+  NumerobisProgram init = {blob->path, blob->n_lines, lines};
+  memcpy(program, &init, sizeof init);
+
+  shput(NUMEROBIS_MODULE_REGISTRY, (char *)blob->path, program);
+  return program;
+}
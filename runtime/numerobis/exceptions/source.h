@@ -7,4 +7,23 @@ typedef struct {
   const char **source;
 } NumerobisProgram;
 
+/* Compressed module source embedded by the compiler backends
+ * (prepare_source_blobs in compiler/utils.py), kept in the `nbis_src`
+ * section and only decompressed when an error preview is printed. */
+typedef struct {
+  const char *path;
+  int n_lines;
+  const unsigned char *data;
+  unsigned int comp_len;
+  unsigned int raw_len;
+} NumerobisSourceBlob;
+
+extern const NumerobisSourceBlob NUMEROBIS_SOURCE_BLOBS[];
+extern const int NUMEROBIS_SOURCE_BLOB_COUNT;
+
+/* Decompresses and line-splits a module's source on first use, caching
+ * the result in NUMEROBIS_MODULE_REGISTRY. Returns NULL if the path
+ * has no embedded source. */
+NumerobisProgram *u_source_load(const char *path);
+
 #endif
@@ -49,7 +49,9 @@ static Location *_location_split(const Location *self, size_t *out_len) {
 
 static void print_preview(const Location *span) {
   NumerobisProgram *program =
-      shget(NUMEROBIS_MODULE_REGISTRY, NUMEROBIS__FILES__[NUMEROBIS__FILE__]);
+      u_source_load(NUMEROBIS__FILES__[NUMEROBIS__FILE__]);
+  if (!program)
+    return;
   size_t n = 0;
   Location *lines = _location_split(span, &n);
   fprintf(stderr, "\n");
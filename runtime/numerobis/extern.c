@@ -1,12 +1,28 @@
 #include "extern.h"
+#include "builtins/builtins.h"
 #include "libs/gc_stb_ds.h"
 
 #include "libs/bdwgc/include/gc.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 ExternEntry *NUMEROBIS_EXTERNS = NULL;
 
+/* The builtin externs are registered on the first lookup rather than
+ * in the runtime constructor, so programs that never call an extern
+ * never build the registry. The first lookup is the generated code's
+ * startup u_externs_resolve(), which runs before any task is spawned,
+ * so no synchronization is needed here. */
+static bool _builtins_registered = false;
+
+static void externs_ensure(void) {
+  if (_builtins_registered)
+    return;
+  _builtins_registered = true;
+  u_register_builtin_externs();
+}
+
 void u_externs_shutdown(void) {
   shfree(NUMEROBIS_EXTERNS);
   NUMEROBIS_EXTERNS = NULL;
@@ -30,6 +46,7 @@ void u_extern_register(const char *name, Value (*fn)(Value *args)) {
 }
 
 Value *u_extern_lookup(const char *name) {
+  externs_ensure();
   ExternEntry *entry = shgetp_null(NUMEROBIS_EXTERNS, name);
   if (entry)
     return entry->value;
@@ -38,3 +55,12 @@ Value *u_extern_lookup(const char *name) {
   exit(1);
   return NULL;
 }
+
+// Fills the dense extern table emitted by the linker: one string lookup
+// per unique extern at startup, after which generated code reaches every
+// extern with an indexed load. The name map above stays available for
+// dynamic and debug lookups.
+void u_externs_resolve(const char *const *names, Value *out, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    out[i] = *u_extern_lookup(names[i]);
+}
@@ -16,5 +16,6 @@ Value *extern_fn__init__(Value (*fn)(Value *args));
 void u_extern_entry_free(void *data);
 void u_extern_register(const char *name, Value (*fn)(Value *args));
 Value *u_extern_lookup(const char *name);
+void u_externs_resolve(const char *const *names, Value *out, size_t count);
 
 #endif
@@ -58,8 +58,8 @@ static inline int sdsHdrSize(char type) {
 }
 
 static inline char sdsReqType(size_t string_size) {
-  if (string_size < 1 << 5)
-    return SDS_TYPE_5;
+  /* Type 5 is never produced: its header has no room for the cached
+   * content hash (see sdshash). */
   if (string_size < 1 << 8)
     return SDS_TYPE_8;
   if (string_size < 1 << 16)
@@ -115,6 +115,7 @@ sds sdsnewlen(const void *init, size_t initlen) {
     SDS_HDR_VAR(8, s);
     sh->len = initlen;
     sh->alloc = initlen;
+    sh->hash = 0;
     *fp = type;
     break;
   }
@@ -122,6 +123,7 @@ sds sdsnewlen(const void *init, size_t initlen) {
     SDS_HDR_VAR(16, s);
     sh->len = initlen;
     sh->alloc = initlen;
+    sh->hash = 0;
     *fp = type;
     break;
   }
@@ -129,6 +131,7 @@ sds sdsnewlen(const void *init, size_t initlen) {
     SDS_HDR_VAR(32, s);
     sh->len = initlen;
     sh->alloc = initlen;
+    sh->hash = 0;
     *fp = type;
     break;
   }
@@ -136,6 +139,7 @@ sds sdsnewlen(const void *init, size_t initlen) {
     SDS_HDR_VAR(64, s);
     sh->len = initlen;
     sh->alloc = initlen;
+    sh->hash = 0;
     *fp = type;
     break;
   }
@@ -336,6 +340,7 @@ void *sdsAllocPtr(sds s) { return (void *)(s - sdsHdrSize(s[-1])); }
  * sdsIncrLen(s, nread);
  */
 void sdsIncrLen(sds s, ssize_t incr) {
+  sdsclearhash(s);
   unsigned char flags = s[-1];
   size_t len;
   switch (flags & SDS_TYPE_MASK) {
@@ -807,6 +812,7 @@ void sdstolower(sds s) {
 
   for (j = 0; j < len; j++)
     s[j] = tolower(s[j]);
+  sdsclearhash(s);
 }
 
 /* Apply toupper() to every character of the sds string 's'. */
@@ -815,6 +821,7 @@ void sdstoupper(sds s) {
 
   for (j = 0; j < len; j++)
     s[j] = toupper(s[j]);
+  sdsclearhash(s);
 }
 
 /* Compare two sds strings s1 and s2 with memcmp().
@@ -841,6 +848,57 @@ int sdscmp(const sds s1, const sds s2) {
   return cmp;
 }
 
+/* 64-bit FNV-1a hash of the string contents, computed lazily and cached
+ * in the header so that repeated equality checks and hash-map lookups
+ * only ever hash a string once. Mutating operations reset the slot via
+ * sdsclearhash(); a computed hash of 0 is remapped so 0 can keep
+ * meaning "not cached". Type 5 headers have no slot and recompute. */
+uint64_t sdshash(const sds s) {
+  unsigned char type = s[-1] & SDS_TYPE_MASK;
+  uint64_t cached = 0;
+  switch (type) {
+  case SDS_TYPE_8:
+    cached = SDS_HDR(8, s)->hash;
+    break;
+  case SDS_TYPE_16:
+    cached = SDS_HDR(16, s)->hash;
+    break;
+  case SDS_TYPE_32:
+    cached = SDS_HDR(32, s)->hash;
+    break;
+  case SDS_TYPE_64:
+    cached = SDS_HDR(64, s)->hash;
+    break;
+  }
+  if (cached)
+    return cached;
+
+  uint64_t h = 0xCBF29CE484222325ULL;
+  size_t len = sdslen(s);
+  for (size_t i = 0; i < len; i++) {
+    h ^= (uint8_t)s[i];
+    h *= 0x100000001B3ULL;
+  }
+  if (h == 0)
+    h = 0x9E3779B97F4A7C15ULL;
+
+  switch (type) {
+  case SDS_TYPE_8:
+    SDS_HDR(8, s)->hash = h;
+    break;
+  case SDS_TYPE_16:
+    SDS_HDR(16, s)->hash = h;
+    break;
+  case SDS_TYPE_32:
+    SDS_HDR(32, s)->hash = h;
+    break;
+  case SDS_TYPE_64:
+    SDS_HDR(64, s)->hash = h;
+    break;
+  }
+  return h;
+}
+
 /* Split 's' with separator in 'sep'. An array
  * of sds strings is returned. *count will be set
  * by reference to the number of tokens returned.
@@ -1183,6 +1241,7 @@ sds sdsmapchars(sds s, const char *from, const char *to, size_t setlen) {
       }
     }
   }
+  sdsclearhash(s);
   return s;
 }
 
@@ -49,24 +49,28 @@ struct __attribute__((__packed__)) sdshdr5 {
   char buf[];
 };
 struct __attribute__((__packed__)) sdshdr8 {
+  uint64_t hash;       /* cached content hash, 0 = not computed */
   uint8_t len;         /* used */
   uint8_t alloc;       /* excluding the header and null terminator */
   unsigned char flags; /* 3 lsb of type, 5 unused bits */
   char buf[];
 };
 struct __attribute__((__packed__)) sdshdr16 {
+  uint64_t hash;       /* cached content hash, 0 = not computed */
   uint16_t len;        /* used */
   uint16_t alloc;      /* excluding the header and null terminator */
   unsigned char flags; /* 3 lsb of type, 5 unused bits */
   char buf[];
 };
 struct __attribute__((__packed__)) sdshdr32 {
+  uint64_t hash;       /* cached content hash, 0 = not computed */
   uint32_t len;        /* used */
   uint32_t alloc;      /* excluding the header and null terminator */
   unsigned char flags; /* 3 lsb of type, 5 unused bits */
   char buf[];
 };
 struct __attribute__((__packed__)) sdshdr64 {
+  uint64_t hash;       /* cached content hash, 0 = not computed */
   uint64_t len;        /* used */
   uint64_t alloc;      /* excluding the header and null terminator */
   unsigned char flags; /* 3 lsb of type, 5 unused bits */
@@ -128,7 +132,27 @@ static inline size_t sdsavail(const sds s) {
   return 0;
 }
 
+/* Invalidate the lazily cached content hash (see sdshash). Type 5
+ * headers have no hash slot and always recompute. */
+static inline void sdsclearhash(sds s) {
+  switch (s[-1] & SDS_TYPE_MASK) {
+  case SDS_TYPE_8:
+    SDS_HDR(8, s)->hash = 0;
+    break;
+  case SDS_TYPE_16:
+    SDS_HDR(16, s)->hash = 0;
+    break;
+  case SDS_TYPE_32:
+    SDS_HDR(32, s)->hash = 0;
+    break;
+  case SDS_TYPE_64:
+    SDS_HDR(64, s)->hash = 0;
+    break;
+  }
+}
+
 static inline void sdssetlen(sds s, size_t newlen) {
+  sdsclearhash(s);
   unsigned char flags = s[-1];
   switch (flags & SDS_TYPE_MASK) {
   case SDS_TYPE_5: {
@@ -151,6 +175,7 @@ static inline void sdssetlen(sds s, size_t newlen) {
 }
 
 static inline void sdsinclen(sds s, size_t inc) {
+  sdsclearhash(s);
   unsigned char flags = s[-1];
   switch (flags & SDS_TYPE_MASK) {
   case SDS_TYPE_5: {
@@ -238,6 +263,7 @@ void sdsrange(sds s, ssize_t start, ssize_t end);
 void sdsupdatelen(sds s);
 void sdsclear(sds s);
 int sdscmp(const sds s1, const sds s2);
+uint64_t sdshash(const sds s);
 sds *sdssplitlen(const char *s, ssize_t len, const char *sep, int seplen,
                  int *count);
 void sdsfreesplitres(sds *tokens, int count);
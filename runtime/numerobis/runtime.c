@@ -1,12 +1,16 @@
 #include "runtime.h"
-#include "builtins/builtins.h"
 #include "extern.h"
 #include "types/bool.h"
+#include "types/file.h"
 #include "types/list.h"
+#include "types/map.h"
+#include "types/strbuilder.h"
 #include "types/number.h"
 #include "types/range.h"
 #include "types/str.h"
 #include "types/struct.h"
+#include "types/task.h"
+#include "types/vec.h"
 #include "units/units.h"
 #include <locale.h>
 
@@ -14,17 +18,33 @@ int NUMEROBIS__FILE__ = 0;
 
 __attribute__((constructor)) static void numerobis_runtime_ctor(void) {
   setlocale(LC_ALL, ""); // set locale for utf-8 output
+
+  // Collector setup. bdwgc is built with parallel marking (see
+  // scripts/gc.sh); 0 sizes the marker threads to the core count unless
+  // the GC_MARKERS environment variable overrides it. GC_INIT itself
+  // honors GC_INITIAL_HEAP_SIZE, GC_FREE_SPACE_DIVISOR and
+  // GC_ENABLE_INCREMENTAL — the gc stdlib module exposes the same knobs
+  // from inside a running program.
+  GC_set_markers_count(0);
   GC_INIT();
 
-  u_register_builtin_externs();
+  // Cheap: computes the dimensionless unit hash only. The unit intern
+  // pool is allocated on first use, and the builtin extern registry is
+  // built on the first extern lookup (extern.c), so small programs
+  // that use neither skip those allocations entirely.
   units_init();
 
   bool_methods_init();
+  file_methods_init();
   list_methods_init();
+  map_methods_init();
   number_methods_init();
   range_methods_init();
   str_methods_init();
+  strbuilder_methods_init();
   struct_methods_init();
+  task_methods_init();
+  vec_methods_init();
 }
 
 __attribute__((destructor)) static void numerobis_runtime_dtor(void) {
@@ -0,0 +1,263 @@
+#include "file.h"
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/gc_stb_ds.h"
+#include "../libs/sds.h"
+#include "../units/units.h"
+#include "bool.h"
+#include "list.h"
+#include "methods.h"
+#include "number.h"
+#include "str.h"
+
+#include <fcntl.h>
+#include <gc/gc.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/* One read(2) per this many bytes while streaming. */
+#define FILE_BUF_SIZE (1 << 16)
+
+/* writev gathers at most this many iovecs per syscall; POSIX guarantees
+ * at least 16, every target we build on allows far more. */
+#define FILE_IOV_BATCH 256
+
+static const ValueMethods _file_methods;
+
+Value file__init__(int fd, bool writable) {
+  Value v;
+  v.type = VALUE_FILE;
+
+  File *obj = GC_MALLOC(sizeof(File));
+  obj->fd = fd;
+  obj->writable = writable;
+  obj->at_eof = false;
+  obj->closed = false;
+  obj->buf = writable ? NULL : GC_MALLOC_ATOMIC(FILE_BUF_SIZE);
+  obj->cap = writable ? 0 : FILE_BUF_SIZE;
+  obj->pos = 0;
+  obj->len = 0;
+
+  v.file = obj;
+  return v;
+}
+
+/* Ensures at least one unconsumed byte is buffered; false at EOF. */
+static bool _file_fill(File *f) {
+  if (f->pos < f->len)
+    return true;
+  if (f->at_eof || f->closed)
+    return false;
+
+  f->pos = f->len = 0;
+  ssize_t r = read(f->fd, f->buf, f->cap);
+  if (r < 0)
+    u_throw(910, NULL, NULL);
+  if (r == 0) {
+    f->at_eof = true;
+    return false;
+  }
+  f->len = (size_t)r;
+  return true;
+}
+
+void file_write_all(int fd, const char *p, size_t len) {
+  while (len > 0) {
+    ssize_t w = write(fd, p, len);
+    if (w < 0)
+      u_throw(910, NULL, NULL);
+    p += w;
+    len -= (size_t)w;
+  }
+}
+
+void file_writev_all(int fd, struct iovec *iov, int cnt) {
+  while (cnt > 0) {
+    ssize_t w = writev(fd, iov, cnt);
+    if (w < 0)
+      u_throw(910, NULL, NULL);
+    // Skip the iovecs a short write fully covered, trim the partial one.
+    while (cnt > 0 && (size_t)w >= iov->iov_len) {
+      w -= (ssize_t)iov->iov_len;
+      iov++;
+      cnt--;
+    }
+    if (cnt > 0) {
+      iov->iov_base = (char *)iov->iov_base + w;
+      iov->iov_len -= (size_t)w;
+    }
+  }
+}
+
+// Methods
+
+static Value file__bool__(Value self) {
+  return bool__init__(!self.file->closed);
+}
+static bool file__cbool__(Value self) { return !self.file->closed; }
+
+static Value file__eq__(Value a, Value b) {
+  return bool__init__(a.file == b.file);
+}
+
+static Value file__str__(Value self) {
+  return str__init__(sdscatprintf(sdsempty(), "<File fd=%d>", self.file->fd));
+}
+
+// Externs
+
+static Value file_open(Value *args) {
+  const char *path = args[1].str;
+  const char *mode = args[2].type == VALUE_EMPTY ? "r" : args[2].str;
+
+  int flags;
+  bool writable = true;
+  if (strcmp(mode, "w") == 0)
+    flags = O_WRONLY | O_CREAT | O_TRUNC;
+  else if (strcmp(mode, "a") == 0)
+    flags = O_WRONLY | O_CREAT | O_APPEND;
+  else {
+    flags = O_RDONLY;
+    writable = false;
+  }
+
+  int fd = open(path, flags, 0644);
+  if (fd < 0)
+    u_throw(909, NULL, NULL);
+
+  return file__init__(fd, writable);
+}
+
+static Value file_read(Value *args) {
+  File *f = args[2].file;
+  long n = args[1].type == VALUE_EMPTY ? -1 : args[1].number.i64;
+  if (f->closed || f->writable)
+    u_throw(910, NULL, NULL);
+
+  sds out = sdsempty();
+  if (n < 0) {
+    while (_file_fill(f)) {
+      out = sdscatlen(out, f->buf + f->pos, f->len - f->pos);
+      f->pos = f->len;
+    }
+  } else {
+    while (n > 0 && _file_fill(f)) {
+      size_t avail = f->len - f->pos;
+      size_t take = (size_t)n < avail ? (size_t)n : avail;
+      out = sdscatlen(out, f->buf + f->pos, take);
+      f->pos += take;
+      n -= (long)take;
+    }
+  }
+  return str__init__(out);
+}
+
+/* Consumes up to the next '\n' and returns the line without its
+ * terminator ("\r\n" included). Pair with File.eof for iteration:
+ * reading the last line leaves eof() true. */
+static Value file_readline(Value *args) {
+  File *f = args[1].file;
+  if (f->closed || f->writable)
+    u_throw(910, NULL, NULL);
+
+  sds line = sdsempty();
+  while (_file_fill(f)) {
+    char *nl = memchr(f->buf + f->pos, '\n', f->len - f->pos);
+    if (nl != NULL) {
+      line = sdscatlen(line, f->buf + f->pos, (size_t)(nl - f->buf) - f->pos);
+      f->pos = (size_t)(nl - f->buf) + 1;
+      break;
+    }
+    line = sdscatlen(line, f->buf + f->pos, f->len - f->pos);
+    f->pos = f->len;
+  }
+
+  size_t len = sdslen(line);
+  if (len > 0 && line[len - 1] == '\r') {
+    sdssetlen(line, len - 1);
+    line[len - 1] = '\0';
+  }
+  return str__init__(line);
+}
+
+/* True once every buffered byte is consumed and the descriptor is
+ * exhausted — peeks ahead one buffer fill so `while not f.eof()` works. */
+static Value file_eof(Value *args) {
+  File *f = args[1].file;
+  if (f->closed || f->writable)
+    return bool__init__(true);
+  return bool__init__(!_file_fill(f));
+}
+
+static Value file_write(Value *args) {
+  File *f = args[2].file;
+  if (f->closed || !f->writable)
+    u_throw(910, NULL, NULL);
+  file_write_all(f->fd, args[1].str, sdslen(args[1].str));
+  return NONE;
+}
+
+/* Every line plus its terminator becomes one iovec pair; a batch of 256
+ * fragments goes to the kernel in a single writev. */
+static Value file_writelines(Value *args) {
+  File *f = args[3].file;
+  if (f->closed || !f->writable)
+    u_throw(910, NULL, NULL);
+
+  Value *items = list_items(args[1].list);
+  const char *end = args[2].type == VALUE_EMPTY ? "\n" : args[2].str;
+  size_t end_len = args[2].type == VALUE_EMPTY ? 1 : sdslen(args[2].str);
+
+  struct iovec iov[FILE_IOV_BATCH];
+  int cnt = 0;
+  for (size_t i = 0; i < arrlen(items); i++) {
+    iov[cnt].iov_base = items[i].str;
+    iov[cnt].iov_len = sdslen(items[i].str);
+    cnt++;
+    if (end_len > 0) {
+      iov[cnt].iov_base = (void *)end;
+      iov[cnt].iov_len = end_len;
+      cnt++;
+    }
+    if (cnt > FILE_IOV_BATCH - 2) {
+      file_writev_all(f->fd, iov, cnt);
+      cnt = 0;
+    }
+  }
+  if (cnt > 0)
+    file_writev_all(f->fd, iov, cnt);
+  return NONE;
+}
+
+static Value file_close(Value *args) {
+  File *f = args[1].file;
+  if (!f->closed) {
+    close(f->fd);
+    f->closed = true;
+    f->buf = NULL;
+    f->pos = f->len = 0;
+  }
+  return NONE;
+}
+
+static const ValueMethods _file_methods = {
+    .__bool__ = file__bool__,
+    .__cbool__ = file__cbool__,
+    .__eq__ = file__eq__,
+    .__str__ = file__str__,
+};
+
+void file_methods_init(void) { NUMEROBIS_METHODS[VALUE_FILE] = &_file_methods; }
+
+void numerobis_file_register_externs(void) {
+  u_extern_register("open", file_open);
+  u_extern_register("File.read", file_read);
+  u_extern_register("File.readline", file_readline);
+  u_extern_register("File.eof", file_eof);
+  u_extern_register("File.write", file_write);
+  u_extern_register("File.writelines", file_writelines);
+  u_extern_register("File.close", file_close);
+}
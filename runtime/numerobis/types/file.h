@@ -0,0 +1,35 @@
+#ifndef NUMEROBIS_FILE_H
+#define NUMEROBIS_FILE_H
+
+#include "../values.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/uio.h>
+
+/* Buffered file handle: reads go through a fixed read-ahead buffer so
+ * iterating a multi-gigabyte input line by line costs one read(2) per
+ * buffer fill instead of one per line, and writes of many fragments are
+ * gathered into writev(2) batches instead of one syscall each. */
+typedef struct File {
+  int fd;
+  bool writable;
+  bool at_eof; /* the descriptor returned 0 bytes */
+  bool closed;
+  char *buf; /* read-ahead buffer (atomic GC block) */
+  size_t cap;
+  size_t pos; /* next unconsumed byte in buf */
+  size_t len; /* valid bytes in buf */
+} File;
+
+Value file__init__(int fd, bool writable);
+
+/* Retrying write helpers shared with the whole-file builtins. */
+void file_write_all(int fd, const char *p, size_t len);
+void file_writev_all(int fd, struct iovec *iov, int cnt);
+
+void file_methods_init(void);
+
+void numerobis_file_register_externs(void);
+
+#endif
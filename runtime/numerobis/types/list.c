@@ -8,13 +8,22 @@
 #include "bool.h"
 #include "methods.h"
 #include "str.h"
+#include "struct.h"
 
 #include <gc/gc.h>
+#include <math.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 static const ValueMethods _list_methods;
 
@@ -24,18 +33,258 @@ Value list__init__(Value *items) {
 
   List *obj = GC_MALLOC(sizeof(List));
   obj->items = items;
+  obj->packed = NULL;
+  obj->unit = 0;
+  obj->cols = NULL;
+  obj->cstruct = 0;
+  obj->voff = obj->vlen = 0;
+  obj->is_view = obj->shared = false;
 
   v.list = (void *)obj;
   return v;
 }
 
-Value list_of(const Value *items, size_t len) {
-  Value *result = NULL;
+Value list_packed__init__(double *packed, uint64_t unit) {
+  Value v;
+  v.type = VALUE_LIST;
 
-  arrsetcap(result, len);
+  List *obj = GC_MALLOC(sizeof(List));
+  obj->items = NULL;
+  obj->packed = packed;
+  obj->unit = unit;
+  obj->cols = NULL;
+  obj->cstruct = 0;
+  obj->voff = obj->vlen = 0;
+  obj->is_view = obj->shared = false;
+
+  v.list = (void *)obj;
+  return v;
+}
+
+Value list_cols__init__(Value **cols, long cstruct) {
+  Value v;
+  v.type = VALUE_LIST;
+
+  List *obj = GC_MALLOC(sizeof(List));
+  obj->items = NULL;
+  obj->packed = NULL;
+  obj->unit = 0;
+  obj->cols = cols;
+  obj->cstruct = cstruct;
+  obj->voff = obj->vlen = 0;
+  obj->is_view = obj->shared = false;
+
+  v.list = (void *)obj;
+  return v;
+}
+
+// O(1) slice: the view borrows the base's storage array. `off` is relative
+// to the base (views compose by accumulating offsets).
+static Value list_view__init__(List *base, size_t off, size_t len) {
+  Value v;
+  v.type = VALUE_LIST;
+
+  List *obj = GC_MALLOC(sizeof(List));
+  obj->items = base->items;
+  obj->packed = base->packed;
+  obj->unit = base->unit;
+  obj->cols = NULL;
+  obj->cstruct = 0;
+  obj->voff = _list_off(base) + off;
+  obj->vlen = len;
+  obj->is_view = true;
+  obj->shared = false;
+  base->shared = true;
+
+  v.list = (void *)obj;
+  return v;
+}
+
+// Columnar de-opt: rebuild one strukt allocation per element from the
+// per-field columns. After this the list is ordinary array-of-structs.
+static void _list_decolumnarize(List *self) {
+  if (!self->cols)
+    return;
+
+  size_t len = arrlen(self->cols[0]);
+  size_t fieldc = arrlen(self->cols);
+  Value *items = NULL;
+  arrsetcap(items, len);
 
   for (size_t i = 0; i < len; i++) {
-    arrput(result, items[i]);
+    Value v;
+    v.type = VALUE_STRUCT;
+    v.strukt = GC_MALLOC((fieldc + 1) * sizeof(Value));
+    v.strukt[0] = int__init__(self->cstruct, U_ONE);
+    for (size_t f = 0; f < fieldc; f++)
+      v.strukt[f + 1] = self->cols[f][i];
+    arrput(items, v);
+  }
+
+  self->items = items;
+  self->cols = NULL;
+}
+
+void list_detach(List *self) {
+  _list_decolumnarize(self);
+
+  if (self->is_view) {
+    size_t len = self->vlen;
+    size_t off = self->voff;
+    if (self->packed) {
+      double *own = NULL;
+      arrsetlen(own, len);
+      if (len)
+        memcpy(own, self->packed + off, len * sizeof(double));
+      self->packed = own;
+    } else if (self->items) {
+      Value *own = NULL;
+      arrsetlen(own, len);
+      if (len)
+        memcpy(own, self->items + off, len * sizeof(Value));
+      self->items = own;
+    }
+    self->is_view = false;
+    self->voff = self->vlen = 0;
+    return;
+  }
+
+  if (self->shared) {
+    size_t len = _list_len(self);
+    size_t off = self->voff;
+    if (self->packed) {
+      double *own = NULL;
+      arrsetlen(own, len);
+      if (len)
+        memcpy(own, self->packed + off, len * sizeof(double));
+      self->packed = own;
+    } else if (self->items) {
+      Value *own = NULL;
+      arrsetlen(own, len);
+      if (len)
+        memcpy(own, self->items + off, len * sizeof(Value));
+      self->items = own;
+    }
+    self->voff = 0;
+    self->shared = false;
+  }
+}
+
+Value *list_items(List *self) {
+  if (!self)
+    return NULL;
+
+  _list_decolumnarize(self);
+
+  if (self->is_view || (self->shared && self->voff))
+    list_detach(self);
+
+  // Callers index the returned array from 0, so shift out any head offset
+  // left behind by front pops (storage is owned and unshared here).
+  if (self->voff) {
+    size_t len = _list_len(self);
+    if (self->packed) {
+      memmove(self->packed, self->packed + self->voff, len * sizeof(double));
+      arrsetlen(self->packed, len);
+    } else if (self->items) {
+      memmove(self->items, self->items + self->voff, len * sizeof(Value));
+      arrsetlen(self->items, len);
+    }
+    self->voff = 0;
+  }
+
+  if (self->packed) {
+    // De-opt: box the payloads once; the list stays boxed from here on.
+    // Any live views alias the old packed array, so the fresh boxed array
+    // is unshared.
+    size_t len = arrlen(self->packed);
+    Value *boxed = NULL;
+    arrsetcap(boxed, len);
+    for (size_t i = 0; i < len; i++) {
+      arrput(boxed, num__init__(self->packed[i], self->unit));
+    }
+    self->items = boxed;
+    self->packed = NULL;
+    self->shared = false;
+  }
+  return self->items;
+}
+
+// Lists at least this long with uniform dimensioned-double elements are
+// stored packed (8 bytes/element instead of a full boxed Value).
+#define LIST_PACK_MIN 8
+
+static bool _list_packable(const Value *items, size_t len, uint64_t *unit) {
+  if (len < LIST_PACK_MIN)
+    return false;
+  if (items[0].type != VALUE_NUMBER || items[0].number.kind != NUM_DOUBLE)
+    return false;
+
+  *unit = items[0].number.unit;
+  for (size_t i = 1; i < len; i++) {
+    if (items[i].type != VALUE_NUMBER || items[i].number.kind != NUM_DOUBLE ||
+        items[i].number.unit != *unit)
+      return false;
+  }
+  return true;
+}
+
+// Homogeneous struct lists are stored columnar: one contiguous Value array
+// per field instead of one heap allocation per instance. Like packed
+// numeric storage this copies element payloads at construction, so a
+// struct reached through another reference is no longer aliased by the
+// list; element access materializes back to array-of-structs.
+static bool _list_columnar(const Value *items, size_t len, long *id) {
+  if (len < LIST_PACK_MIN)
+    return false;
+  if (items[0].type != VALUE_STRUCT)
+    return false;
+
+  *id = items[0].strukt[0].number.i64;
+  if (STRUCT_REGISTRY[*id].fieldc == 0)
+    return false;
+
+  for (size_t i = 1; i < len; i++) {
+    if (items[i].type != VALUE_STRUCT || items[i].strukt[0].number.i64 != *id)
+      return false;
+  }
+  return true;
+}
+
+Value list_of(const Value *items, size_t len) {
+  long struct_id;
+  if (items && _list_columnar(items, len, &struct_id)) {
+    size_t fieldc = STRUCT_REGISTRY[struct_id].fieldc;
+    Value **cols = NULL;
+    arrsetcap(cols, fieldc);
+    for (size_t f = 0; f < fieldc; f++) {
+      Value *col = NULL;
+      arrsetlen(col, len);
+      for (size_t i = 0; i < len; i++)
+        col[i] = items[i].strukt[f + 1];
+      arrput(cols, col);
+    }
+
+    Value v = list__init__(NULL);
+    ((List *)v.list)->cols = cols;
+    ((List *)v.list)->cstruct = struct_id;
+    return v;
+  }
+
+  uint64_t unit;
+  if (items && _list_packable(items, len, &unit)) {
+    double *packed = NULL;
+    arrsetlen(packed, len);
+    for (size_t i = 0; i < len; i++)
+      packed[i] = items[i].number.f64;
+    return list_packed__init__(packed, unit);
+  }
+
+  Value *result = NULL;
+
+  if (len) {
+    arrsetlen(result, len);
+    memcpy(result, items, len * sizeof(Value));
   }
 
   return list__init__(result);
@@ -52,6 +301,7 @@ static bool list__cbool__(Value self) {
 static Value list__getitem__(Value _self, Value _index) {
   List *self = (List *)_self.list;
   assert(_index.type == VALUE_NUMBER);
+  _list_decolumnarize(self);
 
   ssize_t index = (ssize_t)_index.number.i64;
   ssize_t len = (ssize_t)_list_len(self);
@@ -64,12 +314,17 @@ static Value list__getitem__(Value _self, Value _index) {
   if (nidx < 0 || nidx >= len)
     return EMPTY;
 
-  return self->items[nidx];
+  size_t off = _list_off(self);
+  if (self->packed)
+    return num__init__(self->packed[off + nidx], self->unit);
+
+  return self->items[off + nidx];
 }
 
 static Value list__getslice__(Value _self, Value _start, Value _stop,
                               Value _step) {
   List *self = (List *)_self.list;
+  _list_decolumnarize(self);
 
   ssize_t len = (ssize_t)_list_len(self);
   ssize_t start =
@@ -85,8 +340,23 @@ static Value list__getslice__(Value _self, Value _start, Value _stop,
 
   normalize_slice(len, &start, &end, &step);
 
+  // Contiguous slices become O(1) views over the base storage; the copy
+  // happens lazily on first mutation of either side (list_detach).
+  if (step == 1 && end > start)
+    return list_view__init__(self, (size_t)start, (size_t)(end - start));
+
+  size_t off = _list_off(self);
+
+  if (self->packed) {
+    double *slice = NULL;
+    for (ssize_t i = start; step > 0 ? i < end : i > end; i += step) {
+      arrput(slice, self->packed[off + i]);
+    }
+    return list_packed__init__(slice, self->unit);
+  }
+
   for (ssize_t i = start; step > 0 ? i < end : i > end; i += step) {
-    Value val = self->items[i];
+    Value val = self->items[off + i];
     arrput(result, val);
   }
 
@@ -99,20 +369,67 @@ static Value list__add__(Value _self, Value _other) {
 
   size_t a_len = _list_len(self);
   size_t b_len = _list_len(other);
+
+  if (self->packed && other->packed && self->unit == other->unit) {
+    double *packed = NULL;
+    arrsetlen(packed, a_len + b_len);
+    if (a_len)
+      memcpy(packed, self->packed + _list_off(self), a_len * sizeof(double));
+    if (b_len)
+      memcpy(packed + a_len, other->packed + _list_off(other),
+             b_len * sizeof(double));
+    return list_packed__init__(packed, self->unit);
+  }
+
+  Value *a_items = list_items(self);
+  Value *b_items = list_items(other);
   Value *result = NULL;
 
-  arrsetcap(result, a_len + b_len);
+  arrsetlen(result, a_len + b_len);
 
-  for (size_t i = 0; i < a_len; i++) {
-    arrput(result, self->items[i]);
-  }
-  for (size_t i = 0; i < b_len; i++) {
-    arrput(result, other->items[i]);
-  }
+  if (a_len)
+    memcpy(result, a_items, a_len * sizeof(Value));
+  if (b_len)
+    memcpy(result + a_len, b_items, b_len * sizeof(Value));
 
   return list__init__(result);
 }
 
+// Compiler-emitted lowering of `xs = xs + ys` for locals the frontend
+// proved unaliased (accumulation_locals in scoping.py): extends xs's own
+// storage instead of rebuilding both lists, so accumulation loops run in
+// amortized O(n).
+Value list__append__(Value _self, Value _other) {
+  if (_self.type != VALUE_LIST || !_self.list || _other.type != VALUE_LIST ||
+      !_other.list)
+    return list__add__(_self, _other);
+
+  List *self = (List *)_self.list;
+  List *other = (List *)_other.list;
+  size_t other_len = _list_len(other);
+
+  if (other_len == 0)
+    return _self;
+
+  list_detach(self); // a live slice view may still alias our storage
+
+  if (self->packed && other->packed && self->unit == other->unit) {
+    size_t old_len = arrlen(self->packed);
+    arrsetlen(self->packed, old_len + other_len);
+    memcpy(self->packed + old_len, other->packed + _list_off(other),
+           other_len * sizeof(double));
+    return _self;
+  }
+
+  Value *other_items = list_items(other);
+  list_items(self);
+  size_t old_len = arrlen(self->items);
+  arrsetlen(self->items, old_len + other_len);
+  memcpy(self->items + old_len, other_items, other_len * sizeof(Value));
+
+  return _self;
+}
+
 static Value list__mul__(Value _self, Value _n) {
   List *self = (List *)_self.list;
   assert(_n.type == VALUE_NUMBER && _n.number.kind == NUM_INT64);
@@ -125,15 +442,23 @@ static Value list__mul__(Value _self, Value _n) {
 
   unsigned long long total = (unsigned long long)len * (unsigned long long)n;
   size_t reserve = (size_t)total;
-  Value *result = NULL;
-  arrsetcap(result, reserve);
 
-  for (ssize_t r = 0; r < n; r++) {
-    for (size_t i = 0; i < len; i++) {
-      arrput(result, self->items[i]);
-    }
+  if (self->packed) {
+    double *packed = NULL;
+    arrsetlen(packed, reserve);
+    for (ssize_t r = 0; r < n; r++)
+      memcpy(packed + (size_t)r * len, self->packed + _list_off(self),
+             len * sizeof(double));
+    return list_packed__init__(packed, self->unit);
   }
 
+  Value *result = NULL;
+  arrsetlen(result, reserve);
+
+  Value *items = list_items(self);
+  for (ssize_t r = 0; r < n; r++)
+    memcpy(result + (size_t)r * len, items, len * sizeof(Value));
+
   return list__init__(result);
 }
 
@@ -144,6 +469,15 @@ static Value list_append(Value *args) {
   Value val = args[1];
   if (_self.type == VALUE_LIST && _self.list) {
     List *self = (List *)_self.list;
+    list_detach(self);
+    if (self->packed) {
+      if (val.type == VALUE_NUMBER && val.number.kind == NUM_DOUBLE &&
+          val.number.unit == self->unit) {
+        arrput(self->packed, val.number.f64);
+        return NONE;
+      }
+      list_items(self); // heterogeneous append de-opts to boxed storage
+    }
     arrput(self->items, val);
   }
   return NONE;
@@ -161,10 +495,47 @@ static Value list_extend(Value *args) {
   List *other = (List *)_other.list;
   size_t other_len = _list_len(other);
 
-  for (size_t i = 0; i < other_len; i++) {
-    arrput(self->items, other->items[i]);
+  if (other_len == 0)
+    return NONE;
+
+  list_detach(self);
+
+  if (self->packed && other->packed && self->unit == other->unit) {
+    size_t old_len = arrlen(self->packed);
+    arrsetlen(self->packed, old_len + other_len);
+    memcpy(self->packed + old_len, other->packed + _list_off(other),
+           other_len * sizeof(double));
+    return NONE;
   }
 
+  Value *other_items = list_items(other);
+  list_items(self);
+  size_t old_len = arrlen(self->items);
+  arrsetlen(self->items, old_len + other_len);
+  memcpy(self->items + old_len, other_items, other_len * sizeof(Value));
+
+  return NONE;
+}
+
+static Value list_reserve(Value *args) {
+  Value _self = args[2];
+  Value _n = args[1];
+
+  if (_self.type != VALUE_LIST || !_self.list || _n.type != VALUE_NUMBER)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  long n = _n.number.i64;
+  if (n <= 0)
+    return NONE;
+
+  // Pre-sizes the backing array so subsequent appends skip the doubling
+  // reallocations; length and contents are unchanged.
+  list_detach(self);
+  if (self->packed)
+    arrsetcap(self->packed, (size_t)n);
+  else
+    arrsetcap(self->items, (size_t)n);
   return NONE;
 }
 
@@ -190,6 +561,25 @@ static Value list_insert(Value *args) {
   if (index > len)
     index = len;
 
+  // Front pushes reuse headroom left behind by earlier front pops: O(1)
+  // until the window reaches the start of the storage array.
+  if (index == 0 && !self->is_view && !self->shared && self->voff > 0) {
+    if (self->packed) {
+      if (val.type == VALUE_NUMBER && val.number.kind == NUM_DOUBLE &&
+          val.number.unit == self->unit) {
+        self->voff--;
+        self->packed[self->voff] = val.number.f64;
+        return NONE;
+      }
+    } else if (self->items) {
+      self->voff--;
+      self->items[self->voff] = val;
+      return NONE;
+    }
+  }
+
+  list_detach(self);
+  list_items(self);
   arrins(self->items, (int)index, val);
   return NONE;
 }
@@ -208,7 +598,18 @@ Value list__setitem__(Value _self, Value _index, Value val) {
   if (nidx < 0 || nidx >= len)
     return EMPTY;
 
-  self->items[nidx] = val;
+  list_detach(self);
+
+  if (self->packed) {
+    if (val.type == VALUE_NUMBER && val.number.kind == NUM_DOUBLE &&
+        val.number.unit == self->unit) {
+      self->packed[_list_off(self) + nidx] = val.number.f64;
+      return val;
+    }
+    list_items(self);
+  }
+
+  self->items[_list_off(self) + nidx] = val;
   return val;
 }
 
@@ -218,6 +619,7 @@ Value list__delitem__(Value _self, Value _index) {
 
   List *self = (List *)_self.list;
   assert(_index.type == VALUE_NUMBER);
+  _list_decolumnarize(self);
 
   ssize_t index = (ssize_t)_index.number.i64;
   ssize_t len = (ssize_t)_list_len(self);
@@ -226,7 +628,32 @@ Value list__delitem__(Value _self, Value _index) {
   if (nidx < 0 || nidx >= len)
     return EMPTY;
 
-  arrdel(self->items, (int)nidx);
+  // O(1) at the ends: front deletes advance the window, back deletes
+  // shrink it — no memmove, and no storage write, so views need no copy.
+  if (nidx == 0) {
+    self->voff++;
+    if (self->is_view)
+      self->vlen--;
+    return NONE;
+  }
+  if (nidx == len - 1) {
+    if (self->is_view)
+      self->vlen--;
+    else if (self->packed)
+      arrsetlen(self->packed, arrlen(self->packed) - 1);
+    else
+      arrsetlen(self->items, arrlen(self->items) - 1);
+    return NONE;
+  }
+
+  list_detach(self);
+
+  if (self->packed) {
+    arrdel(self->packed, (int)(_list_off(self) + nidx));
+    return NONE;
+  }
+
+  arrdel(self->items, (int)(_list_off(self) + nidx));
   return NONE;
 }
 
@@ -239,6 +666,7 @@ static Value list_pop(Value *args) {
     return EMPTY;
 
   List *self = (List *)_self.list;
+  _list_decolumnarize(self);
   ssize_t len = (ssize_t)_list_len(self);
   ssize_t idx;
 
@@ -253,11 +681,281 @@ static Value list_pop(Value *args) {
   if (nidx < 0 || nidx >= len)
     return EMPTY;
 
-  Value result = self->items[nidx];
-  arrdel(self->items, (int)nidx);
+  size_t off = _list_off(self);
+  Value result = self->packed
+                     ? num__init__(self->packed[off + nidx], self->unit)
+                     : self->items[off + nidx];
+
+  // Same end fast paths as list__delitem__: both ends pop in O(1).
+  if (nidx == 0) {
+    self->voff++;
+    if (self->is_view)
+      self->vlen--;
+    return result;
+  }
+  if (nidx == len - 1) {
+    if (self->is_view)
+      self->vlen--;
+    else if (self->packed)
+      arrsetlen(self->packed, arrlen(self->packed) - 1);
+    else
+      arrsetlen(self->items, arrlen(self->items) - 1);
+    return result;
+  }
+
+  list_detach(self);
+
+  if (self->packed) {
+    arrdel(self->packed, (int)(_list_off(self) + nidx));
+    return result;
+  }
+
+  arrdel(self->items, (int)(_list_off(self) + nidx));
   return result;
 }
 
+// Sorting
+//
+// Introsort core (median-of-three quicksort, insertion sort below
+// SORT_SMALL, heap sort at the depth limit) stamped out per element type so
+// the hot comparison is a raw i64/f64/memcmp instead of a method-table
+// dispatch. The generic and key-function variants fall back to __lt__.
+
+#define SORT_SMALL 24
+
+#define DEFINE_SORT(name, T, LESS)                                             \
+  static void name##_ins(T *a, size_t n) {                                     \
+    for (size_t i = 1; i < n; i++) {                                           \
+      T x = a[i];                                                              \
+      size_t j = i;                                                            \
+      for (; j > 0 && LESS(x, a[j - 1]); j--)                                  \
+        a[j] = a[j - 1];                                                       \
+      a[j] = x;                                                                \
+    }                                                                          \
+  }                                                                            \
+  static void name##_sift(T *a, size_t root, size_t n) {                       \
+    for (;;) {                                                                 \
+      size_t child = 2 * root + 1;                                             \
+      if (child >= n)                                                          \
+        return;                                                                \
+      if (child + 1 < n && LESS(a[child], a[child + 1]))                       \
+        child++;                                                               \
+      if (!LESS(a[root], a[child]))                                            \
+        return;                                                                \
+      T t = a[root];                                                           \
+      a[root] = a[child];                                                      \
+      a[child] = t;                                                            \
+      root = child;                                                            \
+    }                                                                          \
+  }                                                                            \
+  static void name##_heap(T *a, size_t n) {                                    \
+    for (size_t i = n / 2; i-- > 0;)                                           \
+      name##_sift(a, i, n);                                                    \
+    for (size_t i = n; i-- > 1;) {                                             \
+      T t = a[0];                                                              \
+      a[0] = a[i];                                                             \
+      a[i] = t;                                                                \
+      name##_sift(a, 0, i);                                                    \
+    }                                                                          \
+  }                                                                            \
+  static void name(T *a, size_t n, int depth) {                                \
+    while (n > SORT_SMALL) {                                                   \
+      if (depth-- == 0) {                                                      \
+        name##_heap(a, n);                                                     \
+        return;                                                                \
+      }                                                                        \
+      size_t mid = n / 2;                                                      \
+      T t;                                                                     \
+      if (LESS(a[mid], a[0])) {                                                \
+        t = a[0];                                                              \
+        a[0] = a[mid];                                                         \
+        a[mid] = t;                                                            \
+      }                                                                        \
+      if (LESS(a[n - 1], a[mid])) {                                            \
+        t = a[mid];                                                            \
+        a[mid] = a[n - 1];                                                     \
+        a[n - 1] = t;                                                          \
+        if (LESS(a[mid], a[0])) {                                              \
+          t = a[0];                                                            \
+          a[0] = a[mid];                                                       \
+          a[mid] = t;                                                          \
+        }                                                                      \
+      }                                                                        \
+      T pivot = a[mid];                                                        \
+      size_t i = 0, j = n - 1;                                                 \
+      for (;;) {                                                               \
+        do                                                                     \
+          i++;                                                                 \
+        while (LESS(a[i], pivot));                                             \
+        do                                                                     \
+          j--;                                                                 \
+        while (LESS(pivot, a[j]));                                             \
+        if (i >= j)                                                            \
+          break;                                                               \
+        t = a[i];                                                              \
+        a[i] = a[j];                                                           \
+        a[j] = t;                                                              \
+      }                                                                        \
+      j++;                                                                     \
+      if (j < n - j) {                                                         \
+        name(a, j, depth);                                                     \
+        a += j;                                                                \
+        n -= j;                                                                \
+      } else {                                                                 \
+        name(a + j, n - j, depth);                                             \
+        n = j;                                                                 \
+      }                                                                        \
+    }                                                                          \
+    name##_ins(a, n);                                                          \
+  }
+
+static inline bool _sds_less(const sds a, const sds b) {
+  size_t la = sdslen(a), lb = sdslen(b);
+  size_t m = la < lb ? la : lb;
+  int c = memcmp(a, b, m);
+  return c < 0 || (c == 0 && la < lb);
+}
+
+#define _LESS_F64(x, y) ((x) < (y))
+#define _LESS_VI64(x, y) ((x).number.i64 < (y).number.i64)
+#define _LESS_VNUM(x, y) (_f64(x) < _f64(y))
+#define _LESS_VSTR(x, y) _sds_less((x).str, (y).str)
+#define _LESS_VGEN(x, y) (__lt__((x), (y)).boolean)
+
+DEFINE_SORT(_sort_f64, double, _LESS_F64)
+DEFINE_SORT(_sort_vi64, Value, _LESS_VI64)
+DEFINE_SORT(_sort_vnum, Value, _LESS_VNUM)
+DEFINE_SORT(_sort_vstr, Value, _LESS_VSTR)
+DEFINE_SORT(_sort_vgen, Value, _LESS_VGEN)
+
+typedef struct {
+  Value key;
+  Value val;
+} SortPair;
+
+#define _LESS_PAIR(x, y) (__lt__((x).key, (y).key).boolean)
+DEFINE_SORT(_sort_pair, SortPair, _LESS_PAIR)
+
+static inline int _sort_depth(size_t n) {
+  return 2 * (64 - __builtin_clzll((unsigned long long)n));
+}
+
+static Value list_sort(Value *args) {
+  Value _self = args[2];
+  bool reverse = args[1].type == VALUE_BOOL && args[1].boolean;
+
+  if (_self.type != VALUE_LIST || !_self.list)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+  if (len < 2)
+    return NONE;
+
+  list_detach(self);
+  int depth = _sort_depth(len);
+
+  if (self->packed) {
+    double *a = self->packed + self->voff;
+    _sort_f64(a, len, depth);
+    if (reverse) {
+      for (size_t i = 0, j = len - 1; i < j; i++, j--) {
+        double t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+      }
+    }
+    return NONE;
+  }
+
+  Value *a = self->items + self->voff;
+
+  // One classification pass picks the monomorphized inner loop.
+  bool nums = a[0].type == VALUE_NUMBER;
+  bool ints = nums && a[0].number.kind == NUM_INT64;
+  bool strs = a[0].type == VALUE_STR;
+  uint64_t unit = nums ? a[0].number.unit : 0;
+  for (size_t i = 1; i < len && (nums || strs); i++) {
+    if (a[i].type == VALUE_NUMBER) {
+      strs = false;
+      if (a[i].number.unit != unit)
+        nums = false;
+      if (a[i].number.kind != NUM_INT64)
+        ints = false;
+    } else {
+      nums = false;
+      if (a[i].type != VALUE_STR)
+        strs = false;
+    }
+  }
+
+  if (nums && ints)
+    _sort_vi64(a, len, depth);
+  else if (nums)
+    _sort_vnum(a, len, depth);
+  else if (strs)
+    _sort_vstr(a, len, depth);
+  else
+    _sort_vgen(a, len, depth);
+
+  if (reverse) {
+    for (size_t i = 0, j = len - 1; i < j; i++, j--) {
+      Value t = a[i];
+      a[i] = a[j];
+      a[j] = t;
+    }
+  }
+  return NONE;
+}
+
+static Value list_sortby(Value *args) {
+  Value key = args[1];
+  bool reverse = args[2].type == VALUE_BOOL && args[2].boolean;
+  Value _self = args[3];
+
+  if (_self.type != VALUE_LIST || !_self.list ||
+      (key.type != VALUE_CLOSURE && key.type != VALUE_EXTERN_FN))
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+  if (len < 2)
+    return NONE;
+
+  list_detach(self);
+  Value *items = list_items(self);
+
+  // Decorate-sort-undecorate: the key function runs once per element.
+  SortPair *pairs = NULL;
+  arrsetlen(pairs, len);
+  for (size_t i = 0; i < len; i++) {
+    Value kargs[3] = {key, items[i], EMPTY};
+    pairs[i].key = __call__(key, kargs, 1);
+    pairs[i].val = items[i];
+  }
+
+  _sort_pair(pairs, len, _sort_depth(len));
+
+  for (size_t i = 0; i < len; i++)
+    items[i] = pairs[reverse ? len - 1 - i : i].val;
+
+  return NONE;
+}
+
+// Deque entry points: with the head-offset window above, a plain List
+// already pops in O(1) at both ends, so these are thin aliases that keep
+// queue code readable (and front pushes hit the headroom fast path).
+
+static Value list_popleft(Value *args) {
+  Value pop_args[3] = {args[0], int__init__(0, U_ONE), args[1]};
+  return list_pop(pop_args);
+}
+
+static Value list_pushleft(Value *args) {
+  Value ins_args[4] = {args[0], int__init__(0, U_ONE), args[1], args[2]};
+  return list_insert(ins_args);
+}
+
 // Comparison
 
 static Value list__eq__(Value a, Value b) {
@@ -273,9 +971,11 @@ static Value list__eq__(Value a, Value b) {
   if (len != _list_len(bl))
     return VFALSE;
 
+  Value *a_items = list_items(al);
+  Value *b_items = list_items(bl);
   for (size_t i = 0; i < len; i++) {
-    Value val_a = al->items[i];
-    Value val_b = bl->items[i];
+    Value val_a = a_items[i];
+    Value val_b = b_items[i];
 
     Value eq_result = __eq__(val_a, val_b);
     if (!eq_result.boolean)
@@ -306,7 +1006,7 @@ static Value list__ge__(Value self, Value other) {
 }
 
 static Value list_contains(Value *args) {
-  Value *self = args[2].list->items;
+  Value *self = list_items(args[2].list);
   Value target = args[1];
 
   for (unsigned int i = 0; i < arrlen(self); i++) {
@@ -321,17 +1021,491 @@ static Value list_contains(Value *args) {
   return VFALSE;
 }
 
+// Elementwise kernels
+//
+// List.ewadd/ewsub/ewmul/ewdiv and the scalar broadcasts List.scale and
+// List.offset. Packed operands run over the raw f64 payloads with one SIMD
+// kernel per op (same tiering as the group probes in units.h: AVX, NEON,
+// scalar); anything boxed falls back to per-element method dispatch.
+
+typedef enum { EW_ADD, EW_SUB, EW_MUL, EW_DIV } EwOp;
+
+#if defined(__AVX__)
+#define EW_KERNEL(name, vintrin, op)                                           \
+  static void name(double *restrict out, const double *restrict a,             \
+                   const double *restrict b, size_t n) {                       \
+    size_t i = 0;                                                              \
+    for (; i + 4 <= n; i += 4)                                                 \
+      _mm256_storeu_pd(out + i,                                                \
+                       vintrin(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i))); \
+    for (; i < n; i++)                                                         \
+      out[i] = a[i] op b[i];                                                   \
+  }
+#define EW_BROADCAST(name, vintrin, op)                                        \
+  static void name(double *restrict out, const double *restrict a, double s,   \
+                   size_t n) {                                                 \
+    __m256d vs = _mm256_set1_pd(s);                                            \
+    size_t i = 0;                                                              \
+    for (; i + 4 <= n; i += 4)                                                 \
+      _mm256_storeu_pd(out + i, vintrin(_mm256_loadu_pd(a + i), vs));          \
+    for (; i < n; i++)                                                         \
+      out[i] = a[i] op s;                                                      \
+  }
+EW_KERNEL(_ew_add, _mm256_add_pd, +)
+EW_KERNEL(_ew_sub, _mm256_sub_pd, -)
+EW_KERNEL(_ew_mul, _mm256_mul_pd, *)
+EW_KERNEL(_ew_div, _mm256_div_pd, /)
+EW_BROADCAST(_ew_bmul, _mm256_mul_pd, *)
+EW_BROADCAST(_ew_badd, _mm256_add_pd, +)
+static double _ew_dot(const double *restrict a, const double *restrict b,
+                      size_t n) {
+  __m256d acc = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    acc = _mm256_add_pd(
+        acc, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  double lanes[4];
+  _mm256_storeu_pd(lanes, acc);
+  double s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  for (; i < n; i++)
+    s += a[i] * b[i];
+  return s;
+}
+#elif defined(__aarch64__)
+#define EW_KERNEL(name, vintrin, op)                                           \
+  static void name(double *restrict out, const double *restrict a,             \
+                   const double *restrict b, size_t n) {                       \
+    size_t i = 0;                                                              \
+    for (; i + 2 <= n; i += 2)                                                 \
+      vst1q_f64(out + i, vintrin(vld1q_f64(a + i), vld1q_f64(b + i)));         \
+    for (; i < n; i++)                                                         \
+      out[i] = a[i] op b[i];                                                   \
+  }
+#define EW_BROADCAST(name, vintrin, op)                                        \
+  static void name(double *restrict out, const double *restrict a, double s,   \
+                   size_t n) {                                                 \
+    float64x2_t vs = vdupq_n_f64(s);                                           \
+    size_t i = 0;                                                              \
+    for (; i + 2 <= n; i += 2)                                                 \
+      vst1q_f64(out + i, vintrin(vld1q_f64(a + i), vs));                       \
+    for (; i < n; i++)                                                         \
+      out[i] = a[i] op s;                                                      \
+  }
+EW_KERNEL(_ew_add, vaddq_f64, +)
+EW_KERNEL(_ew_sub, vsubq_f64, -)
+EW_KERNEL(_ew_mul, vmulq_f64, *)
+EW_KERNEL(_ew_div, vdivq_f64, /)
+EW_BROADCAST(_ew_bmul, vmulq_f64, *)
+EW_BROADCAST(_ew_badd, vaddq_f64, +)
+static double _ew_dot(const double *restrict a, const double *restrict b,
+                      size_t n) {
+  float64x2_t acc = vdupq_n_f64(0.0);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+    acc = vfmaq_f64(acc, vld1q_f64(a + i), vld1q_f64(b + i));
+  double s = vaddvq_f64(acc);
+  for (; i < n; i++)
+    s += a[i] * b[i];
+  return s;
+}
+#else
+#define EW_KERNEL(name, vintrin, op)                                           \
+  static void name(double *restrict out, const double *restrict a,             \
+                   const double *restrict b, size_t n) {                       \
+    for (size_t i = 0; i < n; i++)                                             \
+      out[i] = a[i] op b[i];                                                   \
+  }
+#define EW_BROADCAST(name, vintrin, op)                                        \
+  static void name(double *restrict out, const double *restrict a, double s,   \
+                   size_t n) {                                                 \
+    for (size_t i = 0; i < n; i++)                                             \
+      out[i] = a[i] op s;                                                      \
+  }
+EW_KERNEL(_ew_add, _, +)
+EW_KERNEL(_ew_sub, _, -)
+EW_KERNEL(_ew_mul, _, *)
+EW_KERNEL(_ew_div, _, /)
+EW_BROADCAST(_ew_bmul, _, *)
+EW_BROADCAST(_ew_badd, _, +)
+static double _ew_dot(const double *restrict a, const double *restrict b,
+                      size_t n) {
+  double s = 0.0;
+  for (size_t i = 0; i < n; i++)
+    s += a[i] * b[i];
+  return s;
+}
+#endif
+
+static double *_ew_out(size_t len) {
+  double *out = NULL;
+  arrsetlen(out, len);
+  return out;
+}
+
+static Value list_ewise(Value _a, Value _b, EwOp op) {
+  if (_a.type != VALUE_LIST || !_a.list || _b.type != VALUE_LIST || !_b.list)
+    return EMPTY;
+
+  List *a = (List *)_a.list;
+  List *b = (List *)_b.list;
+  size_t len = _list_len(a);
+
+  if (len != _list_len(b))
+    u_throw(905, NULL, NULL);
+
+  bool same_unit = a->unit == b->unit;
+  if (a->packed && b->packed &&
+      (same_unit || op == EW_MUL || op == EW_DIV)) {
+    uint64_t unit = a->unit;
+    if (op == EW_MUL || op == EW_DIV)
+      unit = unit_mul(unit_get(a->unit), unit_get(b->unit), op == EW_DIV);
+
+    const double *pa = a->packed + _list_off(a);
+    const double *pb = b->packed + _list_off(b);
+
+    if (op == EW_DIV) {
+      for (size_t i = 0; i < len; i++)
+        if (pb[i] == 0)
+          u_throw(305, NULL, NULL);
+    }
+
+    double *out = _ew_out(len);
+    switch (op) {
+    case EW_ADD:
+      _ew_add(out, pa, pb, len);
+      break;
+    case EW_SUB:
+      _ew_sub(out, pa, pb, len);
+      break;
+    case EW_MUL:
+      _ew_mul(out, pa, pb, len);
+      break;
+    case EW_DIV:
+      _ew_div(out, pa, pb, len);
+      break;
+    }
+    return list_packed__init__(out, unit);
+  }
+
+  // Boxed (or mixed-unit) fallback: per-element dispatch keeps unit
+  // conversion and error reporting identical to the scalar operators.
+  Value *a_items = list_items(a);
+  Value *b_items = list_items(b);
+  Value *result = NULL;
+  arrsetcap(result, len);
+  for (size_t i = 0; i < len; i++) {
+    Value r;
+    switch (op) {
+    case EW_ADD:
+      r = __add__(a_items[i], b_items[i]);
+      break;
+    case EW_SUB:
+      r = __sub__(a_items[i], b_items[i]);
+      break;
+    case EW_MUL:
+      r = __mul__(a_items[i], b_items[i]);
+      break;
+    default:
+      r = __div__(a_items[i], b_items[i], NULL);
+      break;
+    }
+    arrput(result, r);
+  }
+  return list__init__(result);
+}
+
+static Value list_ewadd(Value *args) {
+  return list_ewise(args[2], args[1], EW_ADD);
+}
+static Value list_ewsub(Value *args) {
+  return list_ewise(args[2], args[1], EW_SUB);
+}
+static Value list_ewmul(Value *args) {
+  return list_ewise(args[2], args[1], EW_MUL);
+}
+static Value list_ewdiv(Value *args) {
+  return list_ewise(args[2], args[1], EW_DIV);
+}
+
+static Value list_scale(Value *args) {
+  Value _self = args[2];
+  Value factor = args[1];
+  if (_self.type != VALUE_LIST || !_self.list || factor.type != VALUE_NUMBER)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+
+  if (self->packed) {
+    uint64_t unit = unit_mul(unit_get(self->unit),
+                             unit_get(factor.number.unit), false);
+    double *out = _ew_out(len);
+    _ew_bmul(out, self->packed + _list_off(self), _f64(factor), len);
+    return list_packed__init__(out, unit);
+  }
+
+  Value *items = list_items(self);
+  Value *result = NULL;
+  arrsetcap(result, len);
+  for (size_t i = 0; i < len; i++)
+    arrput(result, __mul__(items[i], factor));
+  return list__init__(result);
+}
+
+static Value list_offset(Value *args) {
+  Value _self = args[2];
+  Value delta = args[1];
+  if (_self.type != VALUE_LIST || !_self.list || delta.type != VALUE_NUMBER)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+
+  if (self->packed && delta.number.unit == self->unit) {
+    double *out = _ew_out(len);
+    _ew_badd(out, self->packed + _list_off(self), _f64(delta), len);
+    return list_packed__init__(out, self->unit);
+  }
+
+  Value *items = list_items(self);
+  Value *result = NULL;
+  arrsetcap(result, len);
+  for (size_t i = 0; i < len; i++)
+    arrput(result, __add__(items[i], delta));
+  return list__init__(result);
+}
+
+// Fused reductions
+//
+// List.sum/mean/min/max/dot collapse a numeric list in one pass. The
+// packed flag doubles as the homogeneity proof, so the fast paths check
+// it once and then run over the raw f64 payloads — sums are
+// Neumaier-compensated, dot uses the same SIMD tiering as the
+// elementwise kernels — with the unit bookkeeping done a single time on
+// the result instead of per element. Boxed lists fall back to
+// per-element dispatch, which keeps Int sums exact.
+
+/* Neumaier-compensated: the correction term recovers the low-order bits
+ * lost when the running total dwarfs (or is dwarfed by) the addend. */
+static double _red_sum(const double *a, size_t n) {
+  double s = 0.0, c = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    double t = s + a[i];
+    if (fabs(s) >= fabs(a[i]))
+      c += (s - t) + a[i];
+    else
+      c += (a[i] - t) + s;
+    s = t;
+  }
+  return s + c;
+}
+
+static Value list_sum(Value *args) {
+  Value _self = args[1];
+  if (_self.type != VALUE_LIST || !_self.list)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+  if (len == 0)
+    return int__init__(0, NUMEROBIS_UNIT_ONE_HASH);
+
+  if (self->packed)
+    return num__init__(_red_sum(self->packed + _list_off(self), len),
+                       self->unit);
+
+  Value *items = list_items(self);
+  Value acc = items[0];
+  for (size_t i = 1; i < len; i++)
+    acc = __add__(acc, items[i]);
+  return acc;
+}
+
+static Value list_mean(Value *args) {
+  Value _self = args[1];
+  if (_self.type != VALUE_LIST || !_self.list)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+  if (len == 0)
+    u_throw(915, NULL, NULL);
+
+  if (self->packed)
+    return num__init__(_red_sum(self->packed + _list_off(self), len) / len,
+                       self->unit);
+
+  Value *items = list_items(self);
+  Value acc = items[0];
+  for (size_t i = 1; i < len; i++)
+    acc = __add__(acc, items[i]);
+  return __div__(acc, int__init__((long)len, NUMEROBIS_UNIT_ONE_HASH), NULL);
+}
+
+static Value list_extreme(Value *args, bool want_max) {
+  Value _self = args[1];
+  if (_self.type != VALUE_LIST || !_self.list)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+  if (len == 0) {
+    u_throw(915, NULL, NULL);
+    return EMPTY;
+  }
+
+  if (self->packed) {
+    const double *p = self->packed + _list_off(self);
+    double m = p[0];
+    for (size_t i = 1; i < len; i++)
+      if (want_max ? p[i] > m : p[i] < m)
+        m = p[i];
+    return num__init__(m, self->unit);
+  }
+
+  Value *items = list_items(self);
+  Value acc = items[0];
+  for (size_t i = 1; i < len; i++)
+    if ((want_max ? __gt__(items[i], acc) : __lt__(items[i], acc)).boolean)
+      acc = items[i];
+  return acc;
+}
+
+static Value list_min(Value *args) { return list_extreme(args, false); }
+static Value list_max(Value *args) { return list_extreme(args, true); }
+
+static Value list_dot(Value *args) {
+  Value _a = args[2];
+  Value _b = args[1];
+  if (_a.type != VALUE_LIST || !_a.list || _b.type != VALUE_LIST || !_b.list)
+    return EMPTY;
+
+  List *a = (List *)_a.list;
+  List *b = (List *)_b.list;
+  size_t len = _list_len(a);
+  if (len != _list_len(b))
+    u_throw(905, NULL, NULL);
+
+  if (a->packed && b->packed) {
+    uint64_t unit = unit_mul(unit_get(a->unit), unit_get(b->unit), false);
+    return num__init__(
+        _ew_dot(a->packed + _list_off(a), b->packed + _list_off(b), len),
+        unit);
+  }
+
+  Value *a_items = list_items(a);
+  Value *b_items = list_items(b);
+  Value acc = int__init__(0, NUMEROBIS_UNIT_ONE_HASH);
+  for (size_t i = 0; i < len; i++) {
+    Value prod = __mul__(a_items[i], b_items[i]);
+    acc = i == 0 ? prod : __add__(acc, prod);
+  }
+  return acc;
+}
+
+// Columnar bulk access
+//
+// List.column/List.setcolumn read or replace one field across every
+// element. On columnar lists these touch a single contiguous array; on
+// array-of-structs they gather/scatter, with setcolumn writing through
+// the shared struct pointers so outside references observe the update.
+
+static ssize_t _struct_field_index(long id, const char *name) {
+  const StructInfo *meta = &STRUCT_REGISTRY[id];
+  for (size_t f = 0; f < meta->fieldc; f++)
+    if (strcmp(meta->field_names[f], name) == 0)
+      return (ssize_t)f;
+  return -1;
+}
+
+static Value list_column(Value *args) {
+  Value _self = args[2];
+  Value field = args[1];
+  if (_self.type != VALUE_LIST || !_self.list || field.type != VALUE_STR)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  size_t len = _list_len(self);
+  if (len == 0)
+    return list__init__(NULL);
+
+  if (self->cols) {
+    ssize_t f = _struct_field_index(self->cstruct, field.str);
+    if (f < 0)
+      u_throw(908, NULL, NULL);
+    // list_of re-packs uniform numeric columns, so column reads of f64
+    // fields feed straight into the elementwise kernels.
+    return list_of(self->cols[f], len);
+  }
+
+  Value *items = list_items(self);
+  if (items[0].type != VALUE_STRUCT)
+    return EMPTY;
+
+  ssize_t f = _struct_field_index(items[0].strukt[0].number.i64, field.str);
+  if (f < 0)
+    u_throw(908, NULL, NULL);
+
+  Value *gathered = NULL;
+  arrsetlen(gathered, len);
+  for (size_t i = 0; i < len; i++)
+    gathered[i] = items[i].strukt[f + 1];
+  Value result = list_of(gathered, len);
+  return result;
+}
+
+static Value list_setcolumn(Value *args) {
+  Value _self = args[3];
+  Value field = args[1];
+  Value _values = args[2];
+  if (_self.type != VALUE_LIST || !_self.list || field.type != VALUE_STR ||
+      _values.type != VALUE_LIST || !_values.list)
+    return EMPTY;
+
+  List *self = (List *)_self.list;
+  List *values = (List *)_values.list;
+  size_t len = _list_len(self);
+
+  if (len != _list_len(values))
+    u_throw(905, NULL, NULL);
+  if (len == 0)
+    return NONE;
+
+  Value *vsrc = list_items(values);
+
+  if (self->cols) {
+    ssize_t f = _struct_field_index(self->cstruct, field.str);
+    if (f < 0)
+      u_throw(908, NULL, NULL);
+    memcpy(self->cols[f], vsrc, len * sizeof(Value));
+    return NONE;
+  }
+
+  Value *items = list_items(self);
+  if (items[0].type != VALUE_STRUCT)
+    return EMPTY;
+
+  ssize_t f = _struct_field_index(items[0].strukt[0].number.i64, field.str);
+  if (f < 0)
+    u_throw(908, NULL, NULL);
+
+  for (size_t i = 0; i < len; i++)
+    items[i].strukt[f + 1] = vsrc[i];
+  return NONE;
+}
+
 // serialization
 static Value list__str__(Value self) {
   sds result = sdsnew("[");
   List *arr = (List *)self.list;
   size_t len = _list_len(arr);
+  Value *items = list_items(arr);
 
   for (size_t i = 0; i < len; i++) {
     if (i > 0)
       result = sdscat(result, ", ");
 
-    Value elem = arr->items[i];
+    Value elem = items[i];
     if (elem.type == VALUE_STR) {
       result = sdscatprintf(result, "\"%s\"", elem.str);
     } else {
@@ -366,6 +1540,24 @@ void numerobis_list_register_externs(void) {
   u_extern_register("List.append", list_append);
   u_extern_register("List.extend", list_extend);
   u_extern_register("List.insert", list_insert);
+  u_extern_register("List.reserve", list_reserve);
   u_extern_register("List.pop", list_pop);
+  u_extern_register("List.popleft", list_popleft);
+  u_extern_register("List.pushleft", list_pushleft);
   u_extern_register("List.contains", list_contains);
+  u_extern_register("List.sort", list_sort);
+  u_extern_register("List.sortby", list_sortby);
+  u_extern_register("List.ewadd", list_ewadd);
+  u_extern_register("List.ewsub", list_ewsub);
+  u_extern_register("List.ewmul", list_ewmul);
+  u_extern_register("List.ewdiv", list_ewdiv);
+  u_extern_register("List.scale", list_scale);
+  u_extern_register("List.offset", list_offset);
+  u_extern_register("List.sum", list_sum);
+  u_extern_register("List.mean", list_mean);
+  u_extern_register("List.min", list_min);
+  u_extern_register("List.max", list_max);
+  u_extern_register("List.dot", list_dot);
+  u_extern_register("List.column", list_column);
+  u_extern_register("List.setcolumn", list_setcolumn);
 }
@@ -15,15 +15,63 @@ Value list__init__(Value *items);
 
 Value list_of(const Value *items, size_t len);
 
+/* Wraps an unboxed f64 payload array (stb_ds) sharing one unit hash. */
+Value list_packed__init__(double *packed, uint64_t unit);
+
+/* Wraps prebuilt per-field columns (one stb_ds Value array per field of
+ * the STRUCT_REGISTRY entry `cstruct`) in columnar storage. */
+Value list_cols__init__(Value **cols, long cstruct);
+
+/* Returns the boxed element array, materializing it first if the list is in
+ * packed numeric storage or a slice view. Use this instead of reading
+ * ->items directly. */
+Value *list_items(List *self);
+
+/* Copy-on-write boundary: makes the list own its storage, materializing a
+ * slice view or cloning an array that a view still aliases. Mutators must
+ * call this before writing to ->items/->packed. */
+void list_detach(List *self);
+
+/* In-place concatenation for `xs = xs + ys` reassignments the compiler
+ * proved unaliased: extends xs's storage and returns it, falling back to
+ * the copying __add__ otherwise. */
+Value list__append__(Value self, Value other);
+
 static inline size_t _list_len(const List *self) {
-  return (self && self->items) ? arrlen(self->items) : 0;
+  if (!self)
+    return 0;
+  if (self->is_view)
+    return self->vlen;
+  if (self->cols)
+    return arrlen(self->cols[0]);
+  size_t n = self->packed  ? arrlen(self->packed)
+             : self->items ? arrlen(self->items)
+                           : 0;
+  return n - self->voff;
 }
 
+/* Element offset into the (possibly aliased) storage array. */
+static inline size_t _list_off(const List *self) { return self->voff; }
+
 static inline Value list_len(Value self) {
   long len = (long)_list_len(self.list);
   return int__init__(len, U_ONE);
 }
 
+/* Unchecked indexed load for indices the compiler proved in range and
+ * non-negative (bounds-check elision in compiler.py): no
+ * normalize_index, no EMPTY-throw branch. Columnar storage still goes
+ * through the generic path, which materializes rows first. */
+static inline Value list_get_fast(Value self, long i) {
+  List *l = self.list;
+  if (__builtin_expect(l->cols != NULL, 0))
+    return __getitem__(self, int__init__(i, U_ONE), NULL);
+  size_t off = _list_off(l);
+  if (l->packed)
+    return num__init__(l->packed[off + i], l->unit);
+  return l->items[off + i];
+}
+
 void list_methods_init(void);
 
 void numerobis_list_register_externs(void);
@@ -0,0 +1,366 @@
+#include "map.h"
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/gc_stb_ds.h"
+#include "../libs/sds.h"
+#include "../values.h"
+#include "bool.h"
+#include "list.h"
+#include "methods.h"
+#include "number.h"
+#include "str.h"
+
+#include <gc/gc.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static const ValueMethods _map_methods;
+
+#define MAP_INIT_CAP 16
+#define MAP_LOAD_NUM 3
+#define MAP_LOAD_DEN 4
+
+enum { MAP_SLOT_EMPTY = 0, MAP_SLOT_FULL = 1, MAP_SLOT_TOMB = 2 };
+
+// Key specialization: while every stored key is an integer (or a string),
+// probe comparisons are raw i64/memcmp; the first differently-shaped key
+// demotes the map to generic __eq__ comparisons.
+enum { MAP_KEYS_NONE = 0, MAP_KEYS_INT, MAP_KEYS_STR, MAP_KEYS_MIXED };
+
+Value map__init__(void) {
+  Value v;
+  v.type = VALUE_MAP;
+
+  Map *obj = GC_MALLOC(sizeof(Map));
+  obj->slots = GC_MALLOC(MAP_INIT_CAP * sizeof(MapSlot));
+  obj->state = GC_MALLOC(MAP_INIT_CAP); // GC_MALLOC zeroes: all empty
+  obj->cap = MAP_INIT_CAP;
+  obj->used = obj->fill = 0;
+  obj->key_kind = MAP_KEYS_NONE;
+
+  v.map = obj;
+  return v;
+}
+
+static inline uint64_t _splitmix(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static uint64_t _map_hash(Value key) {
+  switch (key.type) {
+  case VALUE_NUMBER: {
+    // Integral doubles hash like the equal integer, matching __eq__.
+    long bits;
+    if (key.number.kind == NUM_INT64) {
+      bits = key.number.i64;
+    } else {
+      double d = key.number.f64;
+      if (d == (double)(long)d)
+        bits = (long)d;
+      else
+        memcpy(&bits, &d, sizeof(bits));
+    }
+    return _splitmix((uint64_t)bits ^ (uint64_t)key.number.unit);
+  }
+  case VALUE_BOOL:
+    return _splitmix(key.boolean ? 1 : 2);
+  case VALUE_STR:
+    // FNV-1a over the string payload, cached inside the sds header so
+    // repeated lookups with the same key hash once.
+    return sdshash(key.str);
+  case VALUE_NONE:
+    return _splitmix(0);
+  default:
+    u_throw(907, NULL, NULL);
+    return 0;
+  }
+}
+
+static inline int _map_key_shape(Value key) {
+  if (key.type == VALUE_NUMBER && key.number.kind == NUM_INT64)
+    return MAP_KEYS_INT;
+  if (key.type == VALUE_STR)
+    return MAP_KEYS_STR;
+  return MAP_KEYS_MIXED;
+}
+
+static inline bool _map_key_eq(int kind, Value a, Value b) {
+  switch (kind) {
+  case MAP_KEYS_INT:
+    return a.number.i64 == b.number.i64 && a.number.unit == b.number.unit;
+  case MAP_KEYS_STR: {
+    size_t la = sdslen(a.str), lb = sdslen(b.str);
+    return la == lb && memcmp(a.str, b.str, la) == 0;
+  }
+  default:
+    // __eq__ dispatches through NUMEROBIS_METHODS, which has no entry
+    // for NONE; two None keys are always equal, and a None never equals
+    // a key of any other type.
+    if (a.type == VALUE_NONE || b.type == VALUE_NONE)
+      return a.type == b.type;
+    return __eq__(a, b).boolean;
+  }
+}
+
+// Comparison kind for probing with this key: the specialized path is only
+// valid when both the table and the probe key have the same shape.
+static inline int _map_cmp_kind(const Map *m, Value key) {
+  int shape = _map_key_shape(key);
+  return (shape == m->key_kind) ? shape : MAP_KEYS_MIXED;
+}
+
+static MapSlot *_map_find(const Map *m, Value key, uint64_t h) {
+  int kind = _map_cmp_kind(m, key);
+  uint32_t mask = m->cap - 1;
+  uint32_t i = (uint32_t)h & mask;
+
+  for (;;) {
+    if (m->state[i] == MAP_SLOT_EMPTY)
+      return NULL;
+    if (m->state[i] == MAP_SLOT_FULL && m->slots[i].hash == h &&
+        _map_key_eq(kind, m->slots[i].key, key))
+      return &m->slots[i];
+    i = (i + 1) & mask;
+  }
+}
+
+static void _map_insert_raw(Map *m, uint64_t h, Value key, Value val) {
+  uint32_t mask = m->cap - 1;
+  uint32_t i = (uint32_t)h & mask;
+  int kind = _map_cmp_kind(m, key);
+  int32_t tomb = -1;
+
+  for (;;) {
+    if (m->state[i] == MAP_SLOT_EMPTY) {
+      if (tomb >= 0)
+        i = (uint32_t)tomb;
+      else
+        m->fill++;
+      m->state[i] = MAP_SLOT_FULL;
+      m->slots[i].hash = h;
+      m->slots[i].key = key;
+      m->slots[i].val = val;
+      m->used++;
+      return;
+    }
+    if (m->state[i] == MAP_SLOT_TOMB) {
+      if (tomb < 0)
+        tomb = (int32_t)i;
+    } else if (m->slots[i].hash == h && _map_key_eq(kind, m->slots[i].key, key)) {
+      m->slots[i].val = val;
+      return;
+    }
+    i = (i + 1) & mask;
+  }
+}
+
+static void _map_rehash(Map *m, uint32_t new_cap) {
+  MapSlot *old_slots = m->slots;
+  uint8_t *old_state = m->state;
+  uint32_t old_cap = m->cap;
+
+  m->slots = GC_MALLOC(new_cap * sizeof(MapSlot));
+  m->state = GC_MALLOC(new_cap);
+  m->cap = new_cap;
+  m->used = m->fill = 0;
+
+  for (uint32_t i = 0; i < old_cap; i++) {
+    if (old_state[i] == MAP_SLOT_FULL)
+      _map_insert_raw(m, old_slots[i].hash, old_slots[i].key, old_slots[i].val);
+  }
+}
+
+static void _map_set(Map *m, Value key, Value val) {
+  if (m->fill * MAP_LOAD_DEN >= m->cap * MAP_LOAD_NUM) {
+    // Grow when genuinely full; rehash in place when tombstones are the
+    // bulk of the fill.
+    _map_rehash(m, m->used * 2 >= m->cap ? m->cap * 2 : m->cap);
+  }
+
+  int shape = _map_key_shape(key);
+  if (m->key_kind == MAP_KEYS_NONE)
+    m->key_kind = (uint8_t)shape;
+  else if (m->key_kind != shape)
+    m->key_kind = MAP_KEYS_MIXED;
+
+  _map_insert_raw(m, _map_hash(key), key, val);
+}
+
+static bool _map_del(Map *m, Value key) {
+  MapSlot *slot = _map_find(m, key, _map_hash(key));
+  if (!slot)
+    return false;
+  uint32_t i = (uint32_t)(slot - m->slots);
+  m->state[i] = MAP_SLOT_TOMB;
+  m->slots[i].key = NONE;
+  m->slots[i].val = NONE;
+  m->used--;
+  return true;
+}
+
+// Methods
+
+static Value map__bool__(Value self) {
+  return bool__init__(self.map->used > 0);
+}
+
+static bool map__cbool__(Value self) { return self.map->used > 0; }
+
+static Value map__getitem__(Value _self, Value _key) {
+  Map *self = _self.map;
+  MapSlot *slot = _map_find(self, _key, _map_hash(_key));
+  if (!slot)
+    u_throw(906, NULL, NULL);
+  return slot->val;
+}
+
+static Value map__setitem__(Value _self, Value _key, Value val) {
+  _map_set(_self.map, _key, val);
+  return val;
+}
+
+static Value map__eq__(Value _self, Value _other) {
+  Map *self = _self.map;
+  Map *other = _other.map;
+
+  if (self == other)
+    return VTRUE;
+  if (self->used != other->used)
+    return VFALSE;
+
+  for (uint32_t i = 0; i < self->cap; i++) {
+    if (self->state[i] != MAP_SLOT_FULL)
+      continue;
+    MapSlot *slot = _map_find(other, self->slots[i].key, self->slots[i].hash);
+    if (!slot || !__eq__(self->slots[i].val, slot->val).boolean)
+      return VFALSE;
+  }
+  return VTRUE;
+}
+
+static Value map__str__(Value _self) {
+  Map *self = _self.map;
+  sds result = sdsnew("{");
+
+  bool first = true;
+  for (uint32_t i = 0; i < self->cap; i++) {
+    if (self->state[i] != MAP_SLOT_FULL)
+      continue;
+    if (!first)
+      result = sdscat(result, ", ");
+    first = false;
+
+    Value key = self->slots[i].key;
+    Value val = self->slots[i].val;
+
+    if (key.type == VALUE_STR)
+      result = sdscatprintf(result, "\"%s\"", key.str);
+    else
+      result = sdscat(result, __str__(key, NULL).str);
+    result = sdscat(result, ": ");
+
+    if (val.type == VALUE_STR)
+      result = sdscatprintf(result, "\"%s\"", val.str);
+    else
+      result = sdscat(result, __str__(val, NULL).str);
+  }
+  result = sdscat(result, "}");
+
+  return str__init__(result);
+}
+
+static const ValueMethods _map_methods = {
+    .__bool__ = map__bool__,
+    .__cbool__ = map__cbool__,
+    .__eq__ = map__eq__,
+    .__getitem__ = map__getitem__,
+    .__setitem__ = map__setitem__,
+    .__str__ = map__str__,
+};
+
+void map_methods_init(void) { NUMEROBIS_METHODS[VALUE_MAP] = &_map_methods; }
+
+// Externs
+
+static Value map_new(Value *args) { return map__init__(); }
+
+static Value map_len(Value *args) {
+  Value _self = args[1];
+  if (_self.type != VALUE_MAP)
+    return EMPTY;
+  return int__init__((long)_self.map->used, U_ONE);
+}
+
+static Value map_get(Value *args) {
+  Value key = args[1];
+  Value fallback = args[2];
+  Value _self = args[3];
+  if (_self.type != VALUE_MAP)
+    return EMPTY;
+
+  MapSlot *slot = _map_find(_self.map, key, _map_hash(key));
+  if (slot)
+    return slot->val;
+  return fallback.type == VALUE_EMPTY ? NONE : fallback;
+}
+
+static Value map_contains(Value *args) {
+  Value key = args[1];
+  Value _self = args[2];
+  if (_self.type != VALUE_MAP)
+    return EMPTY;
+  return bool__init__(_map_find(_self.map, key, _map_hash(key)) != NULL);
+}
+
+static Value map_remove(Value *args) {
+  Value key = args[1];
+  Value _self = args[2];
+  if (_self.type != VALUE_MAP)
+    return EMPTY;
+  return bool__init__(_map_del(_self.map, key));
+}
+
+static Value map_keys(Value *args) {
+  Value _self = args[1];
+  if (_self.type != VALUE_MAP)
+    return EMPTY;
+
+  Map *self = _self.map;
+  Value *result = NULL;
+  arrsetcap(result, self->used);
+  for (uint32_t i = 0; i < self->cap; i++) {
+    if (self->state[i] == MAP_SLOT_FULL)
+      arrput(result, self->slots[i].key);
+  }
+  return list__init__(result);
+}
+
+static Value map_values(Value *args) {
+  Value _self = args[1];
+  if (_self.type != VALUE_MAP)
+    return EMPTY;
+
+  Map *self = _self.map;
+  Value *result = NULL;
+  arrsetcap(result, self->used);
+  for (uint32_t i = 0; i < self->cap; i++) {
+    if (self->state[i] == MAP_SLOT_FULL)
+      arrput(result, self->slots[i].val);
+  }
+  return list__init__(result);
+}
+
+void numerobis_map_register_externs(void) {
+  u_extern_register("map", map_new);
+  u_extern_register("Map.len", map_len);
+  u_extern_register("Map.get", map_get);
+  u_extern_register("Map.contains", map_contains);
+  u_extern_register("Map.remove", map_remove);
+  u_extern_register("Map.keys", map_keys);
+  u_extern_register("Map.values", map_values);
+}
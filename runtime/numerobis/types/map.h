@@ -0,0 +1,34 @@
+#ifndef NUMEROBIS_MAP_H
+#define NUMEROBIS_MAP_H
+
+#include "../values.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  uint64_t hash;
+  Value key;
+  Value val;
+} MapSlot;
+
+/* Open-addressing hash table (linear probing with tombstones, power-of-two
+ * capacity), same family as the UMap in units/units.h but keyed by Values.
+ * key_kind tracks whether every stored key is an int or a string so probes
+ * can compare raw i64/memcmp instead of dispatching __eq__. */
+typedef struct Map {
+  MapSlot *slots;
+  uint8_t *state; /* 0 empty, 1 full, 2 tombstone */
+  uint32_t cap;   /* always a power of two */
+  uint32_t used;  /* live entries */
+  uint32_t fill;  /* live entries + tombstones */
+  uint8_t key_kind;
+} Map;
+
+Value map__init__(void);
+
+void map_methods_init(void);
+
+void numerobis_map_register_externs(void);
+
+#endif
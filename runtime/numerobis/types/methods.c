@@ -1,3 +1,3 @@
 #include "methods.h"
 
-const ValueMethods *NUMEROBIS_METHODS[8] = {0};
+const ValueMethods *NUMEROBIS_METHODS[13] = {0};
@@ -34,6 +34,6 @@ typedef struct {
   Value (*__num__)(Value self);
 } ValueMethods;
 
-extern const ValueMethods *NUMEROBIS_METHODS[8];
+extern const ValueMethods *NUMEROBIS_METHODS[13];
 
 #endif
@@ -91,7 +91,7 @@ static inline Value number__gt__(Value a, Value b) {
 static inline Value number__ge__(Value a, Value b) {
   return bool__init__(number_cmp(&a.number, &b.number) >= 0);
 }
-static inline Value number__eq__(Value a, Value b) {
+Value number__eq__(Value a, Value b) {
   return bool__init__(number_cmp(&a.number, &b.number) == 0);
 }
 
@@ -109,6 +109,30 @@ static Value number_binop(Value a, Value b, binop_i64 iop, binop_f64 fop,
   uint64_t uha = na->unit;
   uint64_t uhb = nb->unit;
 
+  // Fast path: both operands carry the interned dimensionless unit, so no
+  // unit bookkeeping (and no unit_get probe) is needed at all. Deep add/sub
+  // degenerate to plain add/sub without a unit to evaluate through.
+  if (__builtin_expect(UNIT_IS_ONE_HASH(uha) && UNIT_IS_ONE_HASH(uhb), 1)) {
+    if (kind == OP_INTDIV) {
+      long res;
+      if (na->kind == NUM_INT64 && nb->kind == NUM_INT64) {
+        long x = na->i64;
+        long y = nb->i64;
+        res = x / y;
+        if ((x % y != 0) && ((x < 0) != (y < 0)))
+          res--; /* Flooring instead of truncating */
+      } else {
+        res = (long)floor(number_as_double(na) / number_as_double(nb));
+      }
+      return int__init__(res, NUMEROBIS_UNIT_ONE_HASH);
+    }
+
+    if (na->kind == NUM_DOUBLE || nb->kind == NUM_DOUBLE || kind == OP_DIV)
+      return num__init__(fop(number_as_double(na), number_as_double(nb)),
+                         NUMEROBIS_UNIT_ONE_HASH);
+    return int__init__(iop(na->i64, nb->i64), NUMEROBIS_UNIT_ONE_HASH);
+  }
+
   const Unit *ua = unit_get(uha);
   const Unit *ub = unit_get(uhb);
 
@@ -190,10 +214,34 @@ static inline long i_sub(long a, long b) { return a - b; }
 static inline long i_mul(long a, long b) { return a * b; }
 static inline long i_div(long a, long b) { return a / b; }
 static inline long i_pow(long a, long b) {
-  return (long)pow((double)a, (double)b);
+  if (b < 0) {
+    // Fractional result truncates toward zero, matching the old
+    // (long)pow() behaviour. 0^negative is rejected in number__pow__.
+    if (a == 1)
+      return 1;
+    if (a == -1)
+      return (b & 1) ? -1 : 1;
+    return 0;
+  }
+  long result = 1;
+  while (b) {
+    if (b & 1)
+      result *= a;
+    a *= a;
+    b >>= 1;
+  }
+  return result;
 }
 static inline long i_mod(long a, long b) {
-  return (long)fmod((double)a, (double)b);
+  // a % -1 is always 0; computing it would trap for LONG_MIN.
+  if (b == -1)
+    return 0;
+  long r = a % b;
+  // Floor semantics (remainder takes the divisor's sign), consistent
+  // with the flooring OP_INTDIV.
+  if (r != 0 && ((r < 0) != (b < 0)))
+    r += b;
+  return r;
 }
 
 static inline double f_add(double a, double b) { return a + b; }
@@ -203,37 +251,41 @@ static inline double f_div(double a, double b) { return a / b; }
 static inline double f_pow(double a, double b) { return pow(a, b); }
 static inline double f_mod(double a, double b) { return fmod(a, b); }
 
-static inline Value number__add__(Value a, Value b) {
+Value number__add__(Value a, Value b) {
   return number_binop(a, b, i_add, f_add, OP_ADD);
 }
-static inline Value number__sub__(Value a, Value b) {
+Value number__sub__(Value a, Value b) {
   return number_binop(a, b, i_sub, f_sub, OP_SUB);
 }
-static inline Value number__mul__(Value a, Value b) {
+Value number__mul__(Value a, Value b) {
   return number_binop(a, b, i_mul, f_mul, OP_MUL);
 }
-static inline Value number__div__(Value a, Value b, LocRef loc) {
+Value number__div__(Value a, Value b, LocRef loc) {
   if (number_as_double(&(b.number)) == 0) {
     u_throw(305, NULL, loc);
   }
   return number_binop(a, b, i_div, f_div, OP_DIV);
 }
-static inline Value number__pow__(Value a, Value b, LocRef loc) {
+Value number__pow__(Value a, Value b, LocRef loc) {
   if (number_as_double(&(a.number)) == 0 && number_as_double(&(b.number)) < 0) {
     u_throw(306, NULL, loc);
   }
   return number_binop(a, b, i_pow, f_pow, OP_POW);
 }
-static inline Value number__mod__(Value a, Value b) {
+Value number__mod__(Value a, Value b) {
+  // The integer kernel raises SIGFPE on a zero divisor; fmod never did.
+  if (number_as_double(&(b.number)) == 0) {
+    u_throw(305, NULL, NULL);
+  }
   return number_binop(a, b, i_mod, f_mod, OP_MOD);
 }
-static inline Value number__dadd__(Value a, Value b) {
+Value number__dadd__(Value a, Value b) {
   return number_binop(a, b, i_add, f_add, OP_DADD);
 }
-static inline Value number__dsub__(Value a, Value b) {
+Value number__dsub__(Value a, Value b) {
   return number_binop(a, b, i_sub, f_sub, OP_DSUB);
 }
-static inline Value number__intdiv__(Value a, Value b) {
+Value number__intdiv__(Value a, Value b) {
   return number_binop(a, b, i_div, f_div, OP_INTDIV);
 }
 
@@ -266,13 +318,25 @@ Value number__convert__(Value self, const uint64_t target) {
     Unit *src = unit_get(n->unit);
     value *= src->scalar;
   } else if (dimless_value) {
-    double base = eval_unit(u, value, EVAL_BASE);
-    double inverted = eval_unit(u, value, EVAL_INVERTED);
-    if (inverted == 0.0)
-      value = 0.0;
-    else {
-      double res = base / inverted;
-      value = unit_is_logarithmic(u) ? res : value * res;
+    uint16_t kind = unit_eval_kind(u);
+    if (kind == UNIT_EVAL_UNCACHED)
+      kind = unit_cache_eval(u);
+    if (kind == UNIT_EVAL_LINEAR) {
+      // base/inverted is constant; eval_factor caches its reciprocal.
+      value = (u->eval_factor != 0.0) ? value / u->eval_factor : 0.0;
+    } else if (kind == UNIT_EVAL_AFFINE) {
+      double base = u->eval_base_a * value + u->eval_base_b;
+      double inverted = u->eval_inv_a * value + u->eval_inv_b;
+      value = (inverted != 0.0) ? value * (base / inverted) : 0.0;
+    } else {
+      double base = eval_unit(u, value, EVAL_BASE);
+      double inverted = eval_unit(u, value, EVAL_INVERTED);
+      if (inverted == 0.0)
+        value = 0.0;
+      else {
+        double res = base / inverted;
+        value = unit_is_logarithmic(u) ? res : value * res;
+      }
     }
   }
 
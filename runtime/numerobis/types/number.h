@@ -10,6 +10,20 @@ Value num__init__(double x, const uint64_t unit);
 
 Value number__convert__(Value self, const uint64_t target);
 
+/* Exported so generated code can call number arithmetic directly when the
+ * typechecker has proven both operands numeric, bypassing the
+ * NUMEROBIS_METHODS function-pointer dispatch. */
+Value number__add__(Value a, Value b);
+Value number__sub__(Value a, Value b);
+Value number__eq__(Value a, Value b);
+Value number__mul__(Value a, Value b);
+Value number__div__(Value a, Value b, LocRef loc);
+Value number__pow__(Value a, Value b, LocRef loc);
+Value number__mod__(Value a, Value b);
+Value number__dadd__(Value a, Value b);
+Value number__dsub__(Value a, Value b);
+Value number__intdiv__(Value a, Value b);
+
 typedef enum {
   OP_ADD,
   OP_SUB,
@@ -14,6 +14,7 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,18 +27,107 @@ Value str__init__(sds x) {
   return v;
 }
 
-static const char **build_char_positions(const sds self, size_t len) {
-  const char **positions = GC_MALLOC((len + 1) * sizeof(char *));
+// Fragment packing
+//
+// Splitting a large string used to cost one GC allocation per fragment;
+// a 100 MB input shreds into millions of short-lived blocks. Instead the
+// caller sizes one block with str_carve_size and str_carve writes each
+// fragment into it as a regular sds (fixed sdshdr32 header), so every
+// consumer of Value.str keeps working unchanged while the whole split is
+// a single allocation. The GC's interior-pointer handling keeps the
+// block alive as long as any fragment is referenced.
+
+size_t str_carve_size(size_t len) {
+  return sizeof(struct sdshdr32) + len + 1;
+}
+
+sds str_carve(char *block, size_t *off, const char *p, size_t len) {
+  assert(len < UINT32_MAX);
+
+  struct sdshdr32 *sh = (struct sdshdr32 *)(block + *off);
+  sh->len = (uint32_t)len;
+  sh->alloc = (uint32_t)len;
+  sh->flags = SDS_TYPE_32;
+  // Carve blocks come from GC_MALLOC_ATOMIC, which does not zero: the
+  // cached content hash must be cleared explicitly or sdshash treats
+  // leftover garbage as a valid hash.
+  sh->hash = 0;
+  if (len)
+    memcpy(sh->buf, p, len);
+  sh->buf[len] = '\0';
+
+  *off += str_carve_size(len);
+  return sh->buf;
+}
+
+static size_t *build_char_offsets(const sds self, size_t len) {
+  // Uncollectable (see arena.c): the table is referenced only from the
+  // thread-local cache below, and the collector does not scan
+  // thread-local storage as a root — a collectable block could be
+  // reclaimed while still cached. Freed explicitly on eviction.
+  size_t *offsets = GC_MALLOC_UNCOLLECTABLE((len + 1) * sizeof(size_t));
   const char *p = self;
   const char *end = self + sdslen(self);
 
   for (size_t i = 0; i < len && p < end; i++) {
-    positions[i] = p;
+    offsets[i] = (size_t)(p - self);
     p = utf8_next_char(p, end);
   }
-  positions[len] = end;
+  offsets[len] = sdslen(self);
+
+  return offsets;
+}
+
+// UTF-8 index cache
+//
+// Character indexing has to walk the byte string, which makes a
+// character-by-character scan of an n-char string O(n^2). Strings are
+// immutable in this runtime (every operation builds a new sds), so the
+// code point count and — for non-ASCII strings — the code point offset
+// table can be memoized per string. A small direct-mapped cache keyed by
+// the sds pointer keeps repeated indexing of the same string O(1); an
+// entry is revalidated against the byte length and the cached content
+// hash (sdshash) so an address recycled by the collector for a new
+// same-length string cannot serve stale counts or offsets.
+
+#define STR_INDEX_SLOTS 64
+
+typedef struct {
+  sds str;
+  size_t bytes;
+  uint64_t hash;
+  size_t chars;
+  // Lazily built byte-offset table; stays NULL while untouched or pure
+  // ASCII (bytes == chars), where direct byte indexing needs no table.
+  size_t *offsets;
+} StrIndex;
+
+// Per-thread, like _unit_tls_cache in units/units.c: pool and task
+// threads index strings through their own slots, so an entry can never
+// be torn by a concurrent writer and validated against the wrong string.
+static _Thread_local StrIndex _str_index_cache[STR_INDEX_SLOTS];
+
+static StrIndex *_str_index(const sds s) {
+  StrIndex *e = &_str_index_cache[((uintptr_t)s >> 4) % STR_INDEX_SLOTS];
+  size_t bytes = sdslen(s);
+  uint64_t hash = sdshash(s);
+
+  if (e->str != s || e->bytes != bytes || e->hash != hash) {
+    if (e->offsets)
+      GC_FREE(e->offsets);
+    e->str = s;
+    e->bytes = bytes;
+    e->hash = hash;
+    e->chars = count_utf8_code_points(s);
+    e->offsets = NULL;
+  }
+  return e;
+}
 
-  return positions;
+static const size_t *_str_offsets(StrIndex *e) {
+  if (!e->offsets)
+    e->offsets = build_char_offsets(e->str, e->chars);
+  return e->offsets;
 }
 
 static Value str__bool__(Value self) {
@@ -53,20 +143,19 @@ static Value str__getitem__(Value _self, Value _index) {
   if (!self)
     return EMPTY;
 
-  ssize_t len = (ssize_t)_str_len(self);
+  StrIndex *idx = _str_index(self);
+  ssize_t len = (ssize_t)idx->chars;
   ssize_t nidx = normalize_index(index, len);
 
   if (nidx < 0 || nidx >= len)
     return EMPTY;
 
-  const char *p = self;
-  const char *end = self + sdslen(self);
-  for (ssize_t i = 0; i < nidx; i++)
-    p = utf8_next_char(p, end);
-
-  const char *next = utf8_next_char(p, end);
+  if (idx->bytes == idx->chars) // pure ASCII: one byte per character
+    return str__init__(sdsnewlen(self + nidx, 1));
 
-  return str__init__(sdsnewlen(p, next - p));
+  const size_t *offsets = _str_offsets(idx);
+  return str__init__(
+      sdsnewlen(self + offsets[nidx], offsets[nidx + 1] - offsets[nidx]));
 }
 
 static Value str__getslice__(Value _self, Value _start, Value _stop,
@@ -75,7 +164,8 @@ static Value str__getslice__(Value _self, Value _start, Value _stop,
   if (!self)
     return str__init__(sdsempty());
 
-  ssize_t len = (ssize_t)_str_len(self);
+  StrIndex *idx = _str_index(self);
+  ssize_t len = (ssize_t)idx->chars;
 
   ssize_t start =
       (_start.type == VALUE_NUMBER) ? (ssize_t)_start.number.i64 : SLICE_NONE;
@@ -92,12 +182,23 @@ static Value str__getslice__(Value _self, Value _start, Value _stop,
   if ((step > 0 && start >= end) || (step < 0 && start <= end))
     return str__init__(sdsempty());
 
-  const char **positions = build_char_positions(self, len);
+  if (idx->bytes == idx->chars) {
+    if (step == 1) // contiguous ASCII slice: single copy
+      return str__init__(sdsnewlen(self + start, (size_t)(end - start)));
+
+    sds result = sdsempty();
+    result = sdsMakeRoomFor(result, (size_t)labs(end - start));
+    for (ssize_t i = start; step > 0 ? i < end : i > end; i += step)
+      result = sdscatlen(result, self + i, 1);
+    return str__init__(result);
+  }
+
+  const size_t *offsets = _str_offsets(idx);
   sds result = sdsempty();
 
   for (ssize_t i = start; step > 0 ? i < end : i > end; i += step) {
     if (i >= 0 && i < len) {
-      result = sdscatlen(result, positions[i], positions[i + 1] - positions[i]);
+      result = sdscatlen(result, self + offsets[i], offsets[i + 1] - offsets[i]);
     }
   }
 
@@ -117,6 +218,33 @@ static Value str__add__(Value _self, Value _other) {
   return str__init__(result);
 }
 
+// Compiler-emitted lowering of `s = s + t` for locals the frontend proved
+// unaliased (accumulation_locals in scoping.py): grows s's own buffer
+// instead of copying both operands, so accumulation loops run in
+// amortized O(n).
+Value str__append__(Value _self, Value _other) {
+  sds self = _self.str;
+  sds other = _other.str;
+
+  if (!self || !other)
+    return str__add__(_self, _other);
+
+  size_t len = sdslen(self);
+  size_t add = sdslen(other);
+
+  if (sdsavail(self) >= add)
+    return str__init__(sdscatlen(self, other, add));
+
+  // No spare room: the buffer may be an interned literal or a carved
+  // fragment (str_carve), neither of which may be grown in place. Copy
+  // once into a fresh buffer; sdsMakeRoomFor's greedy sizing leaves
+  // headroom so subsequent appends take the in-place branch.
+  sds result = sdsMakeRoomFor(sdsempty(), len + add);
+  result = sdscatlen(result, self, len);
+  result = sdscatlen(result, other, add);
+  return str__init__(result);
+}
+
 static Value str__mul__(Value _self, Value _n) {
   sds self = _self.str;
   long n = _n.number.i64;
@@ -137,14 +265,19 @@ static Value str__mul__(Value _self, Value _n) {
   return str__init__(result);
 }
 
-static Value str__eq__(Value a, Value b) {
+Value str__eq__(Value a, Value b) {
   if (a.str == b.str)
     return VTRUE;
   if (!a.str || !b.str)
     return VFALSE;
-  bool eq = (sdslen(a.str) == sdslen(b.str)) &&
-            (memcmp(a.str, b.str, sdslen(a.str)) == 0);
-  return bool__init__(eq);
+  if (sdslen(a.str) != sdslen(b.str))
+    return VFALSE;
+  // O(1) negative prefilter: the cached content hashes (sdshash) of
+  // unequal strings almost never collide, and after the first call the
+  // comparison never rescans either payload.
+  if (sdshash(a.str) != sdshash(b.str))
+    return VFALSE;
+  return bool__init__(memcmp(a.str, b.str, sdslen(a.str)) == 0);
 }
 
 static Value str__lt__(Value self, Value other) {
@@ -173,9 +306,76 @@ static Value str__ge__(Value self, Value other) {
 
 static inline Value str__str__(Value self) { return self; }
 
+// Fast number parsing
+//
+// strtoll/strtod handle locales, every base and every corner of the
+// grammar, which costs hundreds of cycles per call — too much for
+// ingest workloads that parse millions of fields. The common shape
+// (optional sign, decimal digits, optional fraction and exponent) is
+// parsed here directly, chunking eight ASCII digits at a time with the
+// usual SWAR multiplies; anything else — hex, inf/nan, overlong digit
+// runs, out-of-range exponents — falls back to the libc path, so the
+// EMPTY-on-failure contract is unchanged.
+
+static inline bool _all8_digits(uint64_t v) {
+  return ((v & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+static inline uint64_t _parse8_digits(uint64_t v) {
+  v = (v & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+  v = (v & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+  return (v & 0x0000FFFF0000FFFFULL) * 42949672960001 >> 32;
+}
+
+/* Accumulates decimal digits at *pp into *m, eight at a time while they
+ * last. Stops after 19 digits (the most that fit a uint64_t) and returns
+ * false if more follow. */
+static bool _scan_digits(const char **pp, const char *end, uint64_t *m,
+                         int *ndigits) {
+  const char *p = *pp;
+
+  while (end - p >= 8 && *ndigits + 8 <= 19) {
+    uint64_t chunk;
+    memcpy(&chunk, p, 8);
+    if (!_all8_digits(chunk))
+      break;
+    *m = *m * 100000000 + _parse8_digits(chunk);
+    *ndigits += 8;
+    p += 8;
+  }
+  while (*p >= '0' && *p <= '9') {
+    if (*ndigits == 19) {
+      *pp = p;
+      return false;
+    }
+    *m = *m * 10 + (uint64_t)(*p++ - '0');
+    (*ndigits)++;
+  }
+
+  *pp = p;
+  return true;
+}
+
+static Value _str_int_slow(const char *str) {
+  char *endptr = NULL;
+
+  long result = strtoll(str, &endptr, 10);
+
+  while (isspace((unsigned char)*endptr)) {
+    endptr++;
+  }
+
+  if (*endptr != '\0') {
+    return EMPTY;
+  }
+
+  return int__init__(result, U_ONE);
+}
+
 static Value str__int__(Value self) {
   const char *str = self.str;
-  char *endptr = NULL;
 
   while (isspace((unsigned char)*str)) {
     str++;
@@ -185,7 +385,35 @@ static Value str__int__(Value self) {
     return EMPTY;
   }
 
-  long result = strtoll(str, &endptr, 10);
+  const char *p = str;
+  bool neg = (*p == '-');
+  if (*p == '-' || *p == '+')
+    p++;
+
+  const char *end = self.str + sdslen(self.str);
+  uint64_t m = 0;
+  int ndigits = 0;
+  if (!_scan_digits(&p, end, &m, &ndigits))
+    return _str_int_slow(str); // > 19 digits: let strtoll saturate
+
+  if (ndigits == 0)
+    return EMPTY;
+  if (m > (uint64_t)LONG_MAX + (neg ? 1 : 0))
+    return _str_int_slow(str);
+
+  while (isspace((unsigned char)*p))
+    p++;
+  if (*p != '\0')
+    return EMPTY;
+
+  // Unsigned negation: m may be exactly -LONG_MIN here.
+  return int__init__((long)(neg ? 0 - m : m), U_ONE);
+}
+
+static Value _str_num_slow(const char *str) {
+  char *endptr = NULL;
+
+  double result = strtod(str, &endptr);
 
   while (isspace((unsigned char)*endptr)) {
     endptr++;
@@ -195,15 +423,21 @@ static Value str__int__(Value self) {
     return EMPTY;
   }
 
-  return int__init__(result, U_ONE);
+  return num__init__(result, U_ONE);
 }
 
+/* Exactly representable powers of ten: one multiply or divide by these
+ * is a single correctly rounded operation. */
+static const double _POW10D[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                 1e18, 1e19, 1e20, 1e21, 1e22};
+
 static Value str__num__(Value self) {
   if (!self.str)
     return EMPTY;
 
   const char *str = self.str;
-  char *endptr = NULL;
 
   while (isspace((unsigned char)*str)) {
     str++;
@@ -213,17 +447,56 @@ static Value str__num__(Value self) {
     return EMPTY;
   }
 
-  double result = strtod(str, &endptr);
-
-  while (isspace((unsigned char)*endptr)) {
-    endptr++;
+  const char *p = str;
+  bool neg = (*p == '-');
+  if (*p == '-' || *p == '+')
+    p++;
+
+  const char *end = self.str + sdslen(self.str);
+  uint64_t m = 0;
+  int ndigits = 0;
+  int exp10 = 0;
+
+  if (!_scan_digits(&p, end, &m, &ndigits))
+    return _str_num_slow(str);
+
+  if (*p == '.') {
+    p++;
+    const char *frac = p;
+    if (!_scan_digits(&p, end, &m, &ndigits))
+      return _str_num_slow(str);
+    exp10 -= (int)(p - frac);
   }
 
-  if (*endptr != '\0') {
-    return EMPTY;
+  if (ndigits == 0) // "inf", "nan", lone sign, ...
+    return _str_num_slow(str);
+
+  if (*p == 'e' || *p == 'E') {
+    p++;
+    bool eneg = (*p == '-');
+    if (*p == '-' || *p == '+')
+      p++;
+    if (!(*p >= '0' && *p <= '9'))
+      return _str_num_slow(str);
+    int e = 0;
+    while (*p >= '0' && *p <= '9' && e < 10000)
+      e = e * 10 + (*p++ - '0');
+    exp10 += eneg ? -e : e;
   }
 
-  return num__init__(result, U_ONE);
+  while (isspace((unsigned char)*p))
+    p++;
+  if (*p != '\0') // unconsumed input: hex floats and friends
+    return _str_num_slow(str);
+
+  // m * 10^exp10 is exact in one operation only when both factors are
+  // exactly representable; otherwise defer to strtod.
+  if (m >= (1ULL << 53) || exp10 < -22 || exp10 > 22)
+    return _str_num_slow(str);
+
+  double d = (double)m;
+  d = exp10 < 0 ? d / _POW10D[-exp10] : d * _POW10D[exp10];
+  return num__init__(neg ? -d : d, U_ONE);
 }
 
 static const ValueMethods _str_methods = {
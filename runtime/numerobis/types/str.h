@@ -10,9 +10,23 @@
 #include <stddef.h>
 
 Value str__init__(sds x);
+Value str__eq__(Value a, Value b);
+
+/* In-place concatenation for `s = s + t` reassignments the compiler proved
+ * unaliased: grows s's buffer when it has spare room, otherwise copies
+ * once with headroom. */
+Value str__append__(Value self, Value other);
 
 #define EMPTY_STR str__init__(sdsempty())
 
+/* One-allocation packing of many string fragments: str_carve lays a valid
+ * sds (header + bytes + NUL) into `block` at *off and advances the offset.
+ * Fragments share the block's lifetime under the GC; they are immutable
+ * like every runtime string and must never be grown in place. Size the
+ * block with str_carve_size per fragment. */
+size_t str_carve_size(size_t len);
+sds str_carve(char *block, size_t *off, const char *p, size_t len);
+
 static inline size_t _str_len(const sds s) {
   return s ? count_utf8_code_points(s) : 0;
 }
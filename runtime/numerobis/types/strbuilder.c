@@ -0,0 +1,117 @@
+#include "strbuilder.h"
+#include "../constants.h"
+#include "../extern.h"
+#include "../libs/sds.h"
+#include "../units/eval.h"
+#include "../units/units.h"
+#include "../utils/dtoa.h"
+#include "../values.h"
+#include "bool.h"
+#include "methods.h"
+#include "number.h"
+#include "str.h"
+
+#include <gc/gc.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+static const ValueMethods _strbuilder_methods;
+
+Value strbuilder__init__(void) {
+  Value v;
+  v.type = VALUE_STRBUILDER;
+
+  StrBuilder *obj = GC_MALLOC(sizeof(StrBuilder));
+  obj->buf = sdsempty();
+
+  v.strbuilder = obj;
+  return v;
+}
+
+// Methods
+
+static Value strbuilder__bool__(Value self) {
+  return bool__init__(sdslen(self.strbuilder->buf) > 0);
+}
+static bool strbuilder__cbool__(Value self) {
+  return sdslen(self.strbuilder->buf) > 0;
+}
+
+static Value strbuilder__eq__(Value a, Value b) {
+  return bool__init__(a.strbuilder == b.strbuilder);
+}
+
+static Value strbuilder__str__(Value self) {
+  // The builder keeps mutating, so stringifying mid-build must copy.
+  return str__init__(sdsdup(self.strbuilder->buf));
+}
+
+// Externs
+
+static Value strbuilder_new(Value *args) { return strbuilder__init__(); }
+
+static Value strbuilder_append(Value *args) {
+  StrBuilder *self = args[2].strbuilder;
+  Value val = args[1];
+
+  if (val.type == VALUE_STR) {
+    self->buf = sdscatlen(self->buf, val.str, sdslen(val.str));
+  } else {
+    Value s = __str__(val, NULL);
+    self->buf = sdscatlen(self->buf, s.str, sdslen(s.str));
+  }
+  return NONE;
+}
+
+static Value strbuilder_appendnum(Value *args) {
+  StrBuilder *self = args[2].strbuilder;
+  Number *n = &args[1].number;
+
+  // Format straight into the buffer — no intermediate string Value.
+  const Unit *u = unit_get(n->unit);
+  if (is_one(u) && u->scalar == 1.0) {
+    char buf[DTOA_BUF_SIZE];
+    size_t len = n->kind == NUM_INT64 ? i64toa(n->i64, buf)
+                                      : dtoa_shortest(n->f64, buf);
+    self->buf = sdscatlen(self->buf, buf, len);
+    return NONE;
+  }
+
+  sds s = print_number(n); // unit suffix needs the full path
+  self->buf = sdscatlen(self->buf, s, sdslen(s));
+  sdsfree(s);
+  return NONE;
+}
+
+static Value strbuilder_len(Value *args) {
+  return int__init__((long)sdslen(args[1].strbuilder->buf), U_ONE);
+}
+
+/* Freezes the accumulated bytes into an ordinary string without copying:
+ * the buffer is handed over as-is (runtime strings are immutable) and the
+ * builder starts over empty. */
+static Value strbuilder_build(Value *args) {
+  StrBuilder *self = args[1].strbuilder;
+  sds out = self->buf;
+  self->buf = sdsempty();
+  return str__init__(out);
+}
+
+static const ValueMethods _strbuilder_methods = {
+    .__bool__ = strbuilder__bool__,
+    .__cbool__ = strbuilder__cbool__,
+    .__eq__ = strbuilder__eq__,
+    .__str__ = strbuilder__str__,
+};
+
+void strbuilder_methods_init(void) {
+  NUMEROBIS_METHODS[VALUE_STRBUILDER] = &_strbuilder_methods;
+}
+
+void numerobis_strbuilder_register_externs(void) {
+  u_extern_register("strbuilder", strbuilder_new);
+  u_extern_register("StrBuilder.append", strbuilder_append);
+  u_extern_register("StrBuilder.appendnum", strbuilder_appendnum);
+  u_extern_register("StrBuilder.len", strbuilder_len);
+  u_extern_register("StrBuilder.build", strbuilder_build);
+}
@@ -0,0 +1,21 @@
+#ifndef NUMEROBIS_STRBUILDER_H
+#define NUMEROBIS_STRBUILDER_H
+
+#include "../libs/sds.h"
+#include "../values.h"
+
+/* Append-only string builder: one growing sds instead of a fresh copy of
+ * both operands per `+`, so building output in a loop is linear instead
+ * of quadratic in bytes. StrBuilder.build hands the buffer over as an
+ * ordinary string without copying and resets the builder to empty. */
+typedef struct StrBuilder {
+  sds buf;
+} StrBuilder;
+
+Value strbuilder__init__(void);
+
+void strbuilder_methods_init(void);
+
+void numerobis_strbuilder_register_externs(void);
+
+#endif
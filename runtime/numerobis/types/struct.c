@@ -32,6 +32,9 @@ static inline Value struct__eq__(Value _self, Value _other) {
   if (id != other[0].number.i64)
     return VFALSE;
 
+  if (STRUCT_REGISTRY[id].eq)
+    return STRUCT_REGISTRY[id].eq(_self, _other);
+
   size_t fieldc = STRUCT_REGISTRY[id].fieldc;
 
   for (size_t i = 1; i <= fieldc; i++) {
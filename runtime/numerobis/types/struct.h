@@ -12,9 +12,13 @@ typedef struct {
   const char *name;
   const char **field_names;
   size_t fieldc;
+  // Specialized comparator generated by the linker from the static field
+  // types; NULL falls back to the generic per-field dispatch loop.
+  Value (*eq)(Value, Value);
 } StructInfo;
 
 extern const StructInfo STRUCT_REGISTRY[];
+extern const size_t STRUCT_REGISTRY_LEN;
 
 Value struct__init__(long id, long fieldc);
 void struct_methods_init(void);
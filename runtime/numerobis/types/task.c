@@ -0,0 +1,115 @@
+#include "task.h"
+#include "../constants.h"
+#include "../extern.h"
+#include "../utils/arena.h"
+#include "../libs/sds.h"
+#include "bool.h"
+#include "methods.h"
+#include "str.h"
+
+#include <gc/gc.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+static const ValueMethods _task_methods;
+
+static pthread_once_t _task_gc_once = PTHREAD_ONCE_INIT;
+
+static void _task_gc_setup(void) { GC_allow_register_threads(); }
+
+static void *_task_main(void *arg) {
+  struct GC_stack_base sb;
+  GC_get_stack_base(&sb);
+  GC_register_my_thread(&sb);
+
+  Task *t = arg;
+  Value kargs[3] = {t->fn, EMPTY, EMPTY};
+  Value r = __call__(t->fn, kargs, 0);
+
+  pthread_mutex_lock(&t->lock);
+  t->result = r;
+  t->done = true;
+  pthread_cond_broadcast(&t->cv);
+  pthread_mutex_unlock(&t->lock);
+
+  u_arena_thread_shutdown();
+  GC_unregister_my_thread();
+  return NULL;
+}
+
+// Externs
+
+static Value task_spawn(Value *args) {
+  pthread_once(&_task_gc_once, _task_gc_setup);
+
+  Task *t = GC_MALLOC(sizeof(Task));
+  pthread_mutex_init(&t->lock, NULL);
+  pthread_cond_init(&t->cv, NULL);
+  t->fn = args[1];
+  t->result = NONE;
+  t->done = false;
+
+  pthread_t tid;
+  if (pthread_create(&tid, NULL, _task_main, t) != 0) {
+    // Could not start a thread: run the closure inline instead.
+    Value kargs[3] = {t->fn, EMPTY, EMPTY};
+    t->result = __call__(t->fn, kargs, 0);
+    t->done = true;
+  } else {
+    pthread_detach(tid);
+  }
+
+  Value v;
+  v.type = VALUE_TASK;
+  v.task = t;
+  return v;
+}
+
+static Value task_await(Value *args) {
+  Task *t = args[1].task;
+  pthread_mutex_lock(&t->lock);
+  while (!t->done)
+    pthread_cond_wait(&t->cv, &t->lock);
+  Value r = t->result;
+  pthread_mutex_unlock(&t->lock);
+  return r;
+}
+
+static Value task_done(Value *args) {
+  Task *t = args[1].task;
+  pthread_mutex_lock(&t->lock);
+  bool done = t->done;
+  pthread_mutex_unlock(&t->lock);
+  return bool__init__(done);
+}
+
+// Methods
+
+static Value task__bool__(Value self) {
+  Value args[2] = {EMPTY, self};
+  return task_done(args);
+}
+static bool task__cbool__(Value self) { return task__bool__(self).boolean; }
+
+static Value task__eq__(Value a, Value b) {
+  return bool__init__(a.task == b.task);
+}
+
+static Value task__str__(Value self) {
+  return str__init__(sdscatprintf(sdsempty(), "<Task %p>", (void *)self.task));
+}
+
+static const ValueMethods _task_methods = {
+    .__bool__ = task__bool__,
+    .__cbool__ = task__cbool__,
+    .__eq__ = task__eq__,
+    .__str__ = task__str__,
+};
+
+void task_methods_init(void) { NUMEROBIS_METHODS[VALUE_TASK] = &_task_methods; }
+
+void numerobis_task_register_externs(void) {
+  u_extern_register("spawn", task_spawn);
+  u_extern_register("await", task_await);
+  u_extern_register("Task.done", task_done);
+}
@@ -0,0 +1,26 @@
+#ifndef NUMEROBIS_TASK_H
+#define NUMEROBIS_TASK_H
+
+#include "../values.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+
+/* Handle for a closure running in the background. spawn starts the
+ * closure on its own GC-registered thread and returns immediately, so
+ * blocking I/O inside it (input(), File.readline, ...) overlaps with
+ * whatever the caller computes next; await parks until the result is
+ * ready. No raw threads reach the language — just spawn/await/done. */
+typedef struct Task {
+  pthread_mutex_t lock;
+  pthread_cond_t cv;
+  Value fn;
+  Value result;
+  bool done;
+} Task;
+
+void task_methods_init(void);
+
+void numerobis_task_register_externs(void);
+
+#endif
@@ -0,0 +1,298 @@
+#include "vec.h"
+#include "../constants.h"
+#include "../extern.h"
+#include "../units/eval.h"
+#include "../units/units.h"
+#include "../values.h"
+#include "bool.h"
+#include "methods.h"
+#include "number.h"
+#include "str.h"
+
+#include "../libs/bdwgc/include/gc.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static const ValueMethods _vec_methods;
+
+Value vec__init__(uint8_t rows, uint8_t cols, uint64_t unit) {
+  Value v;
+  v.type = VALUE_VEC;
+  v.vec = GC_MALLOC_ATOMIC(sizeof(Vec));
+  v.vec->rows = rows;
+  v.vec->cols = cols;
+  v.vec->unit = unit;
+  return v;
+}
+
+/* Unit hash of an elementwise product: one unit_mul per whole-object
+ * operation, with the same dimensionless fast path as number_binop. */
+static inline uint64_t _vec_unit_mul(uint64_t a, uint64_t b, bool invert) {
+  if (UNIT_IS_ONE_HASH(a) && UNIT_IS_ONE_HASH(b))
+    return NUMEROBIS_UNIT_ONE_HASH;
+  return unit_mul(unit_get(a), unit_get(b), invert);
+}
+
+/* The kernels below are plain fixed-count loops over the contiguous
+ * payloads; the trip counts are compile-time constants per shape, so the
+ * compiler unrolls and vectorizes them without any per-element dispatch
+ * or unit bookkeeping in the way. */
+
+// Binary operators
+
+/* Like number add/sub, the result keeps the left operand's unit hash and
+ * the payloads combine raw. */
+static Value vec__add__(Value self, Value other) {
+  const Vec *a = self.vec, *b = other.vec;
+  Value out = vec__init__(a->rows, a->cols, a->unit);
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    out.vec->data[i] = a->data[i] + b->data[i];
+  return out;
+}
+
+static Value vec__sub__(Value self, Value other) {
+  const Vec *a = self.vec, *b = other.vec;
+  Value out = vec__init__(a->rows, a->cols, a->unit);
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    out.vec->data[i] = a->data[i] - b->data[i];
+  return out;
+}
+
+/* Scaling by a number; the typechecker only admits numeric right (or
+ * swapped left) operands here. */
+static Value vec_scale(Value self, Value other, bool invert) {
+  const Vec *a = self.vec;
+  const Number *s = &other.number;
+  double x = s->kind == NUM_DOUBLE ? s->f64 : (double)s->i64;
+
+  Value out =
+      vec__init__(a->rows, a->cols, _vec_unit_mul(a->unit, s->unit, invert));
+  size_t n = _vec_len(a);
+  if (invert) {
+    for (size_t i = 0; i < n; i++)
+      out.vec->data[i] = a->data[i] / x;
+  } else {
+    for (size_t i = 0; i < n; i++)
+      out.vec->data[i] = a->data[i] * x;
+  }
+  return out;
+}
+
+static Value vec__mul__(Value self, Value other) {
+  return vec_scale(self, other, false);
+}
+
+static Value vec__div__(Value self, Value other, LocRef loc) {
+  return vec_scale(self, other, true);
+}
+
+static Value vec__neg__(Value self) {
+  const Vec *a = self.vec;
+  Value out = vec__init__(a->rows, a->cols, a->unit);
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    out.vec->data[i] = -a->data[i];
+  return out;
+}
+
+// Comparisons
+
+/* Payload comparison, like number_cmp: unit hashes are not consulted. */
+static Value vec__eq__(Value self, Value other) {
+  const Vec *a = self.vec, *b = other.vec;
+  if (a->rows != b->rows || a->cols != b->cols)
+    return VFALSE;
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    if (a->data[i] != b->data[i])
+      return VFALSE;
+  return VTRUE;
+}
+
+static Value vec__bool__(Value self) {
+  const Vec *a = self.vec;
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    if (a->data[i] != 0.0)
+      return VTRUE;
+  return VFALSE;
+}
+
+static bool vec__cbool__(Value self) { return vec__bool__(self).boolean; }
+
+// Indexing / printing
+
+static Value vec__getitem__(Value self, Value index) {
+  const Vec *a = self.vec;
+  long i = index.number.i64;
+  if (i < 0)
+    i += (long)_vec_len(a);
+  if (i < 0 || (size_t)i >= _vec_len(a)) {
+    u_throw(914, NULL, NULL);
+    return EMPTY;
+  }
+  return num__init__(a->data[i], a->unit);
+}
+
+static const char *_vec_name(const Vec *v) {
+  if (v->cols == 3)
+    return "Mat3";
+  return v->rows == 2 ? "Vec2" : "Vec3";
+}
+
+static Value vec__str__(Value self) {
+  const Vec *a = self.vec;
+  sds s = sdsnew(_vec_name(a));
+  s = sdscat(s, "(");
+  for (uint8_t r = 0; r < a->rows; r++) {
+    if (r > 0)
+      s = sdscat(s, ", ");
+    if (a->cols > 1)
+      s = sdscat(s, "(");
+    for (uint8_t c = 0; c < a->cols; c++) {
+      if (c > 0)
+        s = sdscat(s, ", ");
+      Number n = {.kind = NUM_DOUBLE, .unit = a->unit};
+      n.f64 = a->data[r * a->cols + c];
+      s = print_number_cat(s, &n);
+    }
+    if (a->cols > 1)
+      s = sdscat(s, ")");
+  }
+  s = sdscat(s, ")");
+  return str__init__(s);
+}
+
+// Externs
+
+/* Constructors normalize mixed units of one dimension to the first
+ * component's unit, so the object carries a single unit hash. */
+static Value vec_from_args(Value *args, uint8_t rows, uint8_t cols) {
+  uint64_t unit = args[1].number.unit;
+  Value out = vec__init__(rows, cols, unit);
+  size_t n = (size_t)rows * cols;
+  for (size_t i = 0; i < n; i++) {
+    Value c = args[i + 1];
+    if (c.number.unit != unit)
+      c = number__convert__(c, unit);
+    out.vec->data[i] = c.number.kind == NUM_DOUBLE ? c.number.f64
+                                                   : (double)c.number.i64;
+  }
+  return out;
+}
+
+static Value vec_vec2(Value *args) { return vec_from_args(args, 2, 1); }
+static Value vec_vec3(Value *args) { return vec_from_args(args, 3, 1); }
+static Value vec_mat3(Value *args) { return vec_from_args(args, 3, 3); }
+
+static Value vec_x(Value *args) {
+  const Vec *a = args[1].vec;
+  return num__init__(a->data[0], a->unit);
+}
+static Value vec_y(Value *args) {
+  const Vec *a = args[1].vec;
+  return num__init__(a->data[1], a->unit);
+}
+static Value vec_z(Value *args) {
+  const Vec *a = args[1].vec;
+  return num__init__(a->data[2], a->unit);
+}
+
+static Value vec_mat3_get(Value *args) {
+  const Vec *a = args[3].vec;
+  long r = args[1].number.i64;
+  long c = args[2].number.i64;
+  if (r < 0 || r >= a->rows || c < 0 || c >= a->cols) {
+    u_throw(914, NULL, NULL);
+    return EMPTY;
+  }
+  return num__init__(a->data[r * a->cols + c], a->unit);
+}
+
+static Value vec_dot(Value *args) {
+  const Vec *a = args[2].vec, *b = args[1].vec;
+  double acc = 0.0;
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    acc += a->data[i] * b->data[i];
+  return num__init__(acc, _vec_unit_mul(a->unit, b->unit, false));
+}
+
+static Value vec_cross(Value *args) {
+  const Vec *a = args[2].vec, *b = args[1].vec;
+  Value out = vec__init__(3, 1, _vec_unit_mul(a->unit, b->unit, false));
+  out.vec->data[0] = a->data[1] * b->data[2] - a->data[2] * b->data[1];
+  out.vec->data[1] = a->data[2] * b->data[0] - a->data[0] * b->data[2];
+  out.vec->data[2] = a->data[0] * b->data[1] - a->data[1] * b->data[0];
+  return out;
+}
+
+static Value vec_norm(Value *args) {
+  const Vec *a = args[1].vec;
+  double acc = 0.0;
+  size_t n = _vec_len(a);
+  for (size_t i = 0; i < n; i++)
+    acc += a->data[i] * a->data[i];
+  return num__init__(sqrt(acc), a->unit);
+}
+
+static Value vec_matmul(Value *args) {
+  const Vec *a = args[2].vec, *b = args[1].vec;
+  Value out = vec__init__(3, 3, _vec_unit_mul(a->unit, b->unit, false));
+  for (size_t r = 0; r < 3; r++)
+    for (size_t c = 0; c < 3; c++) {
+      double acc = 0.0;
+      for (size_t k = 0; k < 3; k++)
+        acc += a->data[r * 3 + k] * b->data[k * 3 + c];
+      out.vec->data[r * 3 + c] = acc;
+    }
+  return out;
+}
+
+static Value vec_apply(Value *args) {
+  const Vec *a = args[2].vec, *b = args[1].vec;
+  Value out = vec__init__(3, 1, _vec_unit_mul(a->unit, b->unit, false));
+  for (size_t r = 0; r < 3; r++)
+    out.vec->data[r] = a->data[r * 3] * b->data[0] +
+                       a->data[r * 3 + 1] * b->data[1] +
+                       a->data[r * 3 + 2] * b->data[2];
+  return out;
+}
+
+static const ValueMethods _vec_methods = {
+    .__bool__ = vec__bool__,
+    .__cbool__ = vec__cbool__,
+    .__add__ = vec__add__,
+    .__sub__ = vec__sub__,
+    .__mul__ = vec__mul__,
+    .__div__ = vec__div__,
+    .__eq__ = vec__eq__,
+    .__neg__ = vec__neg__,
+    .__getitem__ = vec__getitem__,
+    .__str__ = vec__str__,
+};
+
+void vec_methods_init(void) { NUMEROBIS_METHODS[VALUE_VEC] = &_vec_methods; }
+
+void numerobis_vec_register_externs(void) {
+  u_extern_register("vec2", vec_vec2);
+  u_extern_register("vec3", vec_vec3);
+  u_extern_register("mat3", vec_mat3);
+  u_extern_register("Vec2.x", vec_x);
+  u_extern_register("Vec2.y", vec_y);
+  u_extern_register("Vec3.x", vec_x);
+  u_extern_register("Vec3.y", vec_y);
+  u_extern_register("Vec3.z", vec_z);
+  u_extern_register("Mat3.get", vec_mat3_get);
+  u_extern_register("Vec2.dot", vec_dot);
+  u_extern_register("Vec3.dot", vec_dot);
+  u_extern_register("Vec2.norm", vec_norm);
+  u_extern_register("Vec3.norm", vec_norm);
+  u_extern_register("Vec3.cross", vec_cross);
+  u_extern_register("Mat3.matmul", vec_matmul);
+  u_extern_register("Mat3.apply", vec_apply);
+}
@@ -0,0 +1,34 @@
+#ifndef NUMEROBIS_VEC_H
+#define NUMEROBIS_VEC_H
+
+#include "../values.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Fixed-size vector/matrix: contiguous double payloads sharing a single
+ * unit hash, so arithmetic touches the unit machinery once per operation
+ * instead of once per boxed component (3-element lists pay a full boxed
+ * dispatch per component; see tests/orbit.nbis for the old pattern).
+ * rows/cols select the shape: 2x1 (Vec2), 3x1 (Vec3) or 3x3 (Mat3,
+ * row-major). The payload is pointer-free, so instances live in atomic
+ * GC blocks and the collector never scans them. */
+typedef struct Vec {
+  uint8_t rows;
+  uint8_t cols;
+  uint64_t unit;
+  double data[9];
+} Vec;
+
+Value vec__init__(uint8_t rows, uint8_t cols, uint64_t unit);
+
+/* Total component count (2, 3 or 9). */
+static inline size_t _vec_len(const Vec *v) {
+  return (size_t)v->rows * v->cols;
+}
+
+void vec_methods_init(void);
+
+void numerobis_vec_register_externs(void);
+
+#endif
@@ -1,5 +1,6 @@
 #include "eval.h"
 #include "../libs/sds.h"
+#include "../utils/dtoa.h"
 #include "../values.h"
 #include "units.h"
 
@@ -65,6 +66,62 @@ bool unit_is_logarithmic(const Unit *u) {
   return false;
 }
 
+/* Classifies a unit on first evaluation. For purely linear units the
+ * inverted/base ratio is independent of the evaluated value, so it is
+ * computed once (at x = 1) and cached inside the interned Unit; affine
+ * units cache their a*x+b coefficients per direction.
+ *
+ * Interned Units are otherwise immutable, so this is the one place a
+ * shared Unit is written after publication. The coefficients are stored
+ * first and eval_kind is release-stored last; unit_eval_kind's acquire
+ * load pairs with it, so no reader can branch on a cached kind without
+ * seeing the coefficients it guards. Two threads racing on the first
+ * evaluation both classify the unit and store identical values. */
+uint16_t unit_cache_eval(Unit *u) {
+  uint16_t kind = UNIT_EVAL_GENERAL;
+  bool logarithmic = false;
+  bool linear = true;
+
+  for (uint16_t i = 0; i < u->len && !logarithmic; i++) {
+    uint16_t id = u->data[i].id;
+    if (is_logarithmic(id))
+      logarithmic = true;
+    // A transformation is linear iff f(0) == 0 and f(2) == 2*f(1).
+    else if (base_unit(id, 0.0) != 0.0 ||
+             base_unit(id, 2.0) != 2.0 * base_unit(id, 1.0) ||
+             unit_id_eval(id, 0.0) != 0.0 ||
+             unit_id_eval(id, 2.0) != 2.0 * unit_id_eval(id, 1.0))
+      linear = false;
+  }
+
+  if (!logarithmic && linear) {
+    double base = eval_unit(u, 1.0, EVAL_BASE);
+    double inverted = eval_unit(u, 1.0, EVAL_INVERTED);
+    u->eval_factor = (base != 0.0) ? inverted / base : 0.0;
+    kind = UNIT_EVAL_LINEAR;
+  } else if (!logarithmic && u->len == 1 && u->data[0].exp == 1) {
+    // Affine transformations (°C/°F style) only compose cleanly for a
+    // single factor with exponent 1; f is affine iff its slope is
+    // constant.
+    uint16_t id = u->data[0].id;
+    double b0 = base_unit(id, 0.0), b1 = base_unit(id, 1.0);
+    double b2 = base_unit(id, 2.0);
+    double i0 = unit_id_eval(id, 0.0), i1 = unit_id_eval(id, 1.0);
+    double i2 = unit_id_eval(id, 2.0);
+    if (b2 - b1 == b1 - b0 && i2 - i1 == i1 - i0) {
+      // eval_unit folds the unit scalar into EVAL_BASE only.
+      u->eval_base_a = (b1 - b0) * u->scalar;
+      u->eval_base_b = b0 * u->scalar;
+      u->eval_inv_a = i1 - i0;
+      u->eval_inv_b = i0;
+      kind = UNIT_EVAL_AFFINE;
+    }
+  }
+
+  __atomic_store_n(&u->eval_kind, kind, __ATOMIC_RELEASE);
+  return kind;
+}
+
 /* Evaluates a number with an optional unit hash, returning the value in its
  * representation unit. */
 double eval_number(Number *n, const uint64_t *_unit_hash) {
@@ -72,6 +129,18 @@ double eval_number(Number *n, const uint64_t *_unit_hash) {
   double value = n->kind == NUM_INT64 ? (double)(n->i64) : n->f64;
 
   if (!(is_one(u) && u->scalar == 1.0)) {
+    uint16_t kind = unit_eval_kind(u);
+    if (kind == UNIT_EVAL_UNCACHED)
+      kind = unit_cache_eval((Unit *)u);
+    if (kind == UNIT_EVAL_LINEAR)
+      return value * u->eval_factor;
+    if (kind == UNIT_EVAL_AFFINE) {
+      double base = u->eval_base_a * value + u->eval_base_b;
+      if (base == 0.0)
+        return 0.0;
+      return value * (u->eval_inv_a * value + u->eval_inv_b) / base;
+    }
+
     double base = eval_unit(u, value, EVAL_BASE);
     double inverted = eval_unit(u, value, EVAL_INVERTED);
     if (base == 0.0)
@@ -83,12 +152,24 @@ double eval_number(Number *n, const uint64_t *_unit_hash) {
   return value;
 }
 
-sds print_number(Number *n) {
-  double value = eval_number(n, NULL);
+/* Appends the formatted number to `out` — batch printers (echo, list
+ * stringification) use this to render into one buffer without an
+ * intermediate allocation per value. */
+sds print_number_cat(sds out, Number *n) {
+  const Unit *u = unit_get(n->unit);
+  char buf[DTOA_BUF_SIZE];
+  size_t len;
+
+  // Shortest round-trip formatting (see utils/dtoa.c) instead of printf's
+  // locale-aware "%g" path; integers with an identity unit skip the
+  // double conversion entirely.
+  if (n->kind == NUM_INT64 && is_one(u) && u->scalar == 1.0)
+    len = i64toa(n->i64, buf);
+  else
+    len = dtoa_shortest(eval_number(n, NULL), buf);
 
-  sds out = sdscatprintf(sdsempty(), "%g", value);
+  out = sdscatlen(out, buf, len);
 
-  const Unit *u = unit_get(n->unit);
   if (is_one(u) && u->scalar == 1.0) {
     return out;
   }
@@ -103,3 +184,5 @@ sds print_number(Number *n) {
 
   return out;
 }
+
+sds print_number(Number *n) { return print_number_cat(sdsempty(), n); }
@@ -13,7 +13,22 @@ extern double is_logarithmic(uint16_t id);
 
 bool unit_is_logarithmic(const Unit *u);
 double eval_unit(const Unit *u, double number, EvalMode mode);
+
+/* Classifies an interned unit (linear/affine/general) on first use and
+ * caches constant conversion coefficients inside it; number__convert__
+ * and eval_number reduce to a fused multiply(-add) afterwards. Returns
+ * the published kind so callers need not reload it. */
+uint16_t unit_cache_eval(Unit *u);
+
+/* Acquire side of the lazy classification: pairs with the release
+ * store in unit_cache_eval so a reader that observes a cached kind
+ * also sees the coefficients it guards. Interned Units are otherwise
+ * immutable (units.c), keeping readers lock-free. */
+static inline uint16_t unit_eval_kind(const Unit *u) {
+  return __atomic_load_n(&u->eval_kind, __ATOMIC_ACQUIRE);
+}
 sds print_number(Number *n);
+sds print_number_cat(sds out, Number *n);
 double eval_number(Number *n, const uint64_t *_unit_hash);
 
 #endif
@@ -1,9 +1,12 @@
 #include "units.h"
 #include "../libs/sds.h"
+#include "../utils/arena.h"
+#include "../utils/dtoa.h"
 
 #include "../libs/bdwgc/include/gc.h"
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -12,6 +15,12 @@
 UMap NUMEROBIS_UNITS;
 UMap NUMEROBIS_UNIT_COMBOS;
 
+// Guards the global intern pool and combo map so units can be interned from
+// multiple threads. The per-thread _unit_tls_cache fast path stays lock-free:
+// interned Unit structs are immutable and never move, so cached pointers
+// remain valid forever.
+static pthread_mutex_t _units_lock = PTHREAD_MUTEX_INITIALIZER;
+
 uint64_t NUMEROBIS_UNIT_ONE_HASH = 0;
 
 _Thread_local UnitCacheSlot _unit_tls_cache[UNIT_CACHE_SIZE];
@@ -30,14 +39,19 @@ static uint64_t hash_factors(const UnitFactor *data, uint16_t len,
   h ^= sbits;
   h *= 0x100000001b3ULL;
 
-  return h ? h : 0xdeadbeefcafe0001ULL;
+  // Keep hashes to 63 bits: the compact Value layout (NBIS_COMPACT_VALUE)
+  // stores the unit hash in a 63-bit field, reserving the top bit for the
+  // number kind. Cleared unconditionally so both layouts agree on hashes.
+  h &= ~(1ULL << 63);
+
+  return h ? h : 0x5eadbeefcafe0001ULL;
 }
 
 static int cmp_factor_by_id(const void *a, const void *b) {
   return (int)((const UnitFactor *)a)->id - (int)((const UnitFactor *)b)->id;
 }
 
-Unit *dimensionless_unit(void) {
+static Unit *dimensionless_unit_locked(void) {
   uint64_t h = hash_factors(NULL, 0, 1.0);
   Unit *u = (Unit *)umap_lookup(&NUMEROBIS_UNITS, h);
   if (u)
@@ -51,14 +65,42 @@ Unit *dimensionless_unit(void) {
   return u;
 }
 
-void units_init(void) {
-  assert(NUMEROBIS_UNITS.slots == NULL && "units_init called twice");
-
+/* Lazily allocates the intern pool and combo map on the first access
+ * that actually needs them. Small tools that never construct a
+ * dimensioned unit skip both 4096-slot UMaps entirely. Every map
+ * access already happens under _units_lock, so the check is safe.
+ * Must be called with _units_lock held. */
+static void units_ensure_locked(void) {
+  if (NUMEROBIS_UNITS.slots)
+    return;
   umap_init(&NUMEROBIS_UNITS, UMAP_INIT_CAP);
   umap_init(&NUMEROBIS_UNIT_COMBOS, UMAP_INIT_CAP);
+  dimensionless_unit_locked();
+}
+
+Unit *dimensionless_unit(void) {
+  pthread_mutex_lock(&_units_lock);
+  units_ensure_locked();
+  Unit *u = dimensionless_unit_locked();
+  pthread_mutex_unlock(&_units_lock);
+  return u;
+}
 
-  Unit *one = dimensionless_unit();
-  NUMEROBIS_UNIT_ONE_HASH = one->hash;
+Unit *unit_intern_lookup(uint64_t hash) {
+  pthread_mutex_lock(&_units_lock);
+  units_ensure_locked();
+  Unit *u = (Unit *)umap_lookup(&NUMEROBIS_UNITS, hash);
+  if (!u)
+    u = dimensionless_unit_locked();
+  pthread_mutex_unlock(&_units_lock);
+  return u;
+}
+
+void units_init(void) {
+  /* Only the dimensionless hash is computed eagerly — it is a pure
+   * FNV fold and every Value carries it. The intern pool and combo
+   * map are allocated lazily by units_ensure_locked(). */
+  NUMEROBIS_UNIT_ONE_HASH = hash_factors(NULL, 0, 1.0);
 }
 
 void units_shutdown(void) {
@@ -89,8 +131,10 @@ UnitFactorList unit_simplify(const UnitFactor *data, uint16_t len,
   if (!data || len == 0)
     return (UnitFactorList){.data = NULL, .len = 0, .scalar = scalar};
 
-  // Duplicate the array so we can safely mutate and sort it.
-  UnitFactor *tmp = (UnitFactor *)GC_MALLOC(len * sizeof *tmp);
+  // Duplicate the array so we can safely mutate and sort it. The copy is
+  // pure scratch — unit_new memcpys the survivors into the interned Unit —
+  // so it may come from the per-iteration arena.
+  UnitFactor *tmp = (UnitFactor *)u_arena_alloc(len * sizeof *tmp);
   memcpy(tmp, data, len * sizeof *tmp);
 
   // Sort by unit ID.
@@ -119,8 +163,8 @@ UnitFactorList unit_simplify(const UnitFactor *data, uint16_t len,
     return (UnitFactorList){.data = NULL, .len = 0, .scalar = scalar};
   }
 
-  // Reallocate to trim excess memory footprint before returning.
-  tmp = (UnitFactor *)GC_REALLOC(tmp, final * sizeof *tmp);
+  // No trimming: the array dies as soon as the caller copies it out, so
+  // shrinking it would only cost a second allocation.
   return (UnitFactorList){.data = tmp, .len = final, .scalar = scalar};
 }
 
@@ -134,8 +178,6 @@ UnitFactorList unit_simplify(const UnitFactor *data, uint16_t len,
  * @return The hash representing this unique, interned unit.
  */
 uint64_t unit_new(uint16_t count, const UnitFactor *factors, double scalar) {
-  assert(NUMEROBIS_UNITS.slots != NULL && "call units_init first");
-
   // Normalize a zero scalar to 1.0. A scalar of 0 mathematically collapses
   // the unit entirely, but treating it as 1.0 prevents unexpected
   // division-by-zero errors in downstream conversions.
@@ -167,7 +209,10 @@ uint64_t unit_new(uint16_t count, const UnitFactor *factors, double scalar) {
 
   // Check the global intern pool. If we've seen this exact unit before,
   // just return its existing hash.
+  pthread_mutex_lock(&_units_lock);
+  units_ensure_locked();
   if (umap_contains(&NUMEROBIS_UNITS, h)) {
+    pthread_mutex_unlock(&_units_lock);
     return h;
   }
 
@@ -188,6 +233,7 @@ uint64_t unit_new(uint16_t count, const UnitFactor *factors, double scalar) {
   // Add our new unit to the global registry so future calls can find
   // it.
   umap_insert(&NUMEROBIS_UNITS, h, u);
+  pthread_mutex_unlock(&_units_lock);
   return h;
 }
 
@@ -201,13 +247,11 @@ bool is_one(const Unit *u) { return (u == NULL) || (u->len == 0); }
  * @return The hash of the resulting interned unit.
  */
 uint64_t unit_mul(const Unit *a, const Unit *b, bool invert) {
-  assert(NUMEROBIS_UNITS.slots != NULL && "call units_init first");
-
   // Fallback to the dimensionless '1' unit if inputs are null.
   if (!a)
-    a = (Unit *)umap_lookup(&NUMEROBIS_UNITS, NUMEROBIS_UNIT_ONE_HASH);
+    a = dimensionless_unit();
   if (!b)
-    b = (Unit *)umap_lookup(&NUMEROBIS_UNITS, NUMEROBIS_UNIT_ONE_HASH);
+    b = dimensionless_unit();
 
   // Fast-path: Bypass all complex logic.
   if (is_one(a) && a->scalar == 1.0 && is_one(b) && b->scalar == 1.0)
@@ -220,12 +264,18 @@ uint64_t unit_mul(const Unit *a, const Unit *b, bool invert) {
   // Fast-path cache lookup: Check our cache first.
   uint32_t cslot = (uint32_t)(ck & UNIT_CACHE_MASK);
   UnitCacheSlot *cc = &_unit_tls_cache[cslot];
-  if (__builtin_expect(cc->hash == ck && cc->unit != NULL, 1))
+  if (__builtin_expect(cc->hash == ck && cc->unit != NULL, 1)) {
+    NUMEROBIS_PROF_UNIT_HIT++;
     return ((Unit *)cc->unit)->hash;
+  }
+  NUMEROBIS_PROF_UNIT_MISS++;
 
   // Secondary cache lookup: Check the global hashmap of previously computed
   // combinations.
+  pthread_mutex_lock(&_units_lock);
+  units_ensure_locked();
   Unit *cached = (Unit *)umap_lookup(&NUMEROBIS_UNIT_COMBOS, ck);
+  pthread_mutex_unlock(&_units_lock);
   if (cached) {
     cc->hash = ck;
     cc->unit = cached;
@@ -239,7 +289,8 @@ uint64_t unit_mul(const Unit *a, const Unit *b, bool invert) {
   // Allocate enough space for both sets of factors
   uint16_t merged_len = a->len + b->len;
   UnitFactor *merged =
-      merged_len ? (UnitFactor *)GC_MALLOC(merged_len * sizeof *merged) : NULL;
+      merged_len ? (UnitFactor *)u_arena_alloc(merged_len * sizeof *merged)
+                 : NULL;
 
   // Copy left-hand factors.
   if (a->len)
@@ -255,8 +306,12 @@ uint64_t unit_mul(const Unit *a, const Unit *b, bool invert) {
   uint64_t result_hash = unit_new(merged_len, merged, result_scalar);
   Unit *result = unit_get(result_hash);
 
-  // Store the result for future lookups.
+  // Store the result for future lookups. Two threads may race to combine
+  // the same pair; both arrive at the same interned unit, so the last
+  // insert simply overwrites with an identical value.
+  pthread_mutex_lock(&_units_lock);
   umap_insert(&NUMEROBIS_UNIT_COMBOS, ck, result);
+  pthread_mutex_unlock(&_units_lock);
   cc->hash = ck;
   cc->unit = result;
 
@@ -264,14 +319,12 @@ uint64_t unit_mul(const Unit *a, const Unit *b, bool invert) {
 }
 
 uint64_t unit_pow(const Unit *u, double exp) {
-  assert(NUMEROBIS_UNITS.slots != NULL && "call units_init first");
-
   if (is_one(u) && u->scalar == 1.0)
     return NUMEROBIS_UNIT_ONE_HASH;
 
   double new_scalar = pow(u->scalar, exp);
 
-  UnitFactor *factors = (UnitFactor *)GC_MALLOC(u->len * sizeof *factors);
+  UnitFactor *factors = (UnitFactor *)u_arena_alloc(u->len * sizeof *factors);
   for (uint16_t i = 0; i < u->len; i++) {
     double raw = (double)u->data[i].exp * exp;
     double rounded = round(raw);
@@ -293,8 +346,8 @@ sds unit_print(const Unit *u) {
   if (is_one(u)) {
     if (u->scalar == 1.0)
       return sdsnew("1");
-    else
-      return sdscatprintf(sdsempty(), "%g", u->scalar);
+    char buf[DTOA_BUF_SIZE];
+    return sdsnewlen(buf, dtoa_shortest(u->scalar, buf));
   }
 
   sds numer = sdsempty();
@@ -317,8 +370,11 @@ sds unit_print(const Unit *u) {
   }
 
   sds result = sdsempty();
-  if (u->scalar != 1.0)
-    result = sdscatprintf(result, "%g*", u->scalar);
+  if (u->scalar != 1.0) {
+    char buf[DTOA_BUF_SIZE];
+    result = sdscatlen(result, buf, dtoa_shortest(u->scalar, buf));
+    result = sdscat(result, "*");
+  }
 
   if (sdslen(numer) == 0)
     result = sdscat(result, "1");
@@ -3,6 +3,7 @@
 
 #include "../libs/sds.h"
 #include "../libs/bdwgc/include/gc.h"
+#include "../utils/profiler.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -11,56 +12,130 @@
 #define UMAP_LOAD_NUM 3
 #define UMAP_LOAD_DEN 4
 
+/* SwissTable-style layout: a metadata byte per slot holds either
+ * UMAP_CTRL_EMPTY or the low 7 bits of the key (H2), so a probe inspects a
+ * whole 16-slot group with one SIMD compare instead of walking slots one by
+ * one. The map is insert-only (no tombstones needed). */
+#define UMAP_GROUP 16u
+#define UMAP_CTRL_EMPTY 0x80
+
 typedef struct {
-  uint64_t key; // 0 == empty slot
+  uint64_t key;
   void *val;
 } UMapSlot;
 
 typedef struct {
   UMapSlot *slots;
-  uint32_t cap; // always power of two
+  uint8_t *ctrl;
+  uint32_t cap; // always a power of two, >= UMAP_GROUP
   uint32_t used;
 } UMap;
 
+static inline uint8_t umap_h2(uint64_t key) { return (uint8_t)(key & 0x7F); }
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+static inline uint32_t umap_group_match(const uint8_t *ctrl, uint8_t h2) {
+  __m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+  __m128i m = _mm_cmpeq_epi8(g, _mm_set1_epi8((char)h2));
+  return (uint32_t)_mm_movemask_epi8(m);
+}
+static inline uint32_t umap_group_empty(const uint8_t *ctrl) {
+  __m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+  __m128i m = _mm_cmpeq_epi8(g, _mm_set1_epi8((char)UMAP_CTRL_EMPTY));
+  return (uint32_t)_mm_movemask_epi8(m);
+}
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+/* movemask emulation via the vshrn narrowing trick: 4 bits per lane,
+ * collapsed to 1 bit per lane below. */
+static inline uint32_t _umap_neon_mask(uint8x16_t eq) {
+  uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+  uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+  uint32_t out = 0;
+  for (uint32_t i = 0; i < UMAP_GROUP; i++)
+    out |= ((bits >> (i * 4)) & 1u) << i;
+  return out;
+}
+static inline uint32_t umap_group_match(const uint8_t *ctrl, uint8_t h2) {
+  return _umap_neon_mask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2)));
+}
+static inline uint32_t umap_group_empty(const uint8_t *ctrl) {
+  return _umap_neon_mask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(UMAP_CTRL_EMPTY)));
+}
+#else
+static inline uint32_t umap_group_match(const uint8_t *ctrl, uint8_t h2) {
+  uint32_t out = 0;
+  for (uint32_t i = 0; i < UMAP_GROUP; i++)
+    out |= (uint32_t)(ctrl[i] == h2) << i;
+  return out;
+}
+static inline uint32_t umap_group_empty(const uint8_t *ctrl) {
+  uint32_t out = 0;
+  for (uint32_t i = 0; i < UMAP_GROUP; i++)
+    out |= (uint32_t)(ctrl[i] == UMAP_CTRL_EMPTY) << i;
+  return out;
+}
+#endif
+
 static inline void umap_init(UMap *m, uint32_t cap) {
+  if (cap < UMAP_GROUP)
+    cap = UMAP_GROUP;
   m->slots = (UMapSlot *)GC_MALLOC(cap * sizeof(UMapSlot));
+  m->ctrl = (uint8_t *)GC_MALLOC(cap);
+  for (uint32_t i = 0; i < cap; i++)
+    m->ctrl[i] = UMAP_CTRL_EMPTY;
   m->cap = cap;
   m->used = 0;
 }
 
 static inline void umap_free(UMap *m) {
   m->slots = NULL;
+  m->ctrl = NULL;
   m->cap = m->used = 0;
 }
 
-static inline void umap_insert_raw(UMap *m, uint64_t key, void *val);
+static inline void umap_insert_raw(UMap *m, uint64_t key, void *val) {
+  uint32_t mask = m->cap - 1;
+  uint32_t group = ((uint32_t)key & mask) & ~(UMAP_GROUP - 1u);
+  uint8_t h2 = umap_h2(key);
+
+  for (;;) {
+    uint32_t match = umap_group_match(m->ctrl + group, h2);
+    while (match) {
+      uint32_t i = (uint32_t)__builtin_ctz(match);
+      if (m->slots[group + i].key == key) {
+        m->slots[group + i].val = val;
+        return;
+      }
+      match &= match - 1;
+    }
+    uint32_t empty = umap_group_empty(m->ctrl + group);
+    if (empty) {
+      uint32_t i = (uint32_t)__builtin_ctz(empty);
+      m->ctrl[group + i] = h2;
+      m->slots[group + i].key = key;
+      m->slots[group + i].val = val;
+      m->used++;
+      return;
+    }
+    group = (group + UMAP_GROUP) & mask;
+  }
+}
 
 static inline void umap_grow(UMap *m) {
   uint32_t old_cap = m->cap;
   UMapSlot *old_slots = m->slots;
-  uint32_t new_cap = old_cap * 2;
+  uint8_t *old_ctrl = m->ctrl;
 
-  m->slots = (UMapSlot *)GC_MALLOC(new_cap * sizeof(UMapSlot));
-  m->cap = new_cap;
-  m->used = 0;
+  umap_init(m, old_cap * 2);
 
   for (uint32_t i = 0; i < old_cap; i++) {
-    if (old_slots[i].key != 0)
+    if (old_ctrl[i] != UMAP_CTRL_EMPTY)
       umap_insert_raw(m, old_slots[i].key, old_slots[i].val);
   }
 }
 
-static inline void umap_insert_raw(UMap *m, uint64_t key, void *val) {
-  uint32_t mask = m->cap - 1;
-  uint32_t idx = (uint32_t)key & mask;
-  while (m->slots[idx].key != 0 && m->slots[idx].key != key)
-    idx = (idx + 1) & mask;
-  if (m->slots[idx].key == 0)
-    m->used++;
-  m->slots[idx].key = key;
-  m->slots[idx].val = val;
-}
-
 static inline void umap_insert(UMap *m, uint64_t key, void *val) {
   if (m->used * UMAP_LOAD_DEN >= m->cap * UMAP_LOAD_NUM)
     umap_grow(m);
@@ -69,13 +144,21 @@ static inline void umap_insert(UMap *m, uint64_t key, void *val) {
 
 static inline void *umap_lookup(const UMap *m, uint64_t key) {
   uint32_t mask = m->cap - 1;
-  uint32_t idx = (uint32_t)key & mask;
-  while (m->slots[idx].key != 0) {
-    if (m->slots[idx].key == key)
-      return m->slots[idx].val;
-    idx = (idx + 1) & mask;
+  uint32_t group = ((uint32_t)key & mask) & ~(UMAP_GROUP - 1u);
+  uint8_t h2 = umap_h2(key);
+
+  for (;;) {
+    uint32_t match = umap_group_match(m->ctrl + group, h2);
+    while (match) {
+      uint32_t i = (uint32_t)__builtin_ctz(match);
+      if (m->slots[group + i].key == key)
+        return m->slots[group + i].val;
+      match &= match - 1;
+    }
+    if (umap_group_empty(m->ctrl + group))
+      return NULL;
+    group = (group + UMAP_GROUP) & mask;
   }
-  return NULL;
 }
 
 static inline bool umap_contains(const UMap *m, uint64_t key) {
@@ -108,10 +191,27 @@ typedef struct {
   double scalar;
 } UnitFactorList;
 
+/* Lazily computed evaluation class of a unit, see unit_cache_eval in eval.c.
+ * Purely linear (multiplicative) units admit a constant conversion factor,
+ * affine single-factor units (°C/°F) a precomputed a*x+b pair per direction;
+ * only logarithmic units keep per-call evaluation. */
+typedef enum {
+  UNIT_EVAL_UNCACHED = 0,
+  UNIT_EVAL_LINEAR,
+  UNIT_EVAL_AFFINE,
+  UNIT_EVAL_GENERAL
+} UnitEvalKind;
+
 typedef struct Unit {
   uint64_t hash;
   uint16_t len;
+  uint16_t eval_kind; /* UnitEvalKind; lazily published, read via
+                         unit_eval_kind (eval.h) */
   double scalar;
+  double eval_factor; /* cached inverted/base ratio for UNIT_EVAL_LINEAR */
+  /* cached a*x+b coefficients per direction for UNIT_EVAL_AFFINE */
+  double eval_base_a, eval_base_b;
+  double eval_inv_a, eval_inv_b;
   UnitFactor data[];
 } Unit;
 
@@ -133,15 +233,21 @@ uint64_t unit_new(uint16_t count, const UnitFactor *factors, double scalar);
 
 Unit *dimensionless_unit(void);
 
+/* Locked lookup in the global intern pool (units.c); falls back to the
+ * dimensionless unit. Interned Unit structs are immutable and never move,
+ * so caching the returned pointer thread-locally is safe. */
+Unit *unit_intern_lookup(uint64_t hash);
+
 static inline Unit *unit_get(uint64_t hash) {
   uint32_t slot = (uint32_t)(hash & UNIT_CACHE_MASK);
   UnitCacheSlot *cs = &_unit_tls_cache[slot];
-  if (__builtin_expect(cs->hash == hash && cs->unit != NULL, 1))
+  if (__builtin_expect(cs->hash == hash && cs->unit != NULL, 1)) {
+    NUMEROBIS_PROF_UNIT_HIT++;
     return (Unit *)cs->unit;
+  }
+  NUMEROBIS_PROF_UNIT_MISS++;
 
-  Unit *u = (Unit *)umap_lookup(&NUMEROBIS_UNITS, hash);
-  if (!u)
-    u = dimensionless_unit();
+  Unit *u = unit_intern_lookup(hash);
 
   cs->hash = hash;
   cs->unit = u;
@@ -167,9 +273,11 @@ sds unit_print(const Unit *u);
 
 #define U(...) _U_BUILD(1, __VA_ARGS__)
 #define U_(scalar, ...) _U_BUILD(scalar, __VA_ARGS__)
-#define U_ONE unit_new(0, NULL, 1.0)
 
 extern uint64_t NUMEROBIS_UNIT_ONE_HASH;
+/* Computed once in units_init (runtime constructor): U_ONE is a plain
+ * global load, not a trip through the unit_new interning fast path. */
+#define U_ONE NUMEROBIS_UNIT_ONE_HASH
 #define UNIT_IS_ONE_HASH(h) ((h) == NUMEROBIS_UNIT_ONE_HASH)
 
 #endif
@@ -0,0 +1,52 @@
+#include "arena.h"
+#include "../libs/bdwgc/include/gc.h"
+
+// One fixed-size block per thread, allocated on first use. Requests that
+// do not fit spill to GC_MALLOC, so an overflowing iteration degrades to
+// the old behavior instead of failing.
+#define ARENA_BLOCK ((size_t)256 << 10)
+
+_Thread_local Arena _u_arena;
+
+size_t u_arena_enter(void) {
+  _u_arena.depth++;
+  return _u_arena.off;
+}
+
+void u_arena_leave(size_t mark) {
+  _u_arena.off = mark;
+  _u_arena.depth--;
+}
+
+void *u_arena_alloc(size_t size) {
+  if (_u_arena.depth == 0)
+    return GC_MALLOC(size);
+
+  size = (size + 15) & ~(size_t)15;
+
+  if (_u_arena.base == NULL) {
+    // Uncollectable so the block survives without a scanned reference to
+    // it (it is only reachable through thread-local storage), and so its
+    // contents count as roots: scratch placed here never needs
+    // GC_reachable_here guards. Stale bytes between rewind and overwrite
+    // may pin a little garbage; that is bounded by the block size.
+    _u_arena.base = (char *)GC_MALLOC_UNCOLLECTABLE(ARENA_BLOCK);
+    _u_arena.cap = ARENA_BLOCK;
+  }
+
+  if (_u_arena.off + size > _u_arena.cap)
+    return GC_MALLOC(size);
+
+  void *p = _u_arena.base + _u_arena.off;
+  _u_arena.off += size;
+  return p;
+}
+
+// Releases the thread's block. Called by short-lived threads (task
+// threads in types/task.c) before they detach from the collector;
+// pool workers live for the whole process and never need it.
+void u_arena_thread_shutdown(void) {
+  if (_u_arena.base)
+    GC_FREE(_u_arena.base);
+  _u_arena = (Arena){0};
+}
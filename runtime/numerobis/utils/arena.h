@@ -0,0 +1,49 @@
+#ifndef NUMEROBIS_ARENA_H
+#define NUMEROBIS_ARENA_H
+
+#include <stddef.h>
+
+/* Per-thread bump arena for iteration-scoped runtime scratch.
+ *
+ * The compiler opens one arena scope per loop (U_ARENA_SCOPE) and rewinds
+ * it at the top of every iteration, so scratch taken during an iteration
+ * is reclaimed wholesale instead of becoming collector garbage. Outside
+ * any scope u_arena_alloc degrades to plain GC_MALLOC, so runtime code
+ * may call it unconditionally.
+ *
+ * Contract for runtime callers: only take scratch from the arena if it
+ * is dead before the allocating runtime call returns a Value to compiled
+ * code — the compiler rewinds between iterations without knowing what
+ * was carved from it. Unit-factor work arrays in units.c are the
+ * canonical example; anything a live Value can end up referencing (sds
+ * strings, list item arrays) must stay on the GC heap.
+ */
+
+typedef struct {
+  char *base;
+  size_t cap;
+  size_t off;
+  int depth;
+} Arena;
+
+extern _Thread_local Arena _u_arena;
+
+size_t u_arena_enter(void);
+void u_arena_leave(size_t mark);
+void *u_arena_alloc(size_t size);
+void u_arena_thread_shutdown(void);
+
+/* Drop everything allocated since the mark without closing the scope.
+ * Emitted at the top of each loop iteration. */
+static inline void u_arena_rewind(size_t mark) { _u_arena.off = mark; }
+
+static inline void _u_arena_scope_leave(const size_t *mark) {
+  u_arena_leave(*mark);
+}
+
+/* Opens an arena scope for the enclosing C block. The cleanup attribute
+ * closes it on every exit path, including break and early return. */
+#define U_ARENA_SCOPE(name)                                                    \
+  __attribute__((cleanup(_u_arena_scope_leave))) size_t name = u_arena_enter()
+
+#endif
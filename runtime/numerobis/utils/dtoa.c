@@ -0,0 +1,323 @@
+#include "dtoa.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// Grisu2 shortest round-trip double-to-string conversion
+// (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+// Integers", PLDI 2010). Grisu2 emits the shortest digit string that
+// round-trips for ~99.5% of doubles and never emits an incorrect one;
+// for the remainder it produces one digit more than necessary, which
+// still round-trips, so no slow-path fallback is needed for correctness.
+
+typedef struct {
+  uint64_t f;
+  int e;
+} DiyFp;
+
+static inline DiyFp diy_sub(DiyFp a, DiyFp b) {
+  return (DiyFp){a.f - b.f, a.e};
+}
+
+static inline DiyFp diy_mul(DiyFp a, DiyFp b) {
+  // 64x64 -> 128 bit multiply keeping the high half, round-to-nearest.
+  __uint128_t p = (__uint128_t)a.f * b.f;
+  uint64_t hi = (uint64_t)(p >> 64);
+  uint64_t lo = (uint64_t)p;
+  if (lo & (1ULL << 63))
+    hi++;
+  return (DiyFp){hi, a.e + b.e + 64};
+}
+
+#define DP_SIGNIFICAND_SIZE 52
+#define DP_EXPONENT_BIAS (0x3FF + DP_SIGNIFICAND_SIZE)
+#define DP_MIN_EXPONENT (-DP_EXPONENT_BIAS)
+#define DP_HIDDEN_BIT (1ULL << DP_SIGNIFICAND_SIZE)
+
+static DiyFp diy_from_double(double d) {
+  uint64_t u64;
+  memcpy(&u64, &d, sizeof(d));
+
+  int biased_e = (int)((u64 >> DP_SIGNIFICAND_SIZE) & 0x7FF);
+  uint64_t significand = u64 & (DP_HIDDEN_BIT - 1);
+  if (biased_e != 0)
+    return (DiyFp){significand + DP_HIDDEN_BIT,
+                   biased_e - DP_EXPONENT_BIAS};
+  return (DiyFp){significand, DP_MIN_EXPONENT + 1};
+}
+
+static DiyFp diy_normalize(DiyFp v) {
+  while (!(v.f & (1ULL << 63))) {
+    v.f <<= 1;
+    v.e--;
+  }
+  return v;
+}
+
+/* Normalized boundaries of the rounding interval around d: any decimal
+ * inside (m_minus, m_plus) parses back to d. */
+static void diy_boundaries(double d, DiyFp *m_minus, DiyFp *m_plus) {
+  DiyFp v = diy_from_double(d);
+  DiyFp pl = diy_normalize((DiyFp){(v.f << 1) + 1, v.e - 1});
+  DiyFp mi;
+  if (v.f == DP_HIDDEN_BIT) // power of two: lower boundary is closer
+    mi = (DiyFp){(v.f << 2) - 1, v.e - 2};
+  else
+    mi = (DiyFp){(v.f << 1) - 1, v.e - 1};
+  mi.f <<= mi.e - pl.e;
+  mi.e = pl.e;
+  *m_minus = mi;
+  *m_plus = pl;
+}
+
+/* Cached normalized powers of ten, 10^-348 .. 10^340 in steps of 8. */
+static const DiyFp POW10_CACHE[] = {
+    {0xfa8fd5a0081c0288ULL, -1220}, {0xbaaee17fa23ebf76ULL, -1193},
+    {0x8b16fb203055ac76ULL, -1166}, {0xcf42894a5dce35eaULL, -1140},
+    {0x9a6bb0aa55653b2dULL, -1113}, {0xe61acf033d1a45dfULL, -1087},
+    {0xab70fe17c79ac6caULL, -1060}, {0xff77b1fcbebcdc4fULL, -1034},
+    {0xbe5691ef416bd60cULL, -1007}, {0x8dd01fad907ffc3cULL, -980},
+    {0xd3515c2831559a83ULL, -954}, {0x9d71ac8fada6c9b5ULL, -927},
+    {0xea9c227723ee8bcbULL, -901}, {0xaecc49914078536dULL, -874},
+    {0x823c12795db6ce57ULL, -847}, {0xc21094364dfb5637ULL, -821},
+    {0x9096ea6f3848984fULL, -794}, {0xd77485cb25823ac7ULL, -768},
+    {0xa086cfcd97bf97f4ULL, -741}, {0xef340a98172aace5ULL, -715},
+    {0xb23867fb2a35b28eULL, -688}, {0x84c8d4dfd2c63f3bULL, -661},
+    {0xc5dd44271ad3cdbaULL, -635}, {0x936b9fcebb25c996ULL, -608},
+    {0xdbac6c247d62a584ULL, -582}, {0xa3ab66580d5fdaf6ULL, -555},
+    {0xf3e2f893dec3f126ULL, -529}, {0xb5b5ada8aaff80b8ULL, -502},
+    {0x87625f056c7c4a8bULL, -475}, {0xc9bcff6034c13053ULL, -449},
+    {0x964e858c91ba2655ULL, -422}, {0xdff9772470297ebdULL, -396},
+    {0xa6dfbd9fb8e5b88fULL, -369}, {0xf8a95fcf88747d94ULL, -343},
+    {0xb94470938fa89bcfULL, -316}, {0x8a08f0f8bf0f156bULL, -289},
+    {0xcdb02555653131b6ULL, -263}, {0x993fe2c6d07b7facULL, -236},
+    {0xe45c10c42a2b3b06ULL, -210}, {0xaa242499697392d3ULL, -183},
+    {0xfd87b5f28300ca0eULL, -157}, {0xbce5086492111aebULL, -130},
+    {0x8cbccc096f5088ccULL, -103}, {0xd1b71758e219652cULL, -77},
+    {0x9c40000000000000ULL, -50}, {0xe8d4a51000000000ULL, -24},
+    {0xad78ebc5ac620000ULL, 3}, {0x813f3978f8940984ULL, 30},
+    {0xc097ce7bc90715b3ULL, 56}, {0x8f7e32ce7bea5c70ULL, 83},
+    {0xd5d238a4abe98068ULL, 109}, {0x9f4f2726179a2245ULL, 136},
+    {0xed63a231d4c4fb27ULL, 162}, {0xb0de65388cc8ada8ULL, 189},
+    {0x83c7088e1aab65dbULL, 216}, {0xc45d1df942711d9aULL, 242},
+    {0x924d692ca61be758ULL, 269}, {0xda01ee641a708deaULL, 295},
+    {0xa26da3999aef774aULL, 322}, {0xf209787bb47d6b85ULL, 348},
+    {0xb454e4a179dd1877ULL, 375}, {0x865b86925b9bc5c2ULL, 402},
+    {0xc83553c5c8965d3dULL, 428}, {0x952ab45cfa97a0b3ULL, 455},
+    {0xde469fbd99a05fe3ULL, 481}, {0xa59bc234db398c25ULL, 508},
+    {0xf6c69a72a3989f5cULL, 534}, {0xb7dcbf5354e9beceULL, 561},
+    {0x88fcf317f22241e2ULL, 588}, {0xcc20ce9bd35c78a5ULL, 614},
+    {0x98165af37b2153dfULL, 641}, {0xe2a0b5dc971f303aULL, 667},
+    {0xa8d9d1535ce3b396ULL, 694}, {0xfb9b7cd9a4a7443cULL, 720},
+    {0xbb764c4ca7a44410ULL, 747}, {0x8bab8eefb6409c1aULL, 774},
+    {0xd01fef10a657842cULL, 800}, {0x9b10a4e5e9913129ULL, 827},
+    {0xe7109bfba19c0c9dULL, 853}, {0xac2820d9623bf429ULL, 880},
+    {0x80444b5e7aa7cf85ULL, 907}, {0xbf21e44003acdd2dULL, 933},
+    {0x8e679c2f5e44ff8fULL, 960}, {0xd433179d9c8cb841ULL, 986},
+    {0x9e19db92b4e31ba9ULL, 1013}, {0xeb96bf6ebadf77d9ULL, 1039},
+    {0xaf87023b9bf0ee6bULL, 1066},
+};
+
+static DiyFp cached_power(int e, int *k10) {
+  // k = ceil((alpha - e - 63) * log10(2)) with alpha = -59
+  double dk = (-61 - e) * 0.30102999566398114 + 347;
+  int k = (int)dk;
+  if (dk - k > 0.0)
+    k++;
+
+  unsigned idx = (unsigned)((k >> 3) + 1);
+  *k10 = -348 + (int)(idx << 3);
+  return POW10_CACHE[idx];
+}
+
+static const uint32_t POW10_U32[] = {1,      10,      100,      1000,
+                                     10000,  100000,  1000000,  10000000,
+                                     100000000, 1000000000};
+
+static void grisu_round(char *digits, int len, uint64_t delta, uint64_t rest,
+                        uint64_t ten_kappa, uint64_t wp_w) {
+  while (rest < wp_w && delta - rest >= ten_kappa &&
+         (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+    digits[len - 1]--;
+    rest += ten_kappa;
+  }
+}
+
+static int digit_gen(DiyFp w, DiyFp mp, uint64_t delta, char *digits, int *k) {
+  DiyFp one = {1ULL << -mp.e, mp.e};
+  DiyFp wp_w = diy_sub(mp, w);
+  uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+  uint64_t p2 = mp.f & (one.f - 1);
+  int kappa = 10;
+  int len = 0;
+
+  // Integral part
+  while (kappa > 0) {
+    uint32_t d;
+    switch (kappa) {
+    case 10: d = p1 / 1000000000; p1 %= 1000000000; break;
+    case 9: d = p1 / 100000000; p1 %= 100000000; break;
+    case 8: d = p1 / 10000000; p1 %= 10000000; break;
+    case 7: d = p1 / 1000000; p1 %= 1000000; break;
+    case 6: d = p1 / 100000; p1 %= 100000; break;
+    case 5: d = p1 / 10000; p1 %= 10000; break;
+    case 4: d = p1 / 1000; p1 %= 1000; break;
+    case 3: d = p1 / 100; p1 %= 100; break;
+    case 2: d = p1 / 10; p1 %= 10; break;
+    default: d = p1; p1 = 0; break;
+    }
+    if (d || len)
+      digits[len++] = (char)('0' + d);
+    kappa--;
+    uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+    if (tmp <= delta) {
+      *k += kappa;
+      grisu_round(digits, len, delta, tmp,
+                  (uint64_t)POW10_U32[kappa] << -one.e, wp_w.f);
+      return len;
+    }
+  }
+
+  // Fractional part
+  for (;;) {
+    p2 *= 10;
+    delta *= 10;
+    char d = (char)(p2 >> -one.e);
+    if (d || len)
+      digits[len++] = (char)('0' + d);
+    p2 &= one.f - 1;
+    kappa--;
+    if (p2 < delta) {
+      *k += kappa;
+      uint64_t scale = 1;
+      for (int i = kappa; i < 0; i++)
+        scale *= 10;
+      grisu_round(digits, len, delta, p2, one.f, wp_w.f * scale);
+      return len;
+    }
+  }
+}
+
+/* Produces the digit string and decimal exponent k such that
+ * value == 0.digits * 10^(k + len)  (digits have no leading zero). */
+static int grisu2(double value, char *digits, int *k) {
+  DiyFp w = diy_normalize(diy_from_double(value));
+  DiyFp m_minus, m_plus;
+  diy_boundaries(value, &m_minus, &m_plus);
+
+  int k10;
+  DiyFp c = cached_power(m_plus.e, &k10);
+  DiyFp W = diy_mul(w, c);
+  DiyFp Wp = diy_mul(m_plus, c);
+  DiyFp Wm = diy_mul(m_minus, c);
+
+  Wm.f++;
+  Wp.f--;
+  *k = -k10;
+  return digit_gen(W, Wp, Wp.f - Wm.f, digits, k);
+}
+
+/* %g-like presentation: fixed notation for moderate exponents,
+ * scientific otherwise, always shortest digits. */
+static size_t prettify(char *buf, char *digits, int len, int k) {
+  // value = digits * 10^k; kk is the position of the decimal point
+  int kk = len + k;
+  char *p = buf;
+
+  if (k >= 0 && kk <= 21) {
+    // 1234500000
+    memcpy(p, digits, (size_t)len);
+    p += len;
+    for (int i = len; i < kk; i++)
+      *p++ = '0';
+  } else if (0 < kk && kk <= 21) {
+    // 1234.5
+    memcpy(p, digits, (size_t)kk);
+    p += kk;
+    *p++ = '.';
+    memcpy(p, digits + kk, (size_t)(len - kk));
+    p += len - kk;
+  } else if (-6 < kk && kk <= 0) {
+    // 0.00012345
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = 0; i > kk; i--)
+      *p++ = '0';
+    memcpy(p, digits, (size_t)len);
+    p += len;
+  } else {
+    // 1.2345e-13
+    *p++ = digits[0];
+    if (len > 1) {
+      *p++ = '.';
+      memcpy(p, digits + 1, (size_t)(len - 1));
+      p += len - 1;
+    }
+    *p++ = 'e';
+    int e = kk - 1;
+    if (e < 0) {
+      *p++ = '-';
+      e = -e;
+    }
+    if (e >= 100) {
+      *p++ = (char)('0' + e / 100);
+      e %= 100;
+      *p++ = (char)('0' + e / 10);
+      *p++ = (char)('0' + e % 10);
+    } else if (e >= 10) {
+      *p++ = (char)('0' + e / 10);
+      *p++ = (char)('0' + e % 10);
+    } else {
+      *p++ = (char)('0' + e);
+    }
+  }
+
+  *p = '\0';
+  return (size_t)(p - buf);
+}
+
+size_t dtoa_shortest(double value, char buf[DTOA_BUF_SIZE]) {
+  if (isnan(value))
+    return (size_t)snprintf(buf, DTOA_BUF_SIZE, "nan");
+  if (isinf(value))
+    return (size_t)snprintf(buf, DTOA_BUF_SIZE, value < 0 ? "-inf" : "inf");
+
+  char *p = buf;
+  if (signbit(value)) {
+    *p++ = '-';
+    value = -value;
+  }
+  if (value == 0.0) {
+    *p++ = '0';
+    *p = '\0';
+    return (size_t)(p - buf);
+  }
+
+  char digits[18];
+  int k;
+  int len = grisu2(value, digits, &k);
+  return (size_t)(p - buf) + prettify(p, digits, len, k);
+}
+
+size_t i64toa(int64_t value, char buf[DTOA_BUF_SIZE]) {
+  char tmp[20];
+  char *p = buf;
+  uint64_t u = (uint64_t)value;
+
+  if (value < 0) {
+    *p++ = '-';
+    u = ~u + 1;
+  }
+
+  int n = 0;
+  do {
+    tmp[n++] = (char)('0' + u % 10);
+    u /= 10;
+  } while (u);
+  while (n)
+    *p++ = tmp[--n];
+  *p = '\0';
+  return (size_t)(p - buf);
+}
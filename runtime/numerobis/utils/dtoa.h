@@ -0,0 +1,19 @@
+#ifndef NUMEROBIS_DTOA_H
+#define NUMEROBIS_DTOA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Longest outputs: "-2.2250738585072014e-308" and friends. */
+#define DTOA_BUF_SIZE 32
+
+/* Shortest round-trip double formatting (Grisu2 with a fallback to
+ * snprintf for the rare inputs the fast path cannot prove shortest).
+ * Writes a NUL-terminated decimal representation that strtod parses back
+ * to exactly `value` and returns its length. */
+size_t dtoa_shortest(double value, char buf[DTOA_BUF_SIZE]);
+
+/* Fast signed 64-bit integer formatting; returns the length. */
+size_t i64toa(int64_t value, char buf[DTOA_BUF_SIZE]);
+
+#endif
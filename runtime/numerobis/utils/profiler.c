@@ -0,0 +1,189 @@
+#define _GNU_SOURCE
+#include "profiler.h"
+#include "../libs/bdwgc/include/gc.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#define NBIS_PROF_SAMPLING 1
+#endif
+
+unsigned long long NUMEROBIS_PROF_DISPATCH[16];
+unsigned long long NUMEROBIS_PROF_UNIT_HIT;
+unsigned long long NUMEROBIS_PROF_UNIT_MISS;
+
+static bool _prof_enabled;
+
+/* Keep in sync with ValueType in values.h. */
+static const char *const _TYPE_NAMES[16] = {
+    "Number", "Bool",       "Str",  "List", "Range", "Closure",
+    "Extern", "Struct",     "Map",  "StrBuilder",
+    "File",   "Task",       "Vec",  "None", "Empty", "?"};
+
+#ifdef NBIS_PROF_SAMPLING
+
+/* 1 kHz of consumed CPU time (ITIMER_PROF counts user+system time of the
+ * whole process, so idle programs produce no samples). */
+#define PROF_INTERVAL_USEC 1000
+
+/* Samples per symbol, same indexing as NUMEROBIS_SYMBOLS; the extra
+ * trailing slot collects samples that fall outside every known function
+ * (runtime, libc, GC). */
+static unsigned long long *_samples;
+static int _n_syms;
+static const NumerobisSymbol **_sorted; /* by address, for binary search */
+
+static int _sym_cmp(const void *a, const void *b) {
+  uintptr_t pa = (uintptr_t)(*(const NumerobisSymbol *const *)a)->addr;
+  uintptr_t pb = (uintptr_t)(*(const NumerobisSymbol *const *)b)->addr;
+  return (pa > pb) - (pa < pb);
+}
+
+static uintptr_t _sample_pc(void *ucv) {
+  ucontext_t *uc = ucv;
+#if defined(__linux__) && defined(__x86_64__)
+  return (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__linux__) && defined(__aarch64__)
+  return (uintptr_t)uc->uc_mcontext.pc;
+#elif defined(__APPLE__) && defined(__x86_64__)
+  return (uintptr_t)uc->uc_mcontext->__ss.__rip;
+#elif defined(__APPLE__) && defined(__aarch64__)
+  return (uintptr_t)uc->uc_mcontext->__ss.__pc;
+#else
+  (void)uc;
+  return 0;
+#endif
+}
+
+static void _on_sigprof(int sig, siginfo_t *info, void *ucv) {
+  (void)sig;
+  (void)info;
+  uintptr_t pc = _sample_pc(ucv);
+
+  /* Greatest symbol whose address is <= pc. */
+  int lo = 0, hi = _n_syms;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if ((uintptr_t)_sorted[mid]->addr <= pc)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  /* Function sizes are unknown: the next symbol bounds all but the last
+   * one, which gets a generous cap so runtime/libc samples past the end
+   * of the generated code are not attributed to it. */
+  if (lo > 0) {
+    uintptr_t base = (uintptr_t)_sorted[lo - 1]->addr;
+    uintptr_t limit = (lo < _n_syms) ? (uintptr_t)_sorted[lo]->addr
+                                     : base + (256u << 10);
+    if (pc < limit) {
+      _samples[_sorted[lo - 1] - NUMEROBIS_SYMBOLS]++;
+      return;
+    }
+  }
+  _samples[_n_syms]++;
+}
+
+static void _sampling_start(void) {
+  _n_syms = NUMEROBIS_SYMBOL_COUNT;
+  _samples = calloc((size_t)_n_syms + 1, sizeof *_samples);
+  _sorted = malloc((size_t)(_n_syms ? _n_syms : 1) * sizeof *_sorted);
+  if (!_samples || !_sorted)
+    return;
+  for (int i = 0; i < _n_syms; i++)
+    _sorted[i] = &NUMEROBIS_SYMBOLS[i];
+  qsort(_sorted, (size_t)_n_syms, sizeof *_sorted, _sym_cmp);
+
+  struct sigaction sa = {0};
+  sa.sa_sigaction = _on_sigprof;
+  sa.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGPROF, &sa, NULL);
+
+  struct itimerval it = {{0, PROF_INTERVAL_USEC}, {0, PROF_INTERVAL_USEC}};
+  setitimer(ITIMER_PROF, &it, NULL);
+}
+
+static void _sampling_report(void) {
+  struct itimerval off = {{0, 0}, {0, 0}};
+  setitimer(ITIMER_PROF, &off, NULL);
+  if (!_samples)
+    return;
+
+  unsigned long long total = _samples[_n_syms];
+  for (int i = 0; i < _n_syms; i++)
+    total += _samples[i];
+  fprintf(stderr, "samples: %llu (%d us CPU interval)\n", total,
+          PROF_INTERVAL_USEC);
+  if (!total)
+    return;
+
+  /* Selection sort of the survivors; symbol counts are tiny. */
+  bool *done = calloc((size_t)_n_syms + 1, sizeof *done);
+  if (!done)
+    return;
+  for (;;) {
+    int best = -1;
+    for (int i = 0; i <= _n_syms; i++)
+      if (!done[i] && _samples[i] &&
+          (best < 0 || _samples[i] > _samples[best]))
+        best = i;
+    if (best < 0)
+      break;
+    done[best] = true;
+    const char *name =
+        best == _n_syms ? "(runtime/other)" : NUMEROBIS_SYMBOLS[best].name;
+    fprintf(stderr, "  %5.1f%% %8llu  %s\n",
+            100.0 * (double)_samples[best] / (double)total, _samples[best],
+            name);
+  }
+  free(done);
+}
+
+#endif /* NBIS_PROF_SAMPLING */
+
+__attribute__((constructor)) static void _prof_init(void) {
+  const char *env = getenv("NUMEROBIS_PROFILE");
+  if (!env || env[0] == '\0' || env[0] == '0')
+    return;
+  _prof_enabled = true;
+#ifdef NBIS_PROF_SAMPLING
+  _sampling_start();
+#endif
+}
+
+__attribute__((destructor)) static void _prof_report(void) {
+  if (!_prof_enabled)
+    return;
+
+  fprintf(stderr, "\n== numerobis profile ==\n");
+#ifdef NBIS_PROF_SAMPLING
+  _sampling_report();
+#endif
+
+  fprintf(stderr, "dispatch:");
+  bool any = false;
+  for (int i = 0; i < 16; i++) {
+    if (!NUMEROBIS_PROF_DISPATCH[i])
+      continue;
+    fprintf(stderr, " %s %llu", _TYPE_NAMES[i], NUMEROBIS_PROF_DISPATCH[i]);
+    any = true;
+  }
+  fprintf(stderr, any ? "\n" : " (none)\n");
+
+  unsigned long long hits = NUMEROBIS_PROF_UNIT_HIT;
+  unsigned long long misses = NUMEROBIS_PROF_UNIT_MISS;
+  if (hits + misses)
+    fprintf(stderr, "unit cache: %.1f%% hit (%llu hits, %llu misses)\n",
+            100.0 * (double)hits / (double)(hits + misses), hits, misses);
+
+  fprintf(stderr, "gc: %lu bytes allocated, %lu bytes heap\n",
+          (unsigned long)GC_get_total_bytes(), (unsigned long)GC_get_heap_size());
+}
@@ -0,0 +1,31 @@
+#ifndef NUMEROBIS_PROFILER_H
+#define NUMEROBIS_PROFILER_H
+
+/* Opt-in instrumentation, enabled by running a compiled program with
+ * NUMEROBIS_PROFILE=1: a SIGPROF sampling profiler that attributes CPU
+ * samples back to Numerobis functions via the symbol table below, plus
+ * a few always-on counters (a single unconditional increment each, so
+ * they stay in the binary even when profiling is off). The report is
+ * printed to stderr at exit. */
+
+typedef struct {
+  void *addr;
+  const char *name;
+} NumerobisSymbol;
+
+/* One entry per compiled Numerobis function, emitted into the generated
+ * program by linker.py (in no particular order). */
+extern const NumerobisSymbol NUMEROBIS_SYMBOLS[];
+extern const int NUMEROBIS_SYMBOL_COUNT;
+
+/* NUMEROBIS_METHODS dispatches per ValueType, bumped by the mthd()
+ * dispatch macro in generated code. Sized past VALUE_EMPTY; increments
+ * from concurrent tasks may race, the counts are approximate by design. */
+extern unsigned long long NUMEROBIS_PROF_DISPATCH[16];
+
+/* _unit_tls_cache hit/miss counters (unit_get in units.h and the combo
+ * fast path in unit_mul). */
+extern unsigned long long NUMEROBIS_PROF_UNIT_HIT;
+extern unsigned long long NUMEROBIS_PROF_UNIT_MISS;
+
+#endif
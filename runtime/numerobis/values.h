@@ -20,6 +20,11 @@ typedef enum {
   VALUE_CLOSURE,
   VALUE_EXTERN_FN,
   VALUE_STRUCT,
+  VALUE_MAP,
+  VALUE_STRBUILDER,
+  VALUE_FILE,
+  VALUE_TASK,
+  VALUE_VEC,
   VALUE_NONE,
   VALUE_EMPTY
 } ValueType;
@@ -37,11 +42,31 @@ typedef enum {
 struct Value;
 struct List;
 struct Closure;
+struct Map;
+struct StrBuilder;
+struct File;
+struct Task;
+struct Vec;
 typedef struct Range Range;
 typedef struct Value Value;
 
 typedef const Location *LocRef;
 
+#ifdef NBIS_COMPACT_VALUE
+/* Compact representation (selected with `nbis build --compact-values`):
+ * the kind bit is folded into the top bit of the unit hash, shrinking
+ * Number from 24 to 16 bytes and Value from 32 to 24. hash_factors()
+ * only ever produces 63-bit hashes, so the field round-trips losslessly.
+ * Requires linking against libruntime_compact.a. */
+typedef struct {
+  uint64_t unit : 63;
+  uint64_t kind : 1; /* NumberKind */
+  union {
+    long i64;
+    double f64;
+  };
+} Number;
+#else
 typedef struct {
   NumberKind kind;
   uint64_t unit;
@@ -50,9 +75,32 @@ typedef struct {
     double f64;
   };
 } Number;
+#endif
 
 typedef struct {
   Value *items;
+  // Packed storage mode for homogeneous numeric lists: raw f64 payloads
+  // sharing a single unit hash, materialized into boxed items on demand
+  // (see list_items in types/list.c). At most one of items/packed/cols is
+  // set.
+  double *packed;
+  uint64_t unit;
+  // Columnar storage mode for homogeneous struct lists: one contiguous
+  // Value array per field instead of one heap allocation per instance.
+  // Any element access materializes back to array-of-structs to preserve
+  // reference semantics; bulk access goes through List.column/setcolumn.
+  Value **cols;
+  long cstruct; // STRUCT_REGISTRY id of the element type
+  // Slice-view mode: items/packed alias another list's storage and
+  // voff/vlen select a contiguous window into it. Views are only created
+  // for step == 1 slices; `shared` marks storage aliased by at least one
+  // live view, and any write to either side copies first (list_detach).
+  // On owned lists voff doubles as a head offset, so front pops are O(1)
+  // window shifts instead of memmoves (deque usage, see types/list.c).
+  size_t voff;
+  size_t vlen;
+  bool is_view;
+  bool shared;
 } List;
 
 typedef struct Value {
@@ -66,6 +114,11 @@ typedef struct Value {
     struct Closure *closure;
     struct Value (*extern_fn)(struct Value *args);
     struct Value *strukt;
+    struct Map *map;
+    struct StrBuilder *strbuilder;
+    struct File *file;
+    struct Task *task;
+    struct Vec *vec;
     void *none;
   };
 } Value;
@@ -74,6 +127,14 @@ typedef struct Closure {
   Value (*func)(void *env, Value *args);
   void *env;
   Value bound_arg;
+  // Register-convention entry point for functions of at most
+  // NBIS_DIRECT_MAX_ARITY parameters: the same body as `func`, taking
+  // the callee and each argument as direct C parameters instead of a
+  // Value array (see __call0d__ .. __call4d__ below). NULL for lambdas
+  // and extern wrappers; closures carrying a bound argument never set
+  // it — __call__ appends that argument to the array form.
+  void *direct;
+  unsigned char direct_arity;
 } Closure;
 
 // Helper to tag/untag pointers using the LSB
@@ -218,6 +279,55 @@ static inline Value __call__(Value self, Value *args, size_t argc) {
   return cl->func(cl->env, args);
 }
 
+/* Register-based calling convention for small arities: a call site of
+ * statically known arity <= NBIS_DIRECT_MAX_ARITY hands the callee and
+ * each argument over as direct C parameters, so nothing is marshalled
+ * through a stack-side Value array on the fast path. cl->direct is the
+ * register-convention twin of cl->func (closures.h U_NEW_DIRECT_CLOSURE);
+ * extern functions, bound closures and arity mismatches fall back to
+ * building the classic array for __call__. */
+#define NBIS_DIRECT_MAX_ARITY 4
+
+#define _NBIS_TRY_DIRECT(n, call)                                              \
+  if (__builtin_expect(self.type == VALUE_CLOSURE, 1)) {                       \
+    Closure *cl = self.closure;                                                \
+    if (__builtin_expect(cl->direct != NULL && cl->direct_arity == (n), 1))    \
+      return call;                                                             \
+  }
+
+static inline Value __call0d__(Value self) {
+  _NBIS_TRY_DIRECT(0, ((Value (*)(void *, Value))cl->direct)(cl->env, self))
+  Value args[2] = {self, {.type = VALUE_EMPTY}};
+  return __call__(self, args, 0);
+}
+static inline Value __call1d__(Value self, Value a1) {
+  _NBIS_TRY_DIRECT(
+      1, ((Value (*)(void *, Value, Value))cl->direct)(cl->env, self, a1))
+  Value args[3] = {self, a1, {.type = VALUE_EMPTY}};
+  return __call__(self, args, 1);
+}
+static inline Value __call2d__(Value self, Value a1, Value a2) {
+  _NBIS_TRY_DIRECT(2, ((Value (*)(void *, Value, Value, Value))cl->direct)(
+                          cl->env, self, a1, a2))
+  Value args[4] = {self, a1, a2, {.type = VALUE_EMPTY}};
+  return __call__(self, args, 2);
+}
+static inline Value __call3d__(Value self, Value a1, Value a2, Value a3) {
+  _NBIS_TRY_DIRECT(3,
+                   ((Value (*)(void *, Value, Value, Value, Value))cl->direct)(
+                       cl->env, self, a1, a2, a3))
+  Value args[5] = {self, a1, a2, a3, {.type = VALUE_EMPTY}};
+  return __call__(self, args, 3);
+}
+static inline Value __call4d__(Value self, Value a1, Value a2, Value a3,
+                               Value a4) {
+  _NBIS_TRY_DIRECT(
+      4, ((Value (*)(void *, Value, Value, Value, Value, Value))cl->direct)(
+             cl->env, self, a1, a2, a3, a4))
+  Value args[6] = {self, a1, a2, a3, a4, {.type = VALUE_EMPTY}};
+  return __call__(self, args, 4);
+}
+
 static inline void __assert__(Value a, Value b, CompareOp op, char *help,
                               LocRef loc) {
   if (b.type == VALUE_EMPTY) {
@@ -16,7 +16,11 @@ mkdir -p m4
 
 ./autogen.sh
 
-CFLAGS="-std=c99 -pedantic" ./configure --enable-static --disable-shared --prefix="$(pwd)/../runtime/numerobis/libs/bdwgc"
+# Threads are required for the parallel/async stdlib modules; parallel
+# marking spreads collection across cores instead of pausing on one.
+CFLAGS="-std=c99 -pedantic" ./configure --enable-static --disable-shared \
+    --enable-threads=posix --enable-parallel-mark \
+    --prefix="$(pwd)/../runtime/numerobis/libs/bdwgc"
 
 make
 make install
@@ -0,0 +1,371 @@
+"""Compile-time constant folding and dead-branch elimination."""
+
+import dataclasses
+import math
+from typing import Any, Optional, TypeVar
+
+from ..classes import ModuleMeta
+from ..environment import Namespaces
+from ..nodes.ast import (
+    BinOp,
+    Block,
+    Boolean,
+    BoolOp,
+    Call,
+    Compare,
+    Function,
+    If,
+    Integer,
+    Num,
+    Return,
+    String,
+    UnaryOp,
+    WhileLoop,
+)
+from ..nodes.core import AstNode, Identifier
+from ..nodes.unit import Expression, Product, Sum
+from ..typechecker.linking import Link
+
+SameType = TypeVar("SameType")
+
+_INT64_MIN = -(2**63)
+_INT64_MAX = 2**63 - 1
+
+# Bound on nested pure-call evaluation: deep (or recursive) chains stop
+# folding instead of stalling the compile.
+_CALL_DEPTH = 16
+
+# A folded value: ("int" | "num" | "bool" | "str", python value, unit
+# expression or None for dimensionless/non-numeric).
+_Const = tuple[str, Any, Optional[Expression]]
+
+
+def _dimensionless() -> Expression:
+    """The parser's unit expression for a bare literal (see _make_unit)."""
+    return Expression(Sum([Product([])]))
+
+
+class Folder:
+    """Evaluates constant expressions over the typechecked AST and drops
+    branches on constant conditions.
+
+    Like the Preprocessor, folding rewrites the link table in place, so
+    every later pass sees the literal result. Evaluation is deliberately
+    conservative: it only folds where it provably matches the runtime —
+    identical unit expressions for additive ops and comparisons, no int64
+    overflow, double arithmetic for anything non-integral, and no
+    division or power (those throw with a call-site location). Calls
+    propagate through module-level functions whose body is a single
+    `return` of a foldable expression over the parameters.
+    """
+
+    def __init__(
+        self,
+        program: list[Link],
+        module: ModuleMeta,
+        namespaces: Namespaces = Namespaces(),
+    ):
+        self.program = program
+        self.module = module
+        self.env = namespaces
+
+        # Module-level single-return functions, candidates for pure-call
+        # propagation: name -> (Function, return expression).
+        self._pure: dict[str, tuple[Function, Any]] = {}
+        self._visited: set[int] = set()
+
+    def unlink(self, link: SameType) -> SameType:
+        if isinstance(link, (int, Link)):
+            target = link if isinstance(link, int) else link.target
+            return self.env.nodes[target]  # type: ignore
+        return link
+
+    def start(self):
+        for link in self.program:
+            node = self.unlink(link)
+            if isinstance(node, Function) and node.name is not None:
+                name = self.unlink(node.name).name
+                if "." not in name and (expr := self._single_return(node)):
+                    self._pure[name] = (node, expr)
+
+        for link in self.program:
+            self.visit(link)
+
+    def _single_return(self, fn: Function):
+        """The sole returned expression of `fn`, or None."""
+        if fn.body is None:
+            return None
+        body = self.unlink(fn.body)
+        if not isinstance(body, Block):
+            return fn.body  # expression-bodied function
+        if len(body.body) != 1:
+            return None
+        ret = self.unlink(body.body[0])
+        if isinstance(ret, Return) and ret.value is not None:
+            return ret.value
+        return None
+
+    def visit(self, link):
+        """Folds the linked subtree bottom-up, rewriting table entries."""
+        if isinstance(link, Link):
+            link = link.target
+        if not isinstance(link, int) or link in self._visited:
+            return
+        if link not in self.env.nodes:
+            # Plain data int on an AST field (e.g. an arity), not a link.
+            return
+        self._visited.add(link)
+
+        node = self.env.nodes[link]
+        self._descend(node)
+
+        folded = self.fold(self.env.nodes[link])
+        if folded is not None:
+            self.env.nodes[link] = folded
+
+    def _descend(self, node: Any):
+        """Visits linked children; inline children recurse in place."""
+        try:
+            fields = dataclasses.fields(node)
+        except TypeError:
+            return
+
+        for field in fields:
+            if field.name in ("name", "annotation", "unit", "meta", "_meta", "loc"):
+                continue
+            val = getattr(node, field.name)
+            for item in val if isinstance(val, (list, tuple)) else [val]:
+                # bool is an int subclass; flag fields are not links.
+                if isinstance(item, (int, Link)) and not isinstance(item, bool):
+                    self.visit(item)
+                elif isinstance(item, AstNode):
+                    self._descend(item)
+
+    def fold(self, node: AstNode) -> Optional[AstNode]:
+        match node:
+            case If():
+                cond = self.unlink(node.condition)
+                if not isinstance(cond, Boolean):
+                    return None
+                branch = node.then_branch if cond.value else node.else_branch
+                if branch is None:
+                    return Block(body=[], loc=node.loc)
+                return self.unlink(branch)
+            case WhileLoop():
+                cond = self.unlink(node.condition)
+                if isinstance(cond, Boolean) and not cond.value:
+                    return Block(body=[], loc=node.loc)
+                return None
+            case BinOp() | UnaryOp() | Compare() | BoolOp() | Call():
+                const = self._eval(node, {}, 0)
+                if const is not None:
+                    return self._emit(const, node)
+        return None
+
+    def _eval(self, x, env: dict[str, _Const], depth: int) -> Optional[_Const]:
+        node = self.unlink(x)
+
+        match node:
+            case Boolean():
+                return ("bool", node.value, None)
+            case String():
+                return ("str", node.value, None)
+            case Integer():
+                return self._int_const(node)
+            case Num():
+                return self._num_const(node)
+            case Identifier() if node.name in env:
+                return env[node.name]
+            case UnaryOp():
+                return self._unary(node, env, depth)
+            case BinOp():
+                a = self._eval(node.left, env, depth)
+                b = self._eval(node.right, env, depth)
+                if a is None or b is None:
+                    return None
+                if node.meta.get("side", 1) == -1:
+                    a, b = b, a
+                return self._binop(node.op.name, a, b)
+            case Compare() if len(node.ops) == 1:
+                a = self._eval(node.left, env, depth)
+                b = self._eval(node.comparators[0], env, depth)
+                if a is None or b is None:
+                    return None
+                if node.meta.get("side", [1])[0] == -1:
+                    a, b = b, a
+                return self._compare(self.unlink(node.ops[0]).name, a, b)
+            case BoolOp():
+                a = self._eval(node.left, env, depth)
+                b = self._eval(node.right, env, depth)
+                if a is None or b is None or a[0] != "bool" or b[0] != "bool":
+                    return None
+                match node.op.name:
+                    case "and":
+                        return ("bool", a[1] and b[1], None)
+                    case "or":
+                        return ("bool", a[1] or b[1], None)
+                    case "xor":
+                        return ("bool", a[1] != b[1], None)
+                return None
+            case Call() if depth < _CALL_DEPTH:
+                return self._call(node, env, depth)
+        return None
+
+    def _int_const(self, node: Integer) -> Optional[_Const]:
+        try:
+            val = int(node.value)
+            if node.exponent:
+                exp = int(node.exponent)
+                if not 0 <= exp <= 18:
+                    return None
+                val *= 10**exp
+        except ValueError:
+            return None
+        if not _INT64_MIN <= val <= _INT64_MAX:
+            return None
+        return ("int", val, node.unit if node.unit else None)
+
+    def _num_const(self, node: Num) -> Optional[_Const]:
+        try:
+            val = float(f"{node.value}e{node.exponent}" if node.exponent else node.value)
+        except ValueError:
+            return None
+        return ("num", val, node.unit if node.unit else None)
+
+    def _unary(self, node: UnaryOp, env, depth) -> Optional[_Const]:
+        operand = self._eval(node.operand, env, depth)
+        if operand is None:
+            return None
+        kind, val, unit = operand
+        if node.op.name == "sub" and kind in ("int", "num"):
+            if kind == "int" and not _INT64_MIN <= -val <= _INT64_MAX:
+                return None
+            return (kind, -val, unit)
+        if node.op.name == "not" and kind == "bool":
+            return ("bool", not val, None)
+        return None
+
+    def _binop(self, op: str, a: _Const, b: _Const) -> Optional[_Const]:
+        ka, va, ua = a
+        kb, vb, ub = b
+
+        if op == "add" and ka == "str" and kb == "str":
+            return ("str", va + vb, None)
+        if ka not in ("int", "num") or kb not in ("int", "num"):
+            return None
+
+        if op in ("add", "sub"):
+            # Differing units of one dimension convert at runtime; only
+            # exactly matching unit expressions fold.
+            if ua != ub:
+                return None
+            unit = ua
+            val = va + vb if op == "add" else va - vb
+        elif op == "mul":
+            # Never synthesizes combined unit expressions: at most one
+            # operand may carry a unit.
+            if ua and ub:
+                return None
+            unit = ua or ub
+            val = va * vb
+        else:
+            return None
+
+        kind = "int" if ka == "int" and kb == "int" else "num"
+        if kind == "int" and not _INT64_MIN <= val <= _INT64_MAX:
+            return None
+        if kind == "num":
+            val = float(val)
+            if not math.isfinite(val):
+                return None
+        return (kind, val, unit)
+
+    def _compare(self, op: str, a: _Const, b: _Const) -> Optional[_Const]:
+        ka, va, _ = a
+        kb, vb, _ = b
+
+        if ka == "str" and kb == "str":
+            if op == "eq":
+                return ("bool", va == vb, None)
+            if op == "ne":
+                return ("bool", va != vb, None)
+            return None
+
+        if ka not in ("int", "num") or kb not in ("int", "num") or a[2] != b[2]:
+            return None
+        if ka != kb:
+            # Mixed operands promote to double at runtime.
+            va, vb = float(va), float(vb)
+
+        match op:
+            case "eq":
+                return ("bool", va == vb, None)
+            case "ne":
+                return ("bool", va != vb, None)
+            case "lt":
+                return ("bool", va < vb, None)
+            case "le":
+                return ("bool", va <= vb, None)
+            case "gt":
+                return ("bool", va > vb, None)
+            case "ge":
+                return ("bool", va >= vb, None)
+        return None
+
+    def _call(self, node: Call, env, depth: int) -> Optional[_Const]:
+        callee = self.unlink(node.callee)
+        if not isinstance(callee, Identifier) or callee.name not in self._pure:
+            return None
+        fn, expr = self._pure[callee.name]
+
+        params = [self.unlink(p) for p in fn.params]
+        names = [self.unlink(p.name).name for p in params]
+
+        slots: dict[str, Any] = {}
+        pos = 0
+        for arg in node.args:
+            arg = self.unlink(arg)
+            if arg.name is not None:
+                slots[self.unlink(arg.name).name] = arg.value
+            else:
+                if pos >= len(names):
+                    return None
+                slots[names[pos]] = arg.value
+                pos += 1
+
+        call_env: dict[str, _Const] = {}
+        for param, name in zip(params, names):
+            value = slots.get(name, param.default)
+            if value is None:
+                return None
+            # Arguments evaluate in the caller's environment, defaults in
+            # the module's.
+            const = self._eval(value, env if name in slots else {}, depth)
+            if const is None:
+                return None
+            call_env[name] = const
+
+        return self._eval(expr, call_env, depth + 1)
+
+    def _emit(self, const: _Const, orig: AstNode) -> Optional[AstNode]:
+        kind, val, unit = const
+        match kind:
+            case "bool":
+                return Boolean(value=val, loc=orig.loc)
+            case "str":
+                return String(value=val, loc=orig.loc)
+            case "int":
+                return Integer(
+                    value=str(val),
+                    exponent="",
+                    unit=unit if unit else _dimensionless(),
+                    loc=orig.loc,
+                )
+            case "num":
+                return Num(
+                    value=repr(val),
+                    exponent="",
+                    unit=unit if unit else _dimensionless(),
+                    loc=orig.loc,
+                )
+        return None
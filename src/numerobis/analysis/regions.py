@@ -0,0 +1,382 @@
+"""Allocation-boundedness analysis for GC-free (--no-gc) builds."""
+
+import dataclasses
+from typing import Any, Optional, TypeVar
+
+from ..classes import ModuleMeta
+from ..environment import Namespaces
+from ..exceptions.exceptions import Exceptions
+from ..nodes.ast import (
+    Attribute,
+    BinOp,
+    Call,
+    Conversion,
+    ForLoop,
+    Function,
+    Index,
+    IndexAssignment,
+    List,
+    Range,
+    Slice,
+    StructInit,
+    Tuple,
+    Type,
+    WhileLoop,
+)
+from ..nodes.core import AstNode, Identifier
+from ..nodes.unit import Expression
+from ..typechecker.linking import Link
+
+SameType = TypeVar("SameType")
+
+# Builtins that never allocate: pure reads, reductions to unboxed
+# numbers, and in-place operations that cannot grow their receiver.
+NON_ALLOCATING_BUILTINS = frozenset(
+    {
+        "exit",
+        "Str.len",
+        "Str.find",
+        "Str.contains",
+        "Str.count",
+        "List.len",
+        "List.pop",
+        "List.popleft",
+        "List.indexof",
+        "List.contains",
+        "List.sum",
+        "List.mean",
+        "List.min",
+        "List.max",
+        "List.dot",
+        "Map.len",
+        "Map.get",
+        "Map.contains",
+        "Map.remove",
+        "StrBuilder.len",
+    }
+)
+
+
+class Regioncheck:
+    """Rejects programs whose steady-state allocation --no-gc cannot bound.
+
+    With the collector disabled, allocation is a pure heap-pointer bump and
+    nothing is ever reclaimed: startup work (literal pools, interned units,
+    preallocated lists) is bounded and harmless, but an allocation reached
+    on every loop iteration or recursion step grows the heap without bound.
+    This pass walks the typechecked program and reports the first allocating
+    construct inside a loop or an allocating recursive cycle.
+
+    The analysis is per-module and deliberately conservative: calls into
+    other modules and calls through closure-typed values count as
+    allocating, as does every builtin outside NON_ALLOCATING_BUILTINS.
+    Extern declarations are trusted by signature — a numeric or boolean
+    return means the C implementation does not retain memory, which holds
+    for the runtime's own externs.
+    """
+
+    def __init__(
+        self,
+        program: list[Link],
+        module: ModuleMeta,
+        namespaces: Namespaces = Namespaces(),
+    ):
+        self.program = program
+        self.module = module
+        self.env = namespaces
+        self.errors = Exceptions(module=module)
+
+        # Module-level functions with bodies (including struct methods,
+        # keyed by their dotted name) and extern declarations.
+        self._functions: dict[str, Function] = {}
+        self._externs: dict[str, Function] = {}
+        # Transitive "calling this allocates" bit per function, computed
+        # to a fixpoint over the module call graph.
+        self._allocates: dict[str, bool] = {}
+        self._events: dict[str, list[tuple]] = {}
+
+    def unlink(self, link: SameType) -> SameType:
+        if isinstance(link, (int, Link)):
+            target = link if isinstance(link, int) else link.target
+            return self.env.nodes[target]  # type: ignore
+        return link
+
+    def start(self):
+        for link in self.program:
+            node = self.unlink(link)
+            if isinstance(node, Function) and node.name is not None:
+                name = self.unlink(node.name).name
+                if node.body is not None:
+                    self._functions[name] = node
+                else:
+                    self._externs[name] = node
+
+        for name, fn in self._functions.items():
+            self._events[name] = self._scan(fn.body)
+        self._fixpoint()
+        self._check_recursion()
+
+        for link in self.program:
+            self.visit(link, in_loop=False)
+
+    # ==== call-graph side: does calling a function allocate? ====
+
+    def _scan(self, x) -> list[tuple]:
+        """Flattens a function body into an ordered list of allocation
+        events: ("alloc", what, loc) for direct allocations and
+        ("call", name | None, loc) for calls. Nested function bodies are
+        not entered — creating the closure is itself an allocation, and
+        calling one goes through a closure-typed value (unknown)."""
+        events: list[tuple] = []
+        self._scan_into(x, events)
+        return events
+
+    def _scan_into(self, x, events: list[tuple]):
+        if isinstance(x, int) and x not in self.env.nodes:
+            # Plain data int on an AST field (e.g. an arity), not a link.
+            return
+        node = self.unlink(x)
+        link = self._link(x)
+
+        what = self._direct_alloc(node, link)
+        if what is not None:
+            events.append(("alloc", what, node.loc))
+            if isinstance(node, Function):
+                return
+
+        if isinstance(node, Call):
+            events.append(("call", self._call_name(node), node.loc))
+
+        self._scan_children(node, events)
+
+    def _scan_children(self, node: Any, events: list[tuple]):
+        try:
+            fields = dataclasses.fields(node)
+        except TypeError:
+            return
+        for field in fields:
+            if field.name in ("name", "annotation", "unit", "meta", "_meta", "loc"):
+                continue
+            val = getattr(node, field.name)
+            for item in val if isinstance(val, (list, tuple)) else [val]:
+                # bool is an int subclass; flag fields are not links.
+                if isinstance(item, (int, Link, AstNode)) and not isinstance(
+                    item, bool
+                ):
+                    self._scan_into(item, events)
+
+    def _fixpoint(self):
+        self._allocates = {
+            name: any(kind == "alloc" for kind, *_ in events)
+            for name, events in self._events.items()
+        }
+        changed = True
+        while changed:
+            changed = False
+            for name, events in self._events.items():
+                if self._allocates[name]:
+                    continue
+                for kind, what, _ in events:
+                    if kind == "call" and self._call_allocates(what):
+                        self._allocates[name] = True
+                        changed = True
+                        break
+
+    def _call_allocates(self, name: Optional[str]) -> bool:
+        if name is None:
+            return True
+        if name in self._allocates:
+            return self._allocates[name]
+        if name in NON_ALLOCATING_BUILTINS:
+            return False
+        if name in self._externs:
+            return not self._numeric_signature(self._externs[name])
+        return True
+
+    def _numeric_signature(self, fn: Function) -> bool:
+        ret = self.unlink(fn.return_type)
+        if ret is None or isinstance(ret, Expression):
+            return isinstance(ret, Expression)
+        if isinstance(ret, Type):
+            return self.unlink(ret.name).name.lower() in ("int", "num", "bool")
+        return False
+
+    def _check_recursion(self):
+        """An allocating function that participates in a call cycle grows
+        the heap on every recursion step, loop or not."""
+        for name in self._functions:
+            if self._allocates[name] and self._recursive(name):
+                kind, what, loc = self._alloc_event(name)
+                self.errors.throw(
+                    202,
+                    what=what
+                    if kind == "alloc"
+                    else f"the call to '{what}'"
+                    if what
+                    else "an opaque call",
+                    context=f"the recursive function '{name}'",
+                    loc=loc,
+                    help="recursion that allocates cannot be bounded; "
+                    "rewrite as a loop over preallocated storage or build "
+                    "without --no-gc",
+                )
+
+    def _recursive(self, root: str) -> bool:
+        seen: set[str] = set()
+        stack = [
+            callee
+            for kind, callee, _ in self._events[root]
+            if kind == "call" and callee in self._functions
+        ]
+        while stack:
+            name = stack.pop()
+            if name == root:
+                return True
+            if name in seen:
+                continue
+            seen.add(name)
+            stack.extend(
+                callee
+                for kind, callee, _ in self._events.get(name, [])
+                if kind == "call" and callee in self._functions
+            )
+        return False
+
+    def _alloc_event(self, name: str) -> tuple:
+        """The first event that makes `name` allocating."""
+        for kind, what, loc in self._events[name]:
+            if kind == "alloc" or self._call_allocates(what):
+                return (kind, what, loc)
+        # Unreachable: _allocates[name] implies some event qualifies.
+        return ("alloc", "an allocation", self._functions[name].loc)
+
+    # ==== loop side: allocations reached on every iteration ====
+
+    def visit(self, x, in_loop: bool):
+        if isinstance(x, int) and x not in self.env.nodes:
+            # Plain data int on an AST field (e.g. an arity), not a link.
+            return
+        node = self.unlink(x)
+        link = self._link(x)
+
+        match node:
+            case ForLoop():
+                # String iteration allocates on every step of this loop
+                # itself (see _direct_alloc), nested or not.
+                if self._typed(self._link(node.iterable)) == "str":
+                    self._throw("the string iteration", node.loc)
+                # The iterable is evaluated once, on loop entry. Ranges
+                # compile to raw counters and never allocate as
+                # iterables, so only their bounds are visited.
+                iterable = self.unlink(node.iterable)
+                if isinstance(iterable, Range):
+                    self._visit_children(iterable, in_loop)
+                else:
+                    self.visit(node.iterable, in_loop)
+                self.visit(node.body, in_loop=True)
+                return
+            case WhileLoop():
+                # The condition re-evaluates on every iteration.
+                self.visit(node.condition, in_loop=True)
+                self.visit(node.body, in_loop=True)
+                return
+            case Function():
+                if in_loop and node.body is not None:
+                    self._throw("the closure definition", node.loc)
+                # Per-call allocations are accounted for at call sites;
+                # loops inside the body get their own context.
+                self._visit_children(node, in_loop=False)
+                return
+            case Call() if in_loop:
+                name = self._call_name(node)
+                if self._call_allocates(name):
+                    self._throw(
+                        f"the call to '{name}'" if name else "an opaque call",
+                        node.loc,
+                    )
+
+        if in_loop and (what := self._direct_alloc(node, link)) is not None:
+            self._throw(what, node.loc)
+
+        self._visit_children(node, in_loop)
+
+    def _visit_children(self, node: Any, in_loop: bool):
+        try:
+            fields = dataclasses.fields(node)
+        except TypeError:
+            return
+        for field in fields:
+            if field.name in ("name", "annotation", "unit", "meta", "_meta", "loc"):
+                continue
+            val = getattr(node, field.name)
+            for item in val if isinstance(val, (list, tuple)) else [val]:
+                # bool is an int subclass; flag fields are not links.
+                if isinstance(item, (int, Link, AstNode)) and not isinstance(
+                    item, bool
+                ):
+                    self.visit(item, in_loop)
+
+    def _throw(self, what: str, loc):
+        self.errors.throw(
+            202,
+            what=what,
+            context="a loop",
+            loc=loc,
+            help="hoist the allocation out of the loop (e.g. preallocate "
+            "with List.reserve and assign by index) or build without "
+            "--no-gc",
+        )
+
+    # ==== classification ====
+
+    def _link(self, x) -> Optional[int]:
+        if isinstance(x, Link):
+            return x.target
+        return x if isinstance(x, int) and not isinstance(x, bool) else None
+
+    def _typed(self, link: Optional[int]) -> Optional[str]:
+        return self.env.typed.get(link) if link is not None else None
+
+    def _direct_alloc(self, node: AstNode, link: Optional[int]) -> Optional[str]:
+        """A human-readable description if evaluating `node` itself
+        allocates, independent of any calls it contains."""
+        match node:
+            case List():
+                return "the list literal"
+            case Tuple():
+                return "the tuple literal"
+            case StructInit():
+                return "the struct construction"
+            case Function() if node.body is not None:
+                return "the closure definition"
+            case Range():
+                # Outside a for-loop header a range is boxed.
+                return "the range value"
+            case BinOp() if self._typed(link) in ("str", "list"):
+                return "the concatenation"
+            case Conversion() if self._typed(link) == "str":
+                return "the string conversion"
+            case Index() if isinstance(self.unlink(node.index), Slice):
+                return "the slice"
+            case Index() if self._typed(self._link(node.iterable)) == "str":
+                # str__getitem__ builds a fresh one-character string.
+                return "the string indexing"
+            case ForLoop() if self._typed(self._link(node.iterable)) == "str":
+                # Iterating a string materializes each character as a
+                # new string, one allocation per step.
+                return "the string iteration"
+            case IndexAssignment():
+                # In-place list writes never grow storage; map and string
+                # assignment may.
+                target = self._typed(self._link(node.target.iterable))
+                if target not in (None, "list"):
+                    return f"the {target} assignment"
+        return None
+
+    def _call_name(self, node: Call) -> Optional[str]:
+        callee = self.unlink(node.callee)
+        if isinstance(callee, Identifier):
+            return callee.name
+        if isinstance(callee, Attribute) and "#type" in callee.meta:
+            return f"{callee.meta['#type']}.{self.unlink(callee.name).name}"
+        return None
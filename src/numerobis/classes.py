@@ -46,5 +46,9 @@ class CompiledModule:
     functions: list[str]
     typedefs: list[str]
     structs: list
+    externs: list[str] = field(default_factory=list)
+    # (impl_name, source_name) per compiled function, for the profiler
+    # symbol table the linker emits
+    symbols: list[tuple[str, str]] = field(default_factory=list)
     units: CompiledUnits
     namespaces: Optional["Namespaces"] = None  # type: ignore # noqa
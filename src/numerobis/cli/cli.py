@@ -1,6 +1,8 @@
 """Command-line interface for Numerobis compiler."""
 
 import platform
+import shlex
+import subprocess
 import time
 from pathlib import Path
 from typing import Optional
@@ -12,9 +14,10 @@ from rich.console import Console
 
 from numerobis.utils import is_unix
 
-from .. import __version__
+from .. import __version__, module as modules
 from ..compiler import gcc as gnucc
-from ..module import Module
+from ..module import CACHEKEYS, MODULECACHE, Module
+from ..utils import STDLIB_PATH
 
 console = Console()
 
@@ -87,6 +90,32 @@ def cli() -> None:
     default=False,
     help="Use ccache to speed up recompilation.",
 )
+@click.option(
+    "--compact-values/--no-compact-values",
+    "compact_values",
+    default=False,
+    help="Use the compact 24-byte Value layout (links libruntime_compact.a).",
+)
+@click.option(
+    "--no-gc",
+    "no_gc",
+    is_flag=True,
+    help="GC-free build: the collector never runs, so allocation is a "
+    "pure pointer bump with no pauses. Rejects programs that allocate "
+    "inside a loop or an allocating recursive function.",
+)
+@click.option(
+    "--pgo",
+    is_flag=True,
+    help="Profile-guided build: compile instrumented, run a training "
+    "invocation, then recompile with -fprofile-use -flto.",
+)
+@click.option(
+    "--pgo-train",
+    default="",
+    help="Training command for --pgo (defaults to running the built binary "
+    "with no arguments).",
+)
 def build(
     source: str,
     output: str,
@@ -98,6 +127,10 @@ def build(
     linker: Optional[str],
     use_cmake: bool,
     use_ccache: bool,
+    compact_values: bool,
+    no_gc: bool,
+    pgo: bool,
+    pgo_train: str,
 ) -> None:
     """
     Compile SOURCE (.nbis) into a native executable.
@@ -116,24 +149,75 @@ def build(
     else:
         output = str(Path(output).resolve())
 
+    if pgo and compact_values:
+        console.print(
+            "[red]--pgo cannot be combined with --compact-values "
+            "(no LTO build of the compact runtime)[/red]"
+        )
+        raise SystemExit(1)
+
     flags = set()
     if debug:
         flags.add("-g")
     flags.add(f"-O{opt_level}")
+    if compact_values:
+        flags.add("-DNBIS_COMPACT_VALUE")
+    if no_gc:
+        # The region check runs during typechecking (module.py); the
+        # define switches the generated main() to disable the collector.
+        modules.NOGC = True
+        flags.add("-DNBIS_NO_GC")
 
     try:
         mod = Module(source)
         mod.load()
         mod.link(format=False)
         t1 = time.time()
-        mod.cmake(
-            output,
-            flags=flags,
-            cc=cc,
-            linker=linker if linker else None,
-            use_cmake=use_cmake,
-            use_ccache=use_ccache,
-        )
+        if pgo:
+            # Instrumented build, training run, optimized rebuild. The
+            # gcc backend is used directly so the profile flags reach a
+            # single driver invocation for both compile and link.
+            profile_dir = Path(output).parent / (Path(output).name + ".pgo")
+            profile_dir.mkdir(parents=True, exist_ok=True)
+            mod.cmake(
+                output,
+                flags=flags | {f"-fprofile-generate={profile_dir}"},
+                cc=cc,
+                linker=linker if linker else None,
+                use_cmake=False,
+                use_ccache=False,
+            )
+
+            train_cmd = shlex.split(pgo_train) if pgo_train else [output]
+            if not quiet:
+                console.print(
+                    f"[blue]Training: {' '.join(train_cmd)}[/blue]", highlight=False
+                )
+            train = subprocess.run(train_cmd)
+            if train.returncode != 0:
+                console.print(
+                    f"[yellow]Training run exited with status {train.returncode}; "
+                    "profile may be incomplete[/yellow]"
+                )
+
+            mod.cmake(
+                output,
+                flags=flags
+                | {f"-fprofile-use={profile_dir}", "-fprofile-correction", "-flto"},
+                cc=cc,
+                linker=linker if linker else None,
+                use_cmake=False,
+                use_ccache=False,
+            )
+        else:
+            mod.cmake(
+                output,
+                flags=flags,
+                cc=cc,
+                linker=linker if linker else None,
+                use_cmake=use_cmake,
+                use_ccache=use_ccache,
+            )
     except KeyboardInterrupt:
         console.print("[red]Build interrupted by user[/red]")
         raise SystemExit(130)
@@ -154,6 +238,256 @@ def build(
         gnucc.run(path=output, capture_output=False)
 
 
+def _module_file(key: str) -> Path:
+    """Maps a module-cache key back to the file it was loaded from.
+    Stdlib modules are cached under the pseudo-path 'stdlib/<name>'."""
+    path = Path(key)
+    if path.parts and path.parts[0] == "stdlib":
+        return (STDLIB_PATH / path.name).resolve()
+    return path.resolve()
+
+
+def _module_key(dep: str) -> str:
+    """Normalizes a dependency path to its module-cache key."""
+    path = Path(dep)
+    if path.is_absolute() and path.is_relative_to(STDLIB_PATH):
+        return str(Path("stdlib") / path.name)
+    return dep
+
+
+def _evict_modules(keys: set[str]) -> None:
+    """Drops the given modules and everything that (transitively) imports
+    them from the in-process cache, so the next build re-parses exactly
+    the affected modules and restores the rest from cache."""
+    importers: dict[str, set[str]] = {}
+    for key, compiled in MODULECACHE.items():
+        for dep in compiled.imports:
+            importers.setdefault(_module_key(dep), set()).add(key)
+
+    stale = set(keys)
+    queue = list(keys)
+    while queue:
+        for importer in importers.get(queue.pop(), ()):
+            if importer not in stale:
+                stale.add(importer)
+                queue.append(importer)
+
+    for key in stale:
+        MODULECACHE.pop(key, None)
+        CACHEKEYS.pop(key, None)
+
+
+def _prune_modules(main_key: str) -> None:
+    """Drops cached modules no longer reachable from the main module, so
+    a removed import stops contributing units (and graphics detection)
+    to the next link."""
+    reachable: set[str] = set()
+    queue = [main_key]
+    while queue:
+        key = queue.pop()
+        if key in reachable or key not in MODULECACHE:
+            continue
+        reachable.add(key)
+        queue.extend(_module_key(dep) for dep in MODULECACHE[key].imports)
+
+    for key in set(MODULECACHE) - reachable:
+        MODULECACHE.pop(key, None)
+        CACHEKEYS.pop(key, None)
+
+
+@cli.command("watch")
+@click.argument("source", type=click.Path(exists=True, file_okay=True, dir_okay=False))
+@click.option(
+    "-o",
+    "--output",
+    default="",
+    show_default=False,
+    help="Output binary path",
+)
+@click.option(
+    "--run/--no-run",
+    "should_run",
+    default=True,
+    help="Execute the binary after each successful rebuild.",
+)
+@click.option(
+    "--quiet",
+    is_flag=True,
+    help="Suppress non-essential compiler output.",
+)
+@click.option(
+    "--debug/--no-debug",
+    default=True,
+    help="Emit debug information (-g).",
+)
+@click.option(
+    "-O",
+    "opt_level",
+    type=click.Choice(["0", "1", "2", "3", "s"]),
+    default="0",
+    help="Set optimization level (passed to the C compiler).",
+)
+@click.option(
+    "--cc",
+    "cc",
+    type=click.STRING,
+    default="gcc",
+    help="Set C compiler to use.",
+)
+@click.option(
+    "--linker",
+    "linker",
+    type=click.STRING,
+    default=None,
+    help="Set C linker to use.",
+)
+@click.option(
+    "--cmake/--no-cmake",
+    "use_cmake",
+    default=True,
+    help="Use CMake for build configuration.",
+)
+@click.option(
+    "--ccache/--no-ccache",
+    "use_ccache",
+    default=True,
+    help="Use ccache to speed up recompilation (on by default in watch mode).",
+)
+@click.option(
+    "--compact-values/--no-compact-values",
+    "compact_values",
+    default=False,
+    help="Use the compact 24-byte Value layout (links libruntime_compact.a).",
+)
+@click.option(
+    "--interval",
+    type=click.FLOAT,
+    default=0.2,
+    show_default=True,
+    help="File polling interval in seconds.",
+)
+def watch(
+    source: str,
+    output: str,
+    should_run: bool,
+    quiet: bool,
+    debug: bool,
+    opt_level: str,
+    cc: str,
+    linker: Optional[str],
+    use_cmake: bool,
+    use_ccache: bool,
+    compact_values: bool,
+    interval: float,
+) -> None:
+    """
+    Rebuild SOURCE whenever it or one of its imports changes.
+
+    The compiler stays resident between rebuilds: interpreter startup and
+    lexer construction are paid once, and modules that did not change are
+    reused from the in-process cache, so an edit only re-runs the frontend
+    for the touched module and its importers before relinking.
+    """
+
+    if not output:
+        stem = Path(Path(source).stem).resolve()
+        if stem.is_dir():
+            console.print("[red]Output path is a directory[/red]")
+            raise SystemExit(1)
+        output = str(stem)
+        if not is_unix:
+            output += ".exe"
+    else:
+        output = str(Path(output).resolve())
+
+    flags = set()
+    if debug:
+        flags.add("-g")
+    flags.add(f"-O{opt_level}")
+    if compact_values:
+        flags.add("-DNBIS_COMPACT_VALUE")
+
+    main = Path(source).resolve()
+
+    def rebuild() -> bool:
+        t0 = time.time()
+        try:
+            mod = Module(source)
+            mod.load()
+            mod.link(format=False)
+            t1 = time.time()
+            mod.cmake(
+                output,
+                flags=flags,
+                cc=cc,
+                linker=linker if linker else None,
+                use_cmake=use_cmake,
+                use_ccache=use_ccache,
+            )
+        except SystemExit:
+            # Diagnostics were already printed; keep watching so the next
+            # save gets another attempt.
+            return False
+        except subprocess.CalledProcessError:
+            return False
+        if not quiet:
+            console.print(
+                f"[green]Built {output}[/green] [green]({t1 - t0:.2f}s / {time.time() - t0:.2f}s)[/green]",
+                highlight=False,
+            )
+        return True
+
+    def watched() -> dict[Path, set[str]]:
+        """Resolved file -> cache keys for the currently loaded graph."""
+        files: dict[Path, set[str]] = {main: {str(Path(source))}}
+        for key in MODULECACHE:
+            files.setdefault(_module_file(key), set()).add(key)
+        return files
+
+    if not quiet:
+        console.print(f"[blue]Watching {source} (Ctrl-C to stop)[/blue]")
+
+    try:
+        ok = rebuild()
+        files = watched()
+        if ok and should_run:
+            gnucc.run(path=output, capture_output=False)
+        mtimes = {path: path.stat().st_mtime for path in files if path.is_file()}
+
+        while True:
+            time.sleep(interval)
+            changed: set[str] = set()
+            for path, keys in files.items():
+                try:
+                    mtime = path.stat().st_mtime
+                except OSError:
+                    continue
+                if mtime != mtimes.get(path):
+                    mtimes[path] = mtime
+                    changed |= keys
+            if not changed:
+                continue
+
+            _evict_modules(changed)
+            ok = rebuild()
+            if ok:
+                # A successful build has the full import graph loaded;
+                # after a failure, keep the previous set so edits to a
+                # broken import still trigger a retry.
+                _prune_modules(str(Path(source)))
+                files = watched()
+                mtimes = {
+                    path: mtimes.get(path, path.stat().st_mtime)
+                    for path in files
+                    if path.is_file()
+                }
+                if should_run:
+                    gnucc.run(path=output, capture_output=False)
+    except KeyboardInterrupt:
+        console.print("[red]Watch stopped by user[/red]")
+        raise SystemExit(130)
+
+
 @cli.command("view")
 @click.argument(
     "source",
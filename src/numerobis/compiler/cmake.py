@@ -10,7 +10,7 @@ from typing import Optional
 from numerobis.utils import is_unix
 
 from ..classes import CompiledUnits, ModuleMeta
-from .utils import repr_double
+from .utils import prepare_source_blobs
 
 
 def _prepare_units_h(units: CompiledUnits) -> str:
@@ -42,19 +42,6 @@ def _prepare_source_c(
     units_h: str,
     units: CompiledUnits,
 ):
-    arrays, structs, entries = [], [], []
-
-    for i, mod in enumerate(modules):
-        src_lines = mod.source.splitlines()
-        c_lines = ", ".join(repr_double(line) for line in src_lines)
-        path_str = repr_double(str(mod.path))
-
-        arrays.append(f"static const char *lines_{i}[] = {{ {c_lines} }};")
-        structs.append(
-            f"static NumerobisProgram mod_{i} = {{ {path_str}, {len(src_lines)}, lines_{i} }};"
-        )
-        entries.append(f"shput(NUMEROBIS_MODULE_REGISTRY, {path_str}, &mod_{i});")
-
     unit_names = "\n".join(
         f'    [{uid}] = "{name}",' for uid, name in units.names.items()
     )
@@ -62,20 +49,9 @@ def _prepare_source_c(
     source = f"""#include <math.h>
     #include <stdbool.h>
     #include <stdint.h>
-    #include <numerobis/libs/stb_ds.h>
     #include "{units_h}"
 
-    typedef struct {{
-        const char *path;
-        const int n_lines;
-        const char **source;
-    }} NumerobisProgram;
-
-    typedef struct {{ char *key; NumerobisProgram *value; }} ModuleEntry;
-    extern ModuleEntry *NUMEROBIS_MODULE_REGISTRY;
-
-    {chr(10).join(arrays)}
-    {chr(10).join(structs)}
+    {prepare_source_blobs(modules)}
 
     static inline double logn(double b, double x) {{return log(x) / log(b);}}
 
@@ -110,11 +86,6 @@ def _prepare_source_c(
     const char *NUMEROBIS_UNIT_NAMES[] = {{
     {unit_names}
     }};
-
-    __attribute__((constructor))
-    void u_init_module_registry() {{
-        {chr(10).join(entries)}
-    }}
     """
     return source
 
@@ -159,10 +130,18 @@ def compile(
     fno_plt = " -fno-plt" if is_unix else ""
     combined_flags = " ".join({"-O3", "-march=native"} | flags) + fno_plt
 
+    # --compact-values programs must link the runtime variant built with the
+    # matching Value layout.
+    compact = "-DNBIS_COMPACT_VALUE" in flags
+
     with resources.as_file(resources.files("numerobis")) as base_path:
         runtime_path = base_path / "runtime"
-        runtime_lib = runtime_path / "libruntime.a"
-        graphics_lib = runtime_path / "libgraphics.a"
+        runtime_lib = runtime_path / (
+            "libruntime_compact.a" if compact else "libruntime.a"
+        )
+        graphics_lib = runtime_path / (
+            "libgraphics_compact.a" if compact else "libgraphics.a"
+        )
 
         gc_path = runtime_path / "numerobis" / "libs" / "bdwgc"
         gc_lib_static = gc_path / "lib" / "libgc.a"
@@ -4,15 +4,21 @@ Transforms intermediate representation into compilable C source code.
 """
 
 import dataclasses
+import re
 from decimal import Decimal
 from pathlib import Path
 from typing import Any, TypeVar
 
+from ..analysis.folding import Folder
 from ..analysis.invert import _to_x
 from ..analysis.preprocessor import Preprocessor
 from ..analysis.simplifier import Simplifier
 from ..classes import CompiledModule, CompiledUnits, Header, ModuleMeta
-from ..compiler.scoping import get_free_vars
+from ..compiler.scoping import (
+    NON_RETAINING_CALLEES,
+    accumulation_locals,
+    get_free_vars,
+)
 from ..environment import Namespaces
 from ..exceptions.exceptions import Exceptions
 from ..nodes.ast import (
@@ -54,6 +60,7 @@ from ..nodes.ast import (
     UnaryOp,
     UnitDefinition,
     Variable,
+    VariableDeclaration,
     WhileLoop,
 )
 from ..nodes.core import AstNode, Identifier, Location, UnitNode
@@ -64,11 +71,13 @@ from ..utils import camel2snake_pattern
 from .tstr import tstr
 from .utils import (
     BUILTINS,
+    c_literal_bytes,
     compile_math,
     ensuresuffix,
     mangle,
     module_uid,
     mthd,
+    sds_content_hash,
     strip_parens,
     unit_uid,
 )
@@ -109,7 +118,9 @@ class Compiler:
             }
         )
         self.functions: list[str] = []
+        self.symbols: list[tuple[str, str]] = []
         self.typedefs: list[str] = []
+        self.externs: list[str] = []
         self.structs: list[StructType] = []
         self._defined_addrs: dict[str, str] = {}
         self._imported_names = {}
@@ -118,11 +129,84 @@ class Compiler:
 
         self._globals: list[list[str]] = [[]]  # queue of globals of nested functions
 
+        # Interned unit constants: C unit expression -> global name. Each
+        # distinct source-level unit is built once at module startup instead
+        # of re-running unit_new at every use site.
+        self._unit_consts: dict[str, str] = {}
+
+        # Interned string literals: C literal -> global name. Each distinct
+        # literal is allocated once at module startup; repeated evaluations
+        # reuse the same sds, so identical literals compare by pointer in
+        # str__eq__ and hot loops stop allocating.
+        self._str_consts: dict[str, str] = {}
+
+        # Per-module counter for string-dispatch no-match labels (if_).
+        self._dispatch_n = 0
+
+        # Interned call-site locations: (line, col, end_line, end_col) ->
+        # index into the module's static Location table. Fallible calls
+        # pass a pointer into the table instead of materializing a
+        # compound literal per evaluation; only u_throw ever reads the
+        # span, on the failure path.
+        self._loc_consts: dict[tuple[int, int, int, int], int] = {}
+
+        # Interned literal Values: C initializer expression -> global name.
+        # Numeric and string literals are boxed once into a per-module
+        # constant pool at startup (__value_pool), so loop bodies load a
+        # prebuilt Value instead of re-running __init__ boxing on every
+        # evaluation.
+        self._value_consts: dict[str, str] = {}
+
+        # Escape analysis: set by call_ while compiling a lambda argument
+        # of a non-retaining callee, consumed by function_ to emit a
+        # stack-allocated closure instead of a heap capture.
+        self._stack_closure = False
+
+        # Stack of contexts for the functions being compiled, innermost
+        # last. A recursive call — callee compiled to `self` — targets
+        # the top entry's impl directly instead of going through
+        # __call__'s Closure indirection, and in tail position becomes a
+        # parameter rebind + goto to the entry's label. Methods (dotted
+        # names) are excluded: their closures may carry a bound argument
+        # that only __call__ appends.
+        self._impl_stack: list[dict] = []
+
+        # Set by return_ while compiling a directly returned call so
+        # call_ can turn an eligible self-call into a tail-call goto.
+        self._tail_call = False
+
+        # Active bounds-check elisions, innermost last: range loops of
+        # the shape `for i in 0..xs.len()` whose bodies provably cannot
+        # shrink xs register here so index_ can compile xs[i] to an
+        # unchecked list_get_fast load on the raw counter. Cleared while
+        # compiling nested function bodies — the raw counter is not in
+        # scope there.
+        self._elisions: list[dict] = []
+
+        # Per-function sets of locals whose `x = x + rhs` reassignments
+        # may be lowered to in-place appends (accumulation_locals in
+        # scoping.py), innermost last. The module top level keeps an
+        # empty frame: its variables are reachable from other modules.
+        self._acc_locals: list[set[str]] = [set()]
+
         self.units: CompiledUnits = CompiledUnits()
 
     # These bypass the full number_binop dispatch for plain dimless integers.
     _FAST_BINOP = {"add": "FAST_ADD", "sub": "FAST_SUB", "mul": "FAST_MUL"}
 
+    # Statically known numeric operand types (see _static_type)
+    _NUMERIC_TYPES = {"int", "num"}
+
+    # Typed names whose runtime lives in a differently named header:
+    # the fixed-size vector/matrix family shares types/vec.h.
+    _TYPE_HEADERS = {"vec2": "vec", "vec3": "vec", "mat3": "vec"}
+
+    # Named functions of at most this many parameters compile in the
+    # register-based calling convention — callee and arguments as direct
+    # C parameters — alongside an array-ABI wrapper for indirect callers.
+    # Must match NBIS_DIRECT_MAX_ARITY in runtime values.h.
+    _DIRECT_MAX_ARITY = 4
+
     def assertion_(self, node: Assertion, link: int) -> tstr:
         op = None
         a = self.unlink(node.expr)
@@ -162,15 +246,29 @@ class Compiler:
         left, right = operands[:: node.meta.get("side", 1)]
         op_name = node.op.name
 
+        # The typechecker proved both operands numeric: dispatch directly
+        # into number arithmetic instead of through NUMEROBIS_METHODS.
+        numeric = (
+            self._static_type(node.left) in self._NUMERIC_TYPES
+            and self._static_type(node.right) in self._NUMERIC_TYPES
+        )
+
         if op_name in self._FAST_BINOP:
             self.include.add("numerobis/closures")
             macro = self._FAST_BINOP[op_name]
+            if numeric:
+                macro += "_NUM"
             return tstr(f"{macro}({left}, {right})")
 
+        loc = f", {self.compile(node.loc)}" if op_name in {"div", "pow"} else ""
+        if numeric:
+            self.include.add("numerobis/types/number")
+            return tstr(f"number__{op_name}__({left}, {right}{loc})")
+
         out = tstr("__$func__($left, $right$loc)")
         out["left"], out["right"] = left, right
         out["func"] = op_name
-        out["loc"] = f", {self.compile(node.loc)}" if op_name in {"div", "pow"} else ""
+        out["loc"] = loc
         return out
 
     def block_(self, node: Block, link: int) -> tstr:
@@ -202,9 +300,36 @@ class Compiler:
         return tstr("break;")
 
     def call_(self, node: Call, link: int) -> tstr:
+        # Consume the tail-position flag up front so calls compiled while
+        # building this call's arguments do not inherit it.
+        tail = self._tail_call
+        self._tail_call = False
+
         out = tstr("$callee($args)")
 
-        callee = self.compile(node.callee)
+        # Method-call fusion: for `obj.method(args)` on a builtin type the
+        # receiver slot is known (args[argc], where __call__ would have
+        # put the bound argument), so the receiver is written there up
+        # front and the call goes through the raw method value. This
+        # skips __getattr__'s closure__init__ — a GC allocation per
+        # access — entirely. Attribute reads that are not immediately
+        # called still bind through __getattr__.
+        fused_self = None
+        callee_node = self.unlink(node.callee)
+        if (
+            isinstance(callee_node, Attribute)
+            and "#struct" not in callee_node.meta
+            and "#type" in callee_node.meta
+            and "callee" in node.meta
+        ):
+            self.include.add("numerobis/closures")
+            typ = callee_node.meta["#type"]
+            callee = self.compile(
+                Identifier(f"{typ}.{self.unlink(callee_node.name)}")
+            )
+            fused_self = str(self.compile(callee_node.owner))
+        else:
+            callee = self.compile(node.callee)
         out["callee"] = callee
 
         unlinked_args: list[CallArg] = [self.unlink(arg) for arg in node.args]  # type: ignore
@@ -236,11 +361,73 @@ class Compiler:
         else:
             args = [arg.value for arg in arg_names.values()]
 
-        args = [
-            str(self.compile(arg)) if arg is not None else "EMPTY" for arg in args
-        ] + ["EMPTY"]
+        # Lambdas handed straight to a callee that never retains them can
+        # capture on the stack (see NON_RETAINING_CALLEES in scoping.py).
+        callee_sig = node.meta.get("callee")
+        non_retaining = (
+            getattr(callee_sig, "extern", False)
+            and getattr(callee_sig, "_name", None) in NON_RETAINING_CALLEES
+        )
+
+        complete = all(arg is not None for arg in args)
+        compiled_args = []
+        for arg in args:
+            if arg is None:
+                compiled_args.append("EMPTY")
+                continue
+            unlinked = self.unlink(arg)
+            self._stack_closure = (
+                non_retaining
+                and isinstance(unlinked, Function)
+                and unlinked.name is None
+            )
+            compiled_args.append(str(self.compile(arg)))
+            self._stack_closure = False
+        if fused_self is not None:
+            # Receiver lands at args[argc], the slot __call__ reserves
+            # for a bound argument; the method value itself is unbound.
+            args = compiled_args + [fused_self, "EMPTY"]
+        else:
+            args = compiled_args + ["EMPTY"]
 
         str_args = f"(Value[]){{{callee}, {', '.join(args)}}}"
+
+        # Direct-call lowering: a recursive call inside a named function
+        # compiles its callee to `self`, whose impl symbol and environment
+        # (__env) are statically known. In tail position the call becomes
+        # a parameter rebind plus a goto back to the function entry —
+        # constant stack depth, no frame setup. Elsewhere it is a direct
+        # C call: no Closure loads, no extern/bound-argument checks, and
+        # the C compiler can see through it.
+        if str(callee) == "self" and self._impl_stack and self._impl_stack[-1]["direct"]:
+            ctx = self._impl_stack[-1]
+            if tail and complete and len(compiled_args) == len(ctx["params"]):
+                ctx["tail_used"] = True
+                temps = [f"Value __tc{i} = {a};" for i, a in enumerate(compiled_args)]
+                rebinds = [f"{p} = __tc{i};" for i, p in enumerate(ctx["params"])]
+                return tstr(
+                    "{\n" + "\n".join(temps + rebinds) + f"\ngoto {ctx['label']};\n}}",
+                    meta={"tailgoto": True},
+                )
+            if ctx["direct_n"] is not None and len(compiled_args) == ctx["direct_n"]:
+                rest = "".join(f", {a}" for a in compiled_args)
+                return tstr(f"{ctx['impl']}_d(__env, self{rest})")
+            return tstr(f"{ctx['impl']}(__env, {str_args})")
+
+        # Register-convention dispatch (values.h __callNd__): for a call
+        # of statically known small arity the callee and arguments travel
+        # as direct C parameters; the helper falls back to the Value-array
+        # form for bound closures and arity mismatches. Extern boundary
+        # calls and variadic marshalling keep the array form outright.
+        if (
+            fused_self is None
+            and callee_sig is not None
+            and not getattr(callee_sig, "extern", False)
+            and argc == len(compiled_args) <= self._DIRECT_MAX_ARITY
+        ):
+            rest = "".join(f", {a}" for a in compiled_args)
+            return tstr(f"__call{argc}d__({callee}{rest})")
+
         out = tstr(f"__call__({callee}, {str_args}, {argc})")
 
         return out
@@ -304,12 +491,17 @@ class Compiler:
     def extern_declaration_(self, node: ExternDeclaration, link: int) -> tstr:
         self.include.add("numerobis/extern")
 
-        out = tstr('Value und_$uid_$name = *u_extern_lookup("$extern_name")')
-        out["uid"] = self.uid
-
         name = self.unlink(self.unlink(node.value).name).name  # type: ignore
+        if name not in self.externs:
+            self.externs.append(name)
+
+        # The linker assigns every extern used by the program a dense id
+        # and resolves the U_EXTERNS table once at startup, so each
+        # declaration is an indexed load instead of a string-hash lookup.
+        out = tstr("Value und_$uid_$name = U_EXTERNS[U_EXT_$id]")
+        out["uid"] = self.uid
         out["name"] = mangle(name)
-        out["extern_name"] = name.replace("_", "__")
+        out["id"] = mangle(name)
 
         return out
 
@@ -321,7 +513,13 @@ class Compiler:
         if "value" not in node.meta:
             return tstr("/* empty loop */")
 
+        # Runtime scratch taken during an iteration (unit-factor work
+        # arrays and friends) dies before the iteration ends, so the body
+        # runs inside an arena scope rewound at the top of every pass.
+        self.include.add("numerobis/utils/arena")
+
         loop = tstr("""for (size_t $iterator = 0, $limit = $iterable_type_len($iterable).number.i64; $iterator < $limit; $iterator++) {
+            u_arena_rewind($arena);
             $iterator_defs
             $body
         }""")
@@ -333,15 +531,17 @@ class Compiler:
         iterator_name = f"__iterator_{abs(link)}"
         iterable_name = f"__iterable_{abs(link)}"
         limit_name = f"__limit_{abs(link)}"
+        arena_name = f"__arena_{abs(link)}"
 
         loop["iterator"], loop["iterable"], loop["limit"] = (
             iterator_name,
             iterable_name,
             limit_name,
         )
+        loop["arena"] = arena_name
         loop["iterable_type"] = iterable_type
 
-        self.include.add(f"numerobis/types/{iterable_type}")
+        self.include.add(self._type_include(iterable_type))
 
         iterators = [self.unlink(iterator) for iterator in node.iterators]
 
@@ -362,40 +562,195 @@ class Compiler:
             for i, iterator in enumerate(iterators):
                 defs.append(
                     f"Value und_{self.uid}_{iterator.name} = "
-                    f"__getitem__({iterrow_name}, int__init__({i}, U_ONE), LOC(0, 0, 0, 0));"
+                    f"__getitem__({iterrow_name}, int__init__({i}, U_ONE), {self._loc_const(0, 0, 0, 0)});"
                 )
             loop["iterator_defs"] = "\n".join(defs)
 
         iterable = self.compile(node.iterable)
         if "reference" not in iterable.meta:
-            out = tstr("{\n$iterable_def;\n$loop}")
+            out = tstr("{\nU_ARENA_SCOPE($arena);\n$iterable_def;\n$loop}")
             out["iterable_def"] = f"Value {iterable_name} = {iterable}"
-            out["loop"] = loop
-            return out
         else:
             loop["iterable"] = iterable
+            out = tstr("{\nU_ARENA_SCOPE($arena);\n$loop}")
 
-        return loop
+        out["arena"] = arena_name
+        out["loop"] = loop
+        return out
+
+    # Methods that can shrink a list. A call to one of these anywhere in
+    # an elided loop body — on any receiver, since the list may be
+    # aliased — disables bounds-check elision.
+    _SHRINKING_METHODS = frozenset({"pop", "popleft"})
+
+    def _bounds_elision(self, node: ForLoop, link: int) -> dict | None:
+        """Proves `for i in 0..xs.len()` indexes xs in range: start is
+        the literal 0, the step is 1, the bound is xs.len(), and the body
+        neither rebinds xs or i nor calls anything that could shrink xs.
+        Eligible xs[i] accesses then compile to an unchecked
+        list_get_fast load on the raw counter."""
+        if node.meta.get("value") is None or node.meta["value"].name() != "Int":
+            return None
+        r = self.unlink(node.iterable)
+        if not isinstance(r, Range):
+            return None
+
+        start = self.unlink(r.start) if r.start is not None else None
+        if not (isinstance(start, Integer) and str(start.value) == "0"):
+            return None
+        step = self.unlink(r.step) if r.step is not None else None
+        if step is not None and not (
+            isinstance(step, Integer) and str(step.value) == "1"
+        ):
+            return None
+
+        stop = self.unlink(r.end) if r.end is not None else None
+        if not isinstance(stop, Call):
+            return None
+        sig = stop.meta.get("callee")
+        if getattr(sig, "_name", None) != "List.len" or not getattr(
+            sig, "extern", False
+        ):
+            return None
+        callee = self.unlink(stop.callee)
+        if not isinstance(callee, Attribute) or "#struct" in callee.meta:
+            return None
+        owner = self.unlink(callee.owner)
+        if not isinstance(owner, Identifier):
+            return None
+
+        xs = owner.name
+        iterator = self.unlink(node.iterators[0]).name
+        if not self._body_safe_for_elision(node.body, xs, iterator):
+            return None
+
+        return {"list": xs, "iter": iterator, "raw": f"__iterator_{abs(link)}"}
+
+    def _body_safe_for_elision(self, body: Any, xs: str, iterator: str) -> bool:
+        ok = True
+
+        def visit(n: Any):
+            nonlocal ok
+            if not ok:
+                return
+            # bool is an int subclass; plain data ints on AST fields
+            # (e.g. an arity) are not links.
+            if isinstance(n, bool) or (
+                isinstance(n, int) and n not in self.env.nodes
+            ):
+                return
+            if isinstance(n, (int, Link)):
+                n = self.unlink(n)
+            try:
+                fields = dataclasses.fields(n)
+            except TypeError:
+                return
+
+            match n:
+                case Variable() | VariableDeclaration():
+                    if self.unlink(n.name).name in (xs, iterator):
+                        ok = False
+                        return
+                case ForLoop():
+                    for it in n.iterators:
+                        if self.unlink(it).name in (xs, iterator):
+                            ok = False
+                            return
+                case Attribute():
+                    if (
+                        "#struct" not in n.meta
+                        and self.unlink(n.name).name in self._SHRINKING_METHODS
+                    ):
+                        ok = False
+                        return
+                case Function():
+                    # A function literal is arbitrary user code an extern
+                    # callee (sortby, map, ...) may run inside the loop —
+                    # it can shrink xs through a capture even though the
+                    # callee itself is trusted.
+                    ok = False
+                    return
+                case Call():
+                    # Non-extern callees may capture or alias the list;
+                    # passing the list itself to any callee is opaque.
+                    if not getattr(n.meta.get("callee"), "extern", False):
+                        ok = False
+                        return
+                    for arg in n.args:
+                        a = self.unlink(arg)
+                        v = self.unlink(a.value) if a.value is not None else None
+                        if isinstance(v, Identifier) and v.name == xs:
+                            ok = False
+                            return
+                case _:
+                    pass
+
+            for field in fields:
+                if field.name in ("meta", "_meta"):
+                    continue
+                val = getattr(n, field.name)
+                if isinstance(val, (list, tuple)):
+                    for item in val:
+                        visit(item)
+                elif val is not None:
+                    visit(val)
+
+        visit(body)
+        return ok
+
+    def _elided_index(self, node: Index) -> tstr | None:
+        if not self._elisions:
+            return None
+        iterable = self.unlink(node.iterable)
+        index = self.unlink(node.index)
+        if not (isinstance(iterable, Identifier) and isinstance(index, Identifier)):
+            return None
+        for ctx in reversed(self._elisions):
+            if iterable.name == ctx["list"] and index.name == ctx["iter"]:
+                self.include.add("numerobis/types/list")
+                return tstr(
+                    f"list_get_fast({self.compile(node.iterable)}, {ctx['raw']})"
+                )
+        return None
 
     def for_loop_range_(self, node: ForLoop, link: int) -> tstr:
+        self.include.add("numerobis/utils/arena")
+
         loop = tstr("""{
+            U_ARENA_SCOPE($arena);
             Range *$range = $range_def.range;
             for ($type $i = $range->start;
                 (($range->step > 0) ? ($i < $range->stop) : ($i > $range->stop));
                 $i += $range->step)
             {
-                Value $iv = $vtype__init__($i, U_ONE);
+                u_arena_rewind($arena);
+                $iv_def
                 $body
             }}""")
 
-        body = self.compile(self._make_block(node.body))
-        loop["body"] = strip_parens(str(body), "{")
-        loop["i"] = f"__iterator_{abs(link)}"
-        loop["iv"] = self.compile(node.iterators[0])
-
-        loop["vtype"] = node.meta["value"].name().lower()  # 'int' or 'float'
+        elide = self._bounds_elision(node, link)
+        if elide:
+            self._elisions.append(elide)
+        body_str = strip_parens(str(self.compile(self._make_block(node.body))), "{")
+        if elide:
+            self._elisions.pop()
+        loop["body"] = body_str
+
+        i_name = f"__iterator_{abs(link)}"
+        loop["i"] = i_name
+        loop["arena"] = f"__arena_{abs(link)}"
         loop["type"] = {"Int": "long", "Num": "double"}[node.meta["value"].name()]
 
+        # Box the induction variable lazily: the raw counter drives the
+        # loop, and the Value wrapper (an int__init__/num__init__ call per
+        # iteration) is only built when the body actually reads it.
+        iv_name = str(self.compile(node.iterators[0]))
+        vtype = node.meta["value"].name().lower()  # 'int' or 'float'
+        if re.search(rf"\b{re.escape(iv_name)}\b", body_str):
+            loop["iv_def"] = f"Value {iv_name} = {vtype}__init__({i_name}, U_ONE);"
+        else:
+            loop["iv_def"] = ""
+
         r = self.unlink(node.iterable)
         if not isinstance(r, Range):
             loop["range_def"] = self.compile(node.iterable)
@@ -406,11 +761,13 @@ class Compiler:
         assert isinstance(r, Range)
         loop = tstr(
             """{
+            U_ARENA_SCOPE($arena);
             for ($type $i = $start;
                 (($step > 0) ? ($i < $stop) : ($i > $stop));
                 $i += $step)
             {
-                Value $iv = $vtype__init__($i, U_ONE);
+                u_arena_rewind($arena);
+                $iv_def
                 $body
             }}""",
             content=loop.content,
@@ -439,17 +796,48 @@ class Compiler:
     def function_(self, node: Function, link: int) -> tstr:
         self.include.add("numerobis/closures")
 
+        # Consume the escape-analysis flag before compiling the body so
+        # nested closures make their own decision.
+        stack_env = self._stack_closure and node.name is None
+        self._stack_closure = False
+
         old_defined_addrs = self._defined_addrs.copy()
 
-        definition = tstr("""Value $name(void *__env, Value *__args) {
-                                U_UNPACK_ENV($env)
-                                $shadow_vars
-                                Value self = __args[0];
-                                $actual_name
-                                $args
+        impl_name = f"__impl_{self.uid}_{abs(link)}"
+        direct_ok = node.name is not None and "." not in self.unlink(node.name).name
+
+        # Register-based convention for small fixed arities: the callee
+        # and every argument arrive as direct C parameters, so call sites
+        # going through __callNd__ (values.h) skip the Value-array
+        # marshalling; an array-ABI wrapper is emitted alongside for
+        # indirect callers. Methods keep the array convention — __call__
+        # appends their bound argument to the array — and so do lambdas,
+        # which are only ever called indirectly.
+        direct_n = (
+            len(node.params)
+            if direct_ok and len(node.params) <= self._DIRECT_MAX_ARITY
+            else None
+        )
 
-                                $body
-                            }""")
+        if direct_n is None:
+            definition = tstr("""Value $name(void *__env, Value *__args) {
+                                    U_UNPACK_ENV($env)
+                                    $shadow_vars
+                                    Value self = __args[0];
+                                    $actual_name
+                                    $args
+                                    $tail_label
+                                    $body
+                                }""")
+        else:
+            definition = tstr("""Value $name(void *__env, Value self$params) {
+                                    U_UNPACK_ENV($env)
+                                    $shadow_vars
+                                    $actual_name
+                                    $args
+                                    $tail_label
+                                    $body
+                                }""")
         assert node.body is not None
 
         self._defined_addrs.update(self.env.nodes[link].meta["addrs"])
@@ -467,8 +855,51 @@ class Compiler:
             assert isinstance(globals_node, Global)
             globals = [self.unlink(var).name for var in globals_node.names]
 
+        self.symbols.append(
+            (impl_name, self.unlink(node.name).name if node.name else "<closure>")
+        )
+        if direct_n is not None:
+            # The register-convention body gets its own entry so profiler
+            # samples resolve to the function, not its array wrapper.
+            self.symbols.append((f"{impl_name}_d", self.unlink(node.name).name))
+
+        _unlinked_params = [self.unlink(param) for param in node.params]
+        params = [str(self.compile(param.name)) for param in _unlinked_params]
+
+        ctx = {
+            "impl": impl_name,
+            "direct": direct_ok,
+            "direct_n": direct_n,
+            "params": list(params),
+            "label": f"__tail_{self.uid}_{abs(link)}",
+            "tail_used": False,
+        }
+
+        free_var_names = get_free_vars(
+            self.env.nodes, node, link=link, defined_addrs=defined_addrs
+        )
+
         self._globals.append(globals)
+        self._acc_locals.append(
+            accumulation_locals(
+                self.env.nodes,
+                node.body,
+                # Captured names are excluded alongside params and globals:
+                # U_SHADOW_VAR copies the Value but shares its buffer, so an
+                # in-place append on a free variable would mutate the
+                # enclosing scope's copy.
+                exclude={self.unlink(p.name).name for p in _unlinked_params}
+                | set(globals)
+                | set(free_var_names),
+            )
+        )
+        self._impl_stack.append(ctx)
+        saved_elisions = self._elisions
+        self._elisions = []
         body = self.compile(self._make_block(node.body, rtrn=True))
+        self._elisions = saved_elisions
+        self._impl_stack.pop()
+        self._acc_locals.pop()
         self._globals.pop()
 
         if (
@@ -480,16 +911,21 @@ class Compiler:
 
         self._defined_addrs = old_defined_addrs
 
-        _unlinked_params = [self.unlink(param) for param in node.params]
-        params = [str(self.compile(param.name)) for param in _unlinked_params]
-
         # compile default args before scoping
-        definition["args"] = "\n".join(
-            f"U_UNPACK_ARG({param}, {i + 1})"
-            if not _unlinked_params[i].default
-            else f"U_UNPACK_OPT_ARG({param}, {i + 1}, {self.compile(_unlinked_params[i].default)})"
-            for i, param in enumerate(params)
-        )
+        if direct_n is None:
+            definition["args"] = "\n".join(
+                f"U_UNPACK_ARG({param}, {i + 1})"
+                if not _unlinked_params[i].default
+                else f"U_UNPACK_OPT_ARG({param}, {i + 1}, {self.compile(_unlinked_params[i].default)})"
+                for i, param in enumerate(params)
+            )
+        else:
+            definition["params"] = "".join(f", Value {param}" for param in params)
+            definition["args"] = "\n".join(
+                f"U_DEFAULT_ARG({param}, {self.compile(_unlinked_params[i].default)})"
+                for i, param in enumerate(params)
+                if _unlinked_params[i].default
+            )
 
         # If there's a bound arg, move it to the end
         if node.name and "." in self.unlink(node.name).name:
@@ -499,9 +935,7 @@ class Compiler:
         free_vars = [
             self._imported_names.get(var, f"und_{self.uid}_")
             + mangle(var.split("::")[-1])
-            for var in get_free_vars(
-                self.env.nodes, node, link=link, defined_addrs=defined_addrs
-            )
+            for var in free_var_names
         ]
         free_vars = list(set(free_vars))
         mangled_globals = [
@@ -513,9 +947,12 @@ class Compiler:
         name = self.compile(node.name) if node.name is not None else None
 
         definition["body"] = strip_parens(str(body), "{")
-        definition["name"] = f"__impl_{self.uid}_{abs(link)}"
+        definition["name"] = impl_name if direct_n is None else f"{impl_name}_d"
+        definition["tail_label"] = f"{ctx['label']}:;" if ctx["tail_used"] else ""
         definition["actual_name"] = (
-            f"Value {name} = __args[0];" if name and name else ""
+            f"Value {name} = {'__args[0]' if direct_n is None else 'self'};"
+            if name and name
+            else ""
         )
         definition["env"] = env_type
 
@@ -526,8 +963,25 @@ class Compiler:
 
         self.functions.append(str(definition))
 
+        if direct_n is not None:
+            # Array-ABI wrapper: the Closure func pointer keeps the
+            # Value-array signature indirect callers expect (__call__'s
+            # fallback, map, memoize) and forwards into the register body.
+            forwarded = ", ".join(
+                ["__args[0]", *(f"__args[{i + 1}]" for i in range(direct_n))]
+            )
+            self.functions.append(
+                f"Value {impl_name}(void *__env, Value *__args) {{\n"
+                f"    return {impl_name}_d(__env, {forwarded});\n}}"
+            )
+
         env_creation = [f"&{v}" if v in mangled_globals else v for v in free_vars]
-        out = f"U_NEW_CLOSURE({definition['name']}, {env_type} {', ' + ', '.join(env_creation) if env_creation else ''})"
+        env_args = f"{env_type} {', ' + ', '.join(env_creation) if env_creation else ''}"
+        if direct_n is not None:
+            out = f"U_NEW_DIRECT_CLOSURE({impl_name}, {impl_name}_d, {direct_n}, {env_args})"
+        else:
+            macro = "U_NEW_STACK_CLOSURE" if stack_env else "U_NEW_CLOSURE"
+            out = f"{macro}({impl_name}, {env_args})"
 
         if name is not None:
             out = f"Value {name} = {out}"
@@ -560,6 +1014,9 @@ class Compiler:
         )
 
     def if_(self, node: If, link: int) -> tstr:
+        if not node.expression and (out := self._str_dispatch_(node)) is not None:
+            return out
+
         if node.expression:
             out = tstr("(__cbool__($condition) ? ($then) : ($else))")
         else:
@@ -579,12 +1036,172 @@ class Compiler:
 
         return out
 
+    # An if/else-if ladder must compare one variable against at least this
+    # many distinct string literals before it compiles to a hash switch;
+    # below that, the comparison chain is just as fast.
+    _STR_DISPATCH_MIN = 4
+
+    def _str_dispatch_(self, node: If) -> tstr | None:
+        """Compiles `if x == "a" ... else if x == "b" ...` ladders into a
+        switch on the sds content hash: one hash computation (cached in
+        the string's header after the first dispatch) plus one equality
+        verify replace k sequential str__eq__ calls. Reordering the probes
+        is safe because every condition is the same pure variable-literal
+        comparison; a failed verify falls through to the default arm."""
+        # (hash, literal link, then-branch link) per distinct literal; a
+        # repeated literal is unreachable (first match wins) and dropped.
+        arms: list[tuple[int, Any, Any]] = []
+        seen: set[bytes] = set()
+        scrut_link: Any = None
+        name: str | None = None
+        default_link: Any = None
+
+        current, current_link = node, None
+        while True:
+            arm = self._eq_string_arm_(current)
+            if arm is None or (name is not None and arm[1] != name):
+                if current is node:
+                    return None
+                # The ladder continues with a different shape; compile the
+                # rest as the default branch.
+                default_link = current_link
+                break
+            ident_link, ident_name, data = arm
+            if name is None:
+                name, scrut_link = ident_name, ident_link
+            if data not in seen:
+                seen.add(data)
+                arms.append(
+                    (sds_content_hash(data), current.condition, current.then_branch)
+                )
+
+            else_link = current.else_branch
+            if else_link is None:
+                break
+            nxt = self.unlink(else_link)
+            if isinstance(nxt, Block) and len(nxt.body) == 1:
+                inner = self.unlink(nxt.body[0])
+                if isinstance(inner, If) and not inner.expression:
+                    current, current_link = inner, nxt.body[0]
+                    continue
+            if isinstance(nxt, If) and not nxt.expression:
+                current, current_link = nxt, else_link
+                continue
+            default_link = else_link
+            break
+
+        if len(arms) < self._STR_DISPATCH_MIN:
+            return None
+        # A `break` in an arm body would bind to the switch instead of the
+        # enclosing loop.
+        if any(self._breaks_out_(branch) for _, _, branch in arms) or (
+            default_link is not None and self._breaks_out_(default_link)
+        ):
+            return None
+
+        self.include.add("numerobis/types/str")
+        self.include.add("numerobis/closures")
+        scrut = str(self.compile(scrut_link))
+
+        label = f"__nomatch_{self.uid}_{self._dispatch_n}"
+        self._dispatch_n += 1
+
+        # Colliding literal hashes (possible, if unlikely) share a case
+        # and verify sequentially, in source order.
+        by_hash: dict[int, list[tuple[Any, Any]]] = {}
+        for h, cond_link, branch in arms:
+            by_hash.setdefault(h, []).append((cond_link, branch))
+
+        cases = []
+        for h, entries in by_hash.items():
+            tests = []
+            for cond_link, branch in entries:
+                lit = str(self.compile(self._arm_literal_(cond_link)))
+                old_defined_addrs = self._defined_addrs.copy()
+                body = ensuresuffix(str(self.compile(branch)), ";")
+                self._defined_addrs = old_defined_addrs
+                tests.append(f"if (FAST_EQ_BOOL({scrut}, {lit})) {{ {body} break; }}")
+            cases.append(f"case UINT64_C({h:#018x}):\n{' '.join(tests)}\ngoto {label};")
+
+        if default_link is not None:
+            old_defined_addrs = self._defined_addrs.copy()
+            default = ensuresuffix(str(self.compile(default_link)), ";")
+            self._defined_addrs = old_defined_addrs
+        else:
+            default = ";"
+
+        return tstr(
+            f"/* string dispatch on '{name}': one hash probe for {len(arms)} literals */\n"
+            f"switch (sdshash(({scrut}).str)) {{\n"
+            + "\n".join(cases)
+            + f"\ndefault:\n{label}:;\n{default}\n}}"
+        )
+
+    def _eq_string_arm_(self, node: If):
+        """Matches one ladder arm `<ident> == <string literal>` (either
+        side) and returns (identifier link, name, literal bytes)."""
+        cond = self.unlink(node.condition)
+        if (
+            not isinstance(cond, Compare)
+            or len(cond.ops) != 1
+            or self.unlink(cond.ops[0]).name != "eq"
+        ):
+            return None
+        a_link, b_link = cond.left, cond.comparators[0]
+        a, b = self.unlink(a_link), self.unlink(b_link)
+        if isinstance(a, String) and isinstance(b, Identifier):
+            a_link, b_link, a, b = b_link, a_link, b, a
+        if not (isinstance(a, Identifier) and isinstance(b, String)):
+            return None
+        if self._static_type(a_link) != "str":
+            return None
+        data = c_literal_bytes(b.value)
+        if data is None:
+            return None
+        return a_link, a.name, data
+
+    def _arm_literal_(self, cond_link: Any) -> Any:
+        """The string-literal side of a matched arm condition."""
+        cond = self.unlink(cond_link)
+        if isinstance(self.unlink(cond.left), String):
+            return cond.left
+        return cond.comparators[0]
+
+    def _breaks_out_(self, x) -> bool:
+        """Whether `x` contains a `break` that binds outside of it (i.e.
+        not inside a nested loop or function)."""
+        if isinstance(x, int) and not isinstance(x, bool) and x not in self.env.nodes:
+            return False
+        node = self.unlink(x)
+        if isinstance(node, Break):
+            return True
+        if isinstance(node, (ForLoop, WhileLoop, Function)):
+            return False
+        try:
+            fields = dataclasses.fields(node)
+        except TypeError:
+            return False
+        for field in fields:
+            if field.name in ("name", "annotation", "unit", "meta", "_meta", "loc"):
+                continue
+            val = getattr(node, field.name)
+            for item in val if isinstance(val, (list, tuple)) else [val]:
+                if isinstance(item, (int, Link, AstNode)) and not isinstance(
+                    item, bool
+                ):
+                    if self._breaks_out_(item):
+                        return True
+        return False
+
     def index_(self, node: Index, link: int) -> tstr:
         if self._link2type(node.index) == "slice":
             return self.slice_(node, link)
 
+        if (fast := self._elided_index(node)) is not None:
+            return fast
+
         if (iterable_type := self._link2type(node.iterable)) not in ("any", "never"):
-            self.include.add(f"numerobis/types/{iterable_type}")
+            self.include.add(self._type_include(iterable_type))
 
         out = tstr("__getitem__($iterable, $index, $loc)")
         out["index"] = str(self.compile(node.index))
@@ -623,7 +1240,12 @@ class Compiler:
         return out
 
     def location_(self, loc: Location, link: int) -> tstr:
-        return tstr(f"LOC({loc.line}, {loc.col}, {loc.end_line}, {loc.end_col})")
+        return tstr(self._loc_const(loc.line, loc.col, loc.end_line, loc.end_col))
+
+    def _loc_const(self, line: int, col: int, end_line: int, end_col: int) -> str:
+        key = (line, col, end_line, end_col)
+        idx = self._loc_consts.setdefault(key, len(self._loc_consts))
+        return f"&__locs_{self.uid}[{idx}]"
 
     def module_access_(self, node: ModuleAccess, link: int) -> tstr:
         out = tstr("$prefix$name", meta={"reference": True})
@@ -653,25 +1275,30 @@ class Compiler:
             out["type"] = typ
             unit = self.unit_suffix_(self.simplify(node.unit, do_cancel=False))
             out["unit"] = unit
+            return tstr(self._const_value(str(out)))
 
         return out
 
     def range_(self, node: Range, link: int) -> tstr:
         self.include.add("numerobis/types/range")
-        start, stop, step = (
-            self.compile(node.start),
-            self.compile(node.end),
-            self.compile(node.step) if node.step else "1",
-        )
-        start, stop, step = [
-            str(x)
-            .removeprefix("int__init__(")
-            .removeprefix("float__init__(")
-            .removesuffix(")")
-            .replace(", U_ONE", "")
-            .strip()
-            for x in [start, stop, step]
-        ]
+
+        def _raw(x) -> str:
+            # Range fields are raw longs/doubles: literal bounds compile
+            # unboxed here instead of through the Value constant pool.
+            n = self.unlink(x)
+            if isinstance(n, (Integer, Num)):
+                return str(self.number_(n, init=False))
+            return (
+                str(self.compile(x))
+                .removeprefix("int__init__(")
+                .removeprefix("float__init__(")
+                .removesuffix(")")
+                .replace(", U_ONE", "")
+                .strip()
+            )
+
+        start, stop = _raw(node.start), _raw(node.end)
+        step = _raw(node.step) if node.step else "1"
         return tstr(
             f"range__init__((Range){{ .start = {start}, .stop = {stop}, .step = {step} }})"
         )
@@ -679,7 +1306,16 @@ class Compiler:
     def return_(self, node: Return, link: int) -> tstr:
         if self.unlink(node.value) is None:
             return tstr("return NONE")
-        return tstr(f"return {self.compile(node.value)}")
+
+        # A directly returned call is in tail position; call_ lowers
+        # eligible self-calls to a goto and tags the result.
+        if isinstance(self.unlink(node.value), Call):
+            self._tail_call = True
+        compiled = self.compile(node.value)
+        self._tail_call = False
+        if compiled.meta.get("tailgoto"):
+            return compiled
+        return tstr(f"return {compiled}")
 
     def slice_(self, node: Index, link: int) -> tstr:
         index = self.unlink(node.index)
@@ -692,14 +1328,19 @@ class Compiler:
         out["step"] = self.compile(index.step) if index.step is not None else "NONE"
 
         if (iterable_type := self._link2type(node.iterable)) != "any":
-            self.include.add(f"numerobis/types/{iterable_type}")
+            self.include.add(self._type_include(iterable_type))
 
         return out
 
     def string_(self, node: String, link: int) -> tstr:
         self.include.add("numerobis/types/str")
         self.include.add("numerobis/types/number")  # str.c includes number.h
-        return tstr(f"str__init__(sdsnew({node.value}))")
+
+        name = self._str_consts.get(node.value)
+        if name is None:
+            name = f"__str_{self.uid}_{len(self._str_consts)}"
+            self._str_consts[node.value] = name
+        return tstr(self._const_value(f"str__init__({name})"))
 
     def struct_(self, node: Struct, link: int) -> tstr:
         fingerprint = f"{self.uid}_{node.meta['#struct']._fingerprint[:8]}"
@@ -780,9 +1421,15 @@ class Compiler:
         if factor == 1 and unit == "":
             return "U_ONE"
         elif factor != 1:
-            return f"U_({str(factor)}, {unit})"
+            expr = f"U_({str(factor)}, {unit})"
         else:
-            return f"U({unit})"
+            expr = f"U({unit})"
+
+        name = self._unit_consts.get(expr)
+        if name is None:
+            name = f"__unit_{self.uid}_{len(self._unit_consts)}"
+            self._unit_consts[expr] = name
+        return name
 
     def _unit_suffix_(self, node: UnitNode) -> tuple[Decimal, str]:
         match node:
@@ -824,14 +1471,34 @@ class Compiler:
         target[unit_uid(name, self.uid)] = compile_math(node.value)
 
     def variable_(self, node: Variable, link: int) -> tstr:
-        out = tstr("$name = $value")
         addr = node.meta["address"]
+        name = self.unlink(node.name).name
+
+        # Accumulation lowering: `x = x + rhs` on a provably unaliased
+        # local (accumulation_locals) extends x's buffer in place instead
+        # of copying both operands, turning O(n²) loops into O(n).
+        value = self.unlink(node.value)
+        if (
+            name in self._acc_locals[-1]
+            and name in self._defined_addrs
+            and isinstance(value, BinOp)
+            and value.op.name == "add"
+            and value.meta.get("side", 1) == 1
+            and isinstance(self.unlink(value.left), Identifier)
+            and self.unlink(value.left).name == name
+            and (typ := self._static_type(value.left)) in ("str", "list")
+        ):
+            self.include.add(f"numerobis/types/{typ}")
+            target = self.compile(node.name)
+            out = tstr(f"{target} = {typ}__append__({target}, $right)")
+            out["right"] = self.compile(value.right)
+            return out
+
+        out = tstr("$name = $value")
 
         out["name"] = self.compile(node.name)
         out["value"] = self.compile(node.value)
 
-        name = self.unlink(node.name).name
-
         if name not in self._defined_addrs and name not in self._globals[-1]:
             self._defined_addrs[name] = addr
             out = tstr("Value ") + out
@@ -865,8 +1532,12 @@ class Compiler:
         else:
             cond_str = f"__cbool__({cond_str})"
 
-        out = tstr(f"while ({cond_str}) $body")
-        out["body"] = body
+        self.include.add("numerobis/utils/arena")
+        out = tstr(
+            f"{{\nU_ARENA_SCOPE($arena);\nwhile ({cond_str}) {{\nu_arena_rewind($arena);\n$body\n}}}}"
+        )
+        out["arena"] = f"__arena_{abs(link)}"
+        out["body"] = strip_parens(str(body), "{")
         return out
 
     def unlink(self, link: SameType) -> SameType:
@@ -929,6 +1600,10 @@ class Compiler:
     def start(self) -> CompiledModule:
         self.process_header()
         self.preprocess()
+        # Constant folding and dead-branch elimination over the linked
+        # table; runs after preprocessing so literal values are already
+        # normalized against their units.
+        Folder(self.program, module=self.module, namespaces=self.env).start()
         self._builtins()
 
         code = []
@@ -938,6 +1613,62 @@ class Compiler:
 
         code = "\n".join(code).strip()
 
+        if self._loc_consts:
+            entries = ",\n".join(
+                f"    {{{line}, {col}, {end_line}, {end_col}}}"
+                for line, col, end_line, end_col in self._loc_consts
+            )
+            self.typedefs.append(
+                f"static const Location __locs_{self.uid}"
+                f"[{len(self._loc_consts)}] = {{\n{entries}\n}};"
+            )
+
+        # Prepended first so it ends up after the str/unit pools below:
+        # the pooled Values reference the interned sds and unit globals.
+        if self._value_consts:
+            self.typedefs.append(
+                "\n".join(
+                    f"static Value {name};" for name in self._value_consts.values()
+                )
+            )
+            pool = "\n".join(
+                f"{name} = {expr};" for expr, name in self._value_consts.items()
+            )
+            self.functions.insert(
+                0,
+                f"static void __value_pool_{self.uid}(void) {{\n{pool}\n}}",
+            )
+            code = f"__value_pool_{self.uid}();\n{code}"
+
+        if self._str_consts:
+            self.typedefs.append(
+                "\n".join(f"static sds {name};" for name in self._str_consts.values())
+            )
+            pool = "\n".join(
+                f"{name} = sdsnewlen({lit}, sizeof({lit}) - 1);"
+                for lit, name in self._str_consts.items()
+            )
+            self.functions.insert(
+                0,
+                f"static void __str_pool_{self.uid}(void) {{\n{pool}\n}}",
+            )
+            code = f"__str_pool_{self.uid}();\n{code}"
+
+        if self._unit_consts:
+            self.typedefs.append(
+                "\n".join(
+                    f"static uint64_t {name};" for name in self._unit_consts.values()
+                )
+            )
+            pool = "\n".join(
+                f"{name} = {expr};" for expr, name in self._unit_consts.items()
+            )
+            self.functions.insert(
+                0,
+                f"static void __unit_pool_{self.uid}(void) {{\n{pool}\n}}",
+            )
+            code = f"__unit_pool_{self.uid}();\n{code}"
+
         self.env.foreign = {
             name: uid.removeprefix("und_").removesuffix("_")
             for name, uid in self._imported_names.items()
@@ -949,8 +1680,10 @@ class Compiler:
             include=self.include,
             code=code,
             functions=self.functions,
+            symbols=self.symbols,
             typedefs=self.typedefs,
             structs=self.structs,
+            externs=self.externs,
             units=self.units,
         )
 
@@ -995,12 +1728,31 @@ class Compiler:
     def _node2type(self, node) -> T:
         return self.env.names[node.meta["address"]]
 
+    def _static_type(self, link: int | Link | Any) -> str:
+        """Like _link2type, but returns 'any' for untyped/unlinked nodes."""
+        link = link.target if isinstance(link, Link) else link
+        if not isinstance(link, int):
+            return "any"
+        return self.env.typed.get(link, "any")
+
+    def _type_include(self, typ: str) -> str:
+        return f"numerobis/types/{self._TYPE_HEADERS.get(typ, typ)}"
+
     def _link2type(self, link: int | Link | Any) -> str:
         link = link.target if isinstance(link, Link) else link
         if not isinstance(link, int):
             raise TypeError(f"Expected int, got {type(link).__name__}")
         return self.env.typed[link]
 
+    def _const_value(self, expr: str) -> str:
+        """Interns a side-effect-free Value expression into the module's
+        constant pool; use sites load the prebuilt global instead."""
+        name = self._value_consts.get(expr)
+        if name is None:
+            name = f"__const_{self.uid}_{len(self._value_consts)}"
+            self._value_consts[expr] = name
+        return name
+
     def _make_block(self, node: AstNode, rtrn: bool = False) -> Block:
         if isinstance(self.unlink(node), Block):
             return node  # type: ignore
@@ -11,7 +11,7 @@ from typing import Optional
 from numerobis.utils import is_unix
 
 from ..classes import CompiledUnits, ModuleMeta
-from .utils import repr_double
+from .utils import prepare_source_blobs
 
 
 @lru_cache(maxsize=None)
@@ -54,19 +54,6 @@ def _prepare_units_h(units: CompiledUnits) -> str:
 
 
 def _prepare_source_c(modules: list[ModuleMeta], units_h: str, units: CompiledUnits):
-    arrays, structs, entries = [], [], []
-
-    for i, mod in enumerate(modules):
-        src_lines = mod.source.splitlines()
-        c_lines = ", ".join(repr_double(line) for line in src_lines)
-        path_str = repr_double(str(mod.path))
-
-        arrays.append(f"static const char *lines_{i}[] = {{ {c_lines} }};")
-        structs.append(
-            f"static NumerobisProgram mod_{i} = {{ {path_str}, {len(src_lines)}, lines_{i} }};"
-        )
-        entries.append(f"shput(NUMEROBIS_MODULE_REGISTRY, {path_str}, &mod_{i});")
-
     unit_names = "\n".join(
         f'    [{uid}] = "{name}",' for uid, name in units.names.items()
     )
@@ -74,20 +61,9 @@ def _prepare_source_c(modules: list[ModuleMeta], units_h: str, units: CompiledUn
     source = f"""#include <math.h>
     #include <stdbool.h>
     #include <stdint.h>
-    #include <numerobis/libs/stb_ds.h>
     #include "{units_h}"
 
-    typedef struct {{
-        const char *path;
-        const int n_lines;
-        const char **source;
-    }} NumerobisProgram;
-
-    typedef struct {{ char *key; NumerobisProgram *value; }} ModuleEntry;
-    extern ModuleEntry *NUMEROBIS_MODULE_REGISTRY;
-
-    {chr(10).join(arrays)}
-    {chr(10).join(structs)}
+    {prepare_source_blobs(modules)}
 
     static inline double logn(double b, double x) {{return log(x) / log(b);}}
 
@@ -122,11 +98,6 @@ def _prepare_source_c(modules: list[ModuleMeta], units_h: str, units: CompiledUn
     const char *NUMEROBIS_UNIT_NAMES[] = {{
     {unit_names}
     }};
-
-    __attribute__((constructor))
-    void u_init_module_registry() {{
-        {chr(10).join(entries)}
-    }}
     """
     return source
 
@@ -170,6 +141,18 @@ def compile(
     if is_unix:
         flags.add("-fno-plt")
 
+    # --compact-values programs must link the runtime variant built with the
+    # matching Value layout; -flto links pick the fat-LTO archive so runtime
+    # hot paths can inline into the generated code.
+    compact = "-DNBIS_COMPACT_VALUE" in flags
+    lto = any(f == "-flto" or f.startswith("-flto=") for f in flags)
+    if compact:
+        runtime_lib, graphics_lib = "libruntime_compact.a", "libgraphics_compact.a"
+    elif lto:
+        runtime_lib, graphics_lib = "libruntime_lto.a", "libgraphics_lto.a"
+    else:
+        runtime_lib, graphics_lib = "libruntime.a", "libgraphics.a"
+
     with resources.as_file(resources.files("numerobis")) as base_path:
         runtime_path = base_path / "runtime"
 
@@ -180,7 +163,7 @@ def compile(
         graphics_libs = (
             [
                 "-Wl,--whole-archive",
-                str(runtime_path / "libgraphics.a"),
+                str(runtime_path / graphics_lib),
                 "-Wl,--no-whole-archive",
             ]
             + sdl2_libs
@@ -201,7 +184,7 @@ def compile(
             + sdl2_ttf_cflags
             + [
                 "-Wl,--whole-archive",
-                str(runtime_path / "libruntime.a"),
+                str(runtime_path / runtime_lib),
                 "-Wl,--no-whole-archive",
             ]
             + graphics_libs
@@ -15,7 +15,7 @@ from ..utils import STDLIB_PATH
 from . import cmake
 from . import gcc as gnucc
 from .tstr import tstr
-from .utils import module_uid
+from .utils import mangle, module_uid
 
 
 class Linker:
@@ -60,7 +60,10 @@ class Linker:
 
     def _structs(self, structs: list[StructType]) -> tuple[list[str], str]:
         if not structs:
-            return [], "const StructInfo STRUCT_REGISTRY[0] = {};"
+            return [], (
+                "const StructInfo STRUCT_REGISTRY[0] = {};\n"
+                "const size_t STRUCT_REGISTRY_LEN = 0;"
+            )
 
         fieldcounts = {len(node.fields) for node in structs}
         funcs = []
@@ -83,18 +86,49 @@ class Linker:
             funcs.append(str(init))
 
         # Struct registry entry
+        eq_funcs: dict[str, str] = {}
         for struct in structs:
             id = f"STRUCT_{struct.name_}_{struct._fingerprint}"
             ids.append(id)
             entries.append(
-                f'[{id}]  = {{"{struct.name_}",  (const char*[]){{"{'","'.join(struct.names)}"}}, {len(struct.fields)}}}'
+                f'[{id}]  = {{"{struct.name_}",  (const char*[]){{"{'","'.join(struct.names)}"}}, {len(struct.fields)}, __struct_eq_{id}}}'
             )
+            if id not in eq_funcs:
+                eq_funcs[id] = self._struct_eq(struct, id)
 
         macros = "\n".join(f"#define {id} {i}" for i, id in enumerate(ids))
-        out = f"{macros}\nconst StructInfo STRUCT_REGISTRY[{len(structs)}] = {{\n    {',\n    '.join(entries)}\n}};"
+        out = f"{macros}\n{'\n\n'.join(eq_funcs.values())}\nconst StructInfo STRUCT_REGISTRY[{len(structs)}] = {{\n    {',\n    '.join(entries)}\n}};\nconst size_t STRUCT_REGISTRY_LEN = {len(structs)};"
 
         return funcs, out
 
+    def _struct_eq(self, struct: StructType, id: str) -> str:
+        """Specialized comparator: field types are static, so numeric,
+        string and bool fields compare with direct calls instead of the
+        per-field NUMEROBIS_METHODS dispatch in the generic struct__eq__;
+        only fields of dynamic type keep the generic __eq__."""
+        cmps = []
+        for i, field in enumerate(struct.fields):
+            slot = i + 1
+            match field.name():
+                case "Int" | "Num":
+                    cmp = f"number__eq__(a[{slot}], b[{slot}]).boolean"
+                case "Str":
+                    cmp = f"str__eq__(a[{slot}], b[{slot}]).boolean"
+                case "Bool":
+                    cmp = f"(a[{slot}].boolean == b[{slot}].boolean)"
+                case _:
+                    cmp = f"__eq__(a[{slot}], b[{slot}]).boolean"
+            cmps.append(f"if (!{cmp}) return VFALSE;")
+        body = "\n    ".join(cmps)
+        return (
+            f"static Value __struct_eq_{id}(Value _a, Value _b) {{\n"
+            f"    Value *a = _a.strukt, *b = _b.strukt;\n"
+            f"    (void)a; (void)b;\n"
+            f"    {body}\n"
+            f"    return VTRUE;\n"
+            f"}}"
+        )
+
     def link(self, print_: bool = False, format: bool = False):
         self.process_module(self.modules[str(self.main)])
 
@@ -112,23 +146,32 @@ class Linker:
                     char **NUMEROBIS__ARGV__;
                     int NUMEROBIS__ARGC__;
 
-                    extern void u_init_module_registry(void);
-
                     $structs
 
+                    $externs
+
                     $functions
 
+                    $symbols
+
                     int main(int argc, char **argv) {
                         NUMEROBIS__ARGV__ = argv;
                         NUMEROBIS__ARGC__ = argc;
 
-                        u_init_module_registry();
+                    #ifdef NBIS_NO_GC
+                        /* GC-free build (--no-gc): the runtime constructors
+                         * have built their startup pools; from here on the
+                         * collector never runs, so allocation is a pure
+                         * pointer bump with no pauses. The region check
+                         * proved steady-state allocation bounded. */
+                        GC_disable();
+                    #endif
 
+                        $extern_resolve
                         $output
                         return 0;
                     }""")
 
-        code["include"] = "\n".join([f"#include <{lib}.h>" for lib in self.include])
         code["filehashes"] = ", ".join([f"__FILE__{uid}" for uid in self.order[1]])
         code["filenames"] = ", ".join(
             [f'"{self._path(file).replace("\\", "\\\\")}"' for file in self.order[0]]
@@ -136,8 +179,10 @@ class Linker:
 
         output = []
         functions = []
+        symbols: list[tuple[str, str]] = []
         typedefs = []
         structs = []
+        externs: list[str] = []
         for file, uid in zip(*self.order):
             module = self.modules[file]
             module.meta.path = Path(self._path(file))
@@ -145,13 +190,62 @@ class Linker:
                 f"/* {self._path(file)} */\nNUMEROBIS__FILE__ = __FILE__{uid};\n{module.code}\n"
             )
             functions.extend(module.functions)
+            symbols.extend(
+                (impl, f"{self._path(file)}:{name}") for impl, name in module.symbols
+            )
             typedefs.extend(module.typedefs)
             structs.extend(module.structs)
+            for name in module.externs:
+                if name not in externs:
+                    externs.append(name)
 
         self.order[0] = [self._path(file) for file in self.order[0]]
 
         struct_funcs, struct_defs = self._structs(structs)
         functions = struct_funcs + functions
+        if structs:
+            # The generated comparators call number__eq__/str__eq__
+            # directly.
+            self.include.update({"numerobis/types/number", "numerobis/types/str"})
+        # NumerobisSymbol for the profiler symbol table emitted below.
+        self.include.add("numerobis/utils/profiler")
+        # GC_disable for the main() prologue of --no-gc builds.
+        self.include.add("numerobis/libs/bdwgc/include/gc")
+        code["include"] = "\n".join([f"#include <{lib}.h>" for lib in self.include])
+
+        # Dense extern dispatch: every extern name used anywhere in the
+        # program gets a slot, resolved once at startup; declarations in
+        # module code compile to U_EXTERNS[U_EXT_<name>] indexed loads.
+        if externs:
+            ids = ", ".join(f"U_EXT_{mangle(n)}" for n in externs)
+            names = ", ".join(f'"{n.replace("_", "__")}"' for n in externs)
+            code["externs"] = (
+                f"enum {{ {ids}, U_EXTERN_COUNT }};\n"
+                f"static const char *const U_EXTERN_NAMES[U_EXTERN_COUNT] = {{{names}}};\n"
+                f"static Value U_EXTERNS[U_EXTERN_COUNT];"
+            )
+            code["extern_resolve"] = (
+                "u_externs_resolve(U_EXTERN_NAMES, U_EXTERNS, U_EXTERN_COUNT);"
+            )
+        else:
+            code["externs"] = ""
+            code["extern_resolve"] = ""
+
+        # Profiler symbol table (utils/profiler.h): one entry per compiled
+        # Numerobis function so SIGPROF samples map back to source names.
+        if symbols:
+            entries = ",\n    ".join(
+                f'{{(void *){impl}, "{name}"}}' for impl, name in symbols
+            )
+            code["symbols"] = (
+                f"const NumerobisSymbol NUMEROBIS_SYMBOLS[] = {{\n    {entries}\n}};\n"
+                f"const int NUMEROBIS_SYMBOL_COUNT = {len(symbols)};"
+            )
+        else:
+            code["symbols"] = (
+                "const NumerobisSymbol NUMEROBIS_SYMBOLS[1] = {{0, 0}};\n"
+                "const int NUMEROBIS_SYMBOL_COUNT = 0;"
+            )
 
         code["output"] = "\n\n".join(output)
         code["functions"] = "\n\n".join(functions)
@@ -7,9 +7,14 @@ from numerobis.nodes.unit import Expression
 
 from ..nodes.ast import (
     Attribute,
+    BinOp,
+    Call,
     ForLoop,
     Function,
+    List,
     ModuleAccess,
+    Return,
+    String,
     StructInit,
     Variable,
     VariableDeclaration,
@@ -19,6 +24,22 @@ from ..typechecker.linking import Link
 from ..typechecker.linking import unlink as _unlink
 
 
+# Built-in higher-order callees that invoke a function argument during
+# the call and never retain it afterwards. A lambda passed directly into
+# one of these cannot outlive the enclosing C block, so its closure and
+# captured environment may live on the caller's stack instead of the GC
+# heap (U_NEW_STACK_CLOSURE in runtime closures.h). Callees that keep
+# the function alive past the call — spawn, most prominently — must
+# never be listed here.
+NON_RETAINING_CALLEES = frozenset(
+    {
+        "List.sortby",
+        "parallel_map",
+        "parallel_for",
+    }
+)
+
+
 def get_free_vars(
     table: dict[int, AstNode], node: Function, link: int, defined_addrs: dict[str, str]
 ) -> list[str]:
@@ -104,3 +125,101 @@ def get_free_vars(
         visit(unlink(param).default, defined)
 
     return sorted(list(used))
+
+
+# Callees that read their arguments during the call and never retain
+# them afterwards: passing an accumulation variable here cannot keep its
+# buffer alive past the next append.
+NON_RETAINING_ARG_CALLEES = frozenset({"echo"})
+
+
+def accumulation_locals(
+    table: dict[int, AstNode], body: AstNode, exclude: set[str]
+) -> set[str]:
+    """
+    Finds locals that are only ever rebuilt by `x = x + rhs` and never
+    aliased, so the compiler may lower those reassignments to in-place
+    appends (str__append__ / list__append__) instead of copying both
+    operands on every iteration.
+
+    A name qualifies when every assignment to it is a string/list literal
+    or an accumulation `x = x + rhs`, and every other read provably does
+    not retain the buffer: the accumulation's own left operand, a direct
+    argument to a NON_RETAINING_ARG_CALLEES callee, or a bare `return x`
+    (no append runs in this activation afterwards). Any use inside a
+    nested function disqualifies the name — the closure captures the
+    Value at creation time and would observe later in-place growth.
+    """
+    unlink = lambda x: _unlink(table, x)  # noqa: E731
+
+    candidates: set[str] = set()
+    unsafe: set[str] = set()
+    sanctioned: set[int] = set()  # id()s of Identifier reads proven safe
+
+    def visit(n: Any, in_function: bool):
+        if isinstance(n, Link):
+            n = table[n.target]
+
+        try:
+            fields = dataclasses.fields(n)
+        except TypeError:
+            return
+
+        match n:
+            case Identifier():
+                if in_function or id(n) not in sanctioned:
+                    unsafe.add(n.name)
+                return
+            case Variable() if not in_function:
+                var_name = unlink(n.name).name
+                value = unlink(n.value)
+                if (
+                    isinstance(value, BinOp)
+                    and value.op.name == "add"
+                    and value.meta.get("side", 1) == 1
+                    and isinstance(left := unlink(value.left), Identifier)
+                    and left.name == var_name
+                ):
+                    # Accumulation site: its own left operand is the read
+                    # the lowering replaces.
+                    sanctioned.add(id(left))
+                    if var_name not in exclude:
+                        candidates.add(var_name)
+                elif not isinstance(value, (String, List)):
+                    # Any non-literal initializer may hand us a buffer
+                    # something else still references.
+                    unsafe.add(var_name)
+            case Variable():
+                unsafe.add(unlink(n.name).name)
+            case Return() if not in_function:
+                value = unlink(n.value) if n.value is not None else None
+                if isinstance(value, Identifier):
+                    sanctioned.add(id(value))
+            case Call() if not in_function:
+                callee = unlink(n.callee)
+                if (
+                    isinstance(callee, Identifier)
+                    and callee.name in NON_RETAINING_ARG_CALLEES
+                ):
+                    for arg in n.args:
+                        value = unlink(unlink(arg).value)
+                        if isinstance(value, Identifier):
+                            sanctioned.add(id(value))
+            case Function():
+                in_function = True
+            case Expression():
+                return
+
+        for field in fields:
+            if field.name in ("name", "annotation", "unit", "meta", "_meta"):
+                continue
+
+            val = getattr(n, field.name)
+            if isinstance(val, (list, tuple)):
+                for item in val:
+                    visit(item, in_function)
+            elif val is not None:
+                visit(val, in_function)
+
+    visit(body, False)
+    return candidates - unsafe
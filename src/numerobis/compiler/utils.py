@@ -12,15 +12,52 @@ BUILTINS = [
     "echo",
     "input",
     "exit",
+    "memoize",
     "Str.len",
     "Str.split",
+    "Str.find",
+    "Str.contains",
+    "Str.count",
+    "Str.replace",
     "List.len",
     "List.append",
     "List.extend",
     "List.pop",
+    "List.popleft",
+    "List.pushleft",
     "List.insert",
+    "List.reserve",
     "List.indexof",
     "List.contains",
+    "List.sort",
+    "List.sortby",
+    "List.ewadd",
+    "List.ewsub",
+    "List.ewmul",
+    "List.ewdiv",
+    "List.scale",
+    "List.offset",
+    "List.sum",
+    "List.mean",
+    "List.min",
+    "List.max",
+    "List.dot",
+    "List.column",
+    "List.setcolumn",
+    "map",
+    "Map.len",
+    "Map.get",
+    "Map.contains",
+    "Map.remove",
+    "Map.keys",
+    "Map.values",
+    "strbuilder",
+    "StrBuilder.append",
+    "StrBuilder.appendnum",
+    "StrBuilder.len",
+    "StrBuilder.build",
+    "to_json",
+    "from_json",
     "cli_args",
 ]
 
@@ -29,8 +66,156 @@ def ensuresuffix(s: str, ch: str) -> str:
     return s if s.endswith(ch) else s + ch
 
 
+# Escape sequences the string-dispatch hasher understands. Literals using
+# anything else (hex, octal, universal character names) keep the plain
+# comparison chain rather than risk hashing different bytes than the C
+# compiler produces.
+_C_ESCAPES = {
+    "n": b"\n",
+    "t": b"\t",
+    "r": b"\r",
+    "0": b"\0",
+    "\\": b"\\",
+    '"': b'"',
+    "'": b"'",
+    "a": b"\a",
+    "b": b"\b",
+    "f": b"\f",
+    "v": b"\v",
+}
+
+
+def c_literal_bytes(lit: str) -> bytes | None:
+    """The runtime bytes of a quoted string literal as the C compiler will
+    encode them, or None for escape sequences this decoder does not model."""
+    text = lit[1:-1]
+    out = bytearray()
+    i = 0
+    while i < len(text):
+        ch = text[i]
+        if ch == "\\":
+            esc = _C_ESCAPES.get(text[i + 1]) if i + 1 < len(text) else None
+            if esc is None:
+                return None
+            out += esc
+            i += 2
+        else:
+            out += ch.encode("utf-8")
+            i += 1
+    return bytes(out)
+
+
+def sds_content_hash(data: bytes) -> int:
+    """Mirror of sdshash (runtime/numerobis/libs/sds.c): FNV-1a 64 with a
+    zero result remapped, so literal hashes computed at compile time match
+    the runtime's cached content hashes."""
+    h = 0xCBF29CE484222325
+    for byte in data:
+        h ^= byte
+        h = (h * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return h if h else 0x9E3779B97F4A7C15
+
+
+def lzss_compress(data: bytes) -> str | bytes:
+    """LZSS with a 4 KiB window and 3..18 byte matches, the counterpart
+    of _lzss_decompress in runtime/numerobis/exceptions/source.c.
+
+    Stream format: a flag byte followed by eight items, LSB first.
+    Flag bit 0 = literal byte; 1 = match pair (lo = distance & 0xFF,
+    hi = (distance >> 8) << 4 | (length - 3))."""
+    out = bytearray()
+    n = len(data)
+    i = 0
+    heads: dict[bytes, list[int]] = {}
+    while i < n:
+        flags = 0
+        items = bytearray()
+        for bit in range(8):
+            if i >= n:
+                break
+            best_len = 0
+            best_dist = 0
+            key = data[i : i + 3]
+            if len(key) == 3:
+                for j in reversed(heads.get(bytes(key), [])[-32:]):
+                    dist = i - j
+                    if dist > 4095:
+                        break
+                    max_len = min(18, n - i)
+                    length = 3
+                    while length < max_len and data[j + length] == data[i + length]:
+                        length += 1
+                    if length > best_len:
+                        best_len = length
+                        best_dist = dist
+                        if length == 18:
+                            break
+            if best_len >= 3:
+                flags |= 1 << bit
+                items.append(best_dist & 0xFF)
+                items.append(((best_dist >> 8) << 4) | (best_len - 3))
+                for k in range(i, i + best_len):
+                    if k + 3 <= n:
+                        heads.setdefault(bytes(data[k : k + 3]), []).append(k)
+                i += best_len
+            else:
+                items.append(data[i])
+                if i + 3 <= n:
+                    heads.setdefault(bytes(data[i : i + 3]), []).append(i)
+                i += 1
+        out.append(flags)
+        out += items
+    return bytes(out)
+
+
+def prepare_source_blobs(modules) -> str:
+    """C declarations for the compressed error-source registry: one
+    LZSS blob per module in a dedicated `nbis_src` section plus a
+    lookup table, decompressed lazily by u_throw's preview printer
+    (exceptions/source.c). Replaces the startup registration loop."""
+    decls, entries = [], []
+    for i, mod in enumerate(modules):
+        lines = mod.source.splitlines()
+        raw = "\n".join(lines).encode("utf-8")
+        comp = lzss_compress(raw)
+        byte_list = ",".join(str(b) for b in comp) or "0"
+        decls.append(
+            f'__attribute__((section("nbis_src"))) '
+            f"static const unsigned char src_{i}[] = {{ {byte_list} }};"
+        )
+        entries.append(
+            f"{{ {repr_double(str(mod.path))}, {len(lines)}, "
+            f"src_{i}, {len(comp)}u, {len(raw)}u }}"
+        )
+
+    count = len(entries)
+    if not entries:
+        entries.append("{ 0, 0, 0, 0u, 0u }")
+
+    return f"""
+    typedef struct {{
+        const char *path;
+        int n_lines;
+        const unsigned char *data;
+        unsigned int comp_len;
+        unsigned int raw_len;
+    }} NumerobisSourceBlob;
+
+    {chr(10).join(decls)}
+
+    const NumerobisSourceBlob NUMEROBIS_SOURCE_BLOBS[] = {{ {", ".join(entries)} }};
+    const int NUMEROBIS_SOURCE_BLOB_COUNT = {count};
+    """
+
+
 def mthd(name, *args):
-    return f"NUMEROBIS_METHODS[{args[0]}.type]->{name}({', '.join(args)})"
+    # The leading comma operand bumps the per-ValueType dispatch counter
+    # (utils/profiler.h); a single unconditional increment, cheap enough
+    # to keep in place when profiling is off.
+    return (
+        f"(NUMEROBIS_PROF_DISPATCH[{args[0]}.type]++, "
+        f"NUMEROBIS_METHODS[{args[0]}.type]->{name}({', '.join(args)}))"
+    )
 
 
 def repr_double(s):
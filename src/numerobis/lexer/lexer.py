@@ -149,8 +149,17 @@ class LexTokens:
         raise e
 
 
+# Built once per process and reused: constructing the lexer recompiles
+# every token regex, which dominates frontend startup for small sources
+# (and is pure overhead for long-lived processes like `nbis watch`).
+_LEXER = None
+
+
 def lex(source: str, module: ModuleMeta, debug=False) -> list[Token]:
-    lexer = plylex.lex(module=LexTokens())
+    global _LEXER
+    if _LEXER is None:
+        _LEXER = plylex.lex(module=LexTokens())
+    lexer = _LEXER
     errors = Exceptions(module=module)
 
     output: list[Token] = []
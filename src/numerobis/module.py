@@ -1,12 +1,17 @@
 """Module loading, parsing, and compilation pipeline."""
 
+import hashlib
+import os
+import pickle
 import subprocess
 import sys
 from functools import lru_cache
 from pathlib import Path
 from typing import Optional
 
+from ._version import __version__
 from .analysis.dimchecker import Dimchecker
+from .analysis.regions import Regioncheck
 from .classes import CompiledModule, Header, ModuleMeta
 from .compiler import cmake
 from .compiler.compiler import Compiler
@@ -23,6 +28,57 @@ from .utils import STDLIB_PATH
 # pre-compiled modules
 MODULECACHE: dict[str, CompiledModule] = {}
 
+# content keys of modules loaded this process, so importers can fold
+# their dependencies' keys into their own
+CACHEKEYS: dict[str, str] = {}
+
+# Persistent compilation cache: a module whose source, dependencies and
+# compiler version are unchanged is restored from disk instead of being
+# re-typechecked and re-compiled, so an incremental change only
+# recompiles the touched module (and its importers) and relinks.
+DISKCACHE = os.environ.get("NBIS_CACHE", "1") != "0"
+
+# Folded into every cache key; bump whenever the pickled shape of
+# CompiledModule changes so stale entries miss instead of loading with
+# missing fields.
+CACHE_SCHEMA = "2"
+
+# Set by the CLI for --no-gc builds. Folded into cache keys so a module
+# restored from cache has always passed the region check under this mode.
+NOGC = False
+
+
+def _cache_path(key: str) -> Path:
+    base = os.environ.get("NBIS_CACHE_DIR")
+    root = Path(base) if base else Path.home() / ".cache" / "numerobis"
+    return root / "modules" / f"{key}.pkl"
+
+
+def _cache_read(key: str) -> Optional[CompiledModule]:
+    if not DISKCACHE:
+        return None
+    try:
+        with open(_cache_path(key), "rb") as f:
+            return pickle.load(f)
+    except Exception:
+        return None
+
+
+def _cache_write(key: str, compiled: CompiledModule) -> None:
+    if not DISKCACHE:
+        return
+    path = _cache_path(key)
+    try:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        tmp = path.with_suffix(".tmp")
+        with open(tmp, "wb") as f:
+            pickle.dump(compiled, f)
+        tmp.replace(path)
+    except Exception:
+        # The cache is best-effort: anything unpicklable or any IO
+        # failure just means the next build recompiles this module.
+        pass
+
 
 class Module:
     def __init__(
@@ -52,6 +108,7 @@ class Module:
         self.header: Header = Header()
         self.program: list[Link] = []
         self.imports: list[str] = []
+        self._dep_keys: list[str] = []
 
         self.linker: Optional[Linker] = None
         self.compiled: CompiledModule
@@ -63,10 +120,34 @@ class Module:
                 self.namespaces.update(MODULECACHE[path].namespaces)  # type: ignore
             return MODULECACHE[path]
         self.parse()
+
+        key = self._cache_key()
+        CACHEKEYS[path] = key
+        cached = _cache_read(key)
+        if cached is not None:
+            self.compiled = cached
+            MODULECACHE[path] = cached
+            if cached.namespaces is not None:
+                self.namespaces.update(cached.namespaces)
+            return cached
+
         self.typecheck()
         self.compile()
+        _cache_write(key, self.compiled)
         return self.compiled
 
+    def _cache_key(self) -> str:
+        """Content hash of this module's source, its dependencies' keys
+        and the compiler version. Must be computed after parse(), once
+        imports are resolved and loaded."""
+        h = hashlib.sha1(
+            f"{__version__}/{CACHE_SCHEMA}{'/nogc' if NOGC else ''}".encode("utf-8")
+        )
+        h.update(self.meta.source.encode("utf-8"))
+        for dep in self._dep_keys:
+            h.update(dep.encode("utf-8"))
+        return h.hexdigest()
+
     def parse(self):
         lexed = lex(self.meta.source, module=self.meta)
         parser = Parser(lexed, module=self.meta)
@@ -82,6 +163,7 @@ class Module:
             builtins_mod = Module(STDLIB_PATH / "builtins.nbis", builtins=False)
             builtins_mod.load()
             self.namespaces.update(builtins_mod.namespaces)
+            self._dep_keys.append(CACHEKEYS.get(str(builtins_mod.meta.path), ""))
 
         if len(self.ast) == 0:
             return
@@ -98,6 +180,7 @@ class Module:
         modules = [Module(path) for path in self.imports]
         for module, node in zip(modules, self.header.imports):
             module.load()
+            self._dep_keys.append(CACHEKEYS.get(str(module.meta.path), ""))
 
             if isinstance(node, Import):
                 self.namespaces.write("imports", node.module.name, module.namespaces)
@@ -160,6 +243,10 @@ class Module:
         ts = Typechecker(self.ast, module=self.meta, namespaces=self.namespaces)
         ts.start()
         self.program = ts.program
+        if NOGC:
+            Regioncheck(
+                self.program, module=self.meta, namespaces=self.namespaces
+            ).start()
 
     def compile(self):
         compiler = Compiler(
@@ -7,6 +7,8 @@ from .types import (
     FunctionType,
     IntType,
     ListType,
+    MapType,
+    Mat3Type,
     MethodStruct,
     NoneType,
     NumberType,
@@ -15,6 +17,8 @@ from .types import (
     SliceType,
     StrType,
     VarType,
+    Vec2Type,
+    Vec3Type,
 )
 
 _numberoverload = Overload(
@@ -40,6 +44,29 @@ def _conv(this, *types):
     }
 
 
+def _vecstruct(V):
+    """Vec2/Vec3/Mat3 share one operator surface: elementwise add/sub
+    between equal shapes and scaling by a number (either side, via the
+    __rmul__ fallback in bin_op_)."""
+    scale = Overload(
+        FunctionType(params=[V(), IntType()], return_type=V()),
+        FunctionType(params=[V(), NumType()], return_type=V()),
+    )
+    return MethodStruct(
+        {
+            **_conv(V().name(), "Bool", "Str"),
+            "__add__": FunctionType(params=[V(), V()], return_type=V()),
+            "__sub__": FunctionType(params=[V(), V()], return_type=V()),
+            "__mul__": scale,
+            "__div__": scale,
+            "__getitem__": FunctionType(
+                params=[V(), IntType()], return_type=NumType()
+            ),
+            **_eq,
+        }
+    )
+
+
 _ops = ["add", "sub", "mul", "div", "mod", "pow"]
 _boolops = ["lt", "gt", "le", "ge"]
 _eq = {
@@ -133,6 +160,39 @@ typetable: dict[str, MethodStruct] = {
             **_eq,
         },
     ),
+    "Map": MethodStruct(
+        {
+            **_conv("Map", "Bool", "Str"),
+            "__getitem__": FunctionType(
+                params=[MapType(), AnyType()], return_type=AnyType()
+            ),
+            "__setitem__": FunctionType(
+                params=[MapType(), AnyType(), AnyType()], return_type=NoneType()
+            ),
+            **_eq,
+        }
+    ),
+    "StrBuilder": MethodStruct(
+        {
+            **_conv("StrBuilder", "Bool", "Str"),
+            **_eq,
+        }
+    ),
+    "File": MethodStruct(
+        {
+            **_conv("File", "Bool", "Str"),
+            **_eq,
+        }
+    ),
+    "Task": MethodStruct(
+        {
+            **_conv("Task", "Bool", "Str"),
+            **_eq,
+        }
+    ),
+    "Vec2": _vecstruct(Vec2Type),
+    "Vec3": _vecstruct(Vec3Type),
+    "Mat3": _vecstruct(Mat3Type),
     "Range": MethodStruct({**_eq}),
     "Function": MethodStruct({**_eq}),
     "StructInstance": MethodStruct({**_eq}),
@@ -650,6 +650,20 @@ class Typechecker:
                     params[i] = default
                     continue
 
+                # A dimensionless literal default must not pin a dimension
+                # variable shared with other parameters or the return type
+                # (random's `gaussian!(mean: Num[?D] = 0.0, ...)`): the
+                # dimension belongs to the call site, the default simply
+                # adopts it at runtime.
+                if (
+                    isinstance(params[i], NumberType)
+                    and not isinstance(params[i].dim, One)
+                    and isinstance(default, NumberType)
+                    and isinstance(default.dim, One)
+                ):
+                    params[i] = params[i].complete(varenv, fingerprint=link)
+                    continue
+
                 params[i] = params[i].complete(varenv, default, fingerprint=link)
 
                 if not (mismatch := nomismatch(params[i], default, unify=True)):
@@ -843,10 +857,10 @@ class Typechecker:
         index = self.check(node.target.index, env=env)
         value = self.check(node.value, env=env)
 
-        if index.dim:
+        if isinstance(index, NumberType) and index.dim:
             self.errors.throw(
                 537,
-                dimension=value.dim,
+                dimension=index.dim,
                 loc=node.loc,
             )
 
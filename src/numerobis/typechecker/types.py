@@ -20,6 +20,13 @@ T = Union[
     "StrType",
     "SliceType",
     "ListType",
+    "MapType",
+    "StrBuilderType",
+    "FileType",
+    "TaskType",
+    "Vec2Type",
+    "Vec3Type",
+    "Mat3Type",
     "FunctionType",
     "StructInstance",
 ]
@@ -190,6 +197,48 @@ class ListType(UType):
         return self.edit(content=completed, dim=completed.dim)
 
 
+@dataclass(kw_only=True, frozen=True)
+class MapType(UType):
+    def __eq__(self, other):
+        return isinstance(other, MapType)
+
+
+@dataclass(kw_only=True, frozen=True)
+class StrBuilderType(UType):
+    def __eq__(self, other):
+        return isinstance(other, StrBuilderType)
+
+
+@dataclass(kw_only=True, frozen=True)
+class FileType(UType):
+    def __eq__(self, other):
+        return isinstance(other, FileType)
+
+
+@dataclass(kw_only=True, frozen=True)
+class TaskType(UType):
+    def __eq__(self, other):
+        return isinstance(other, TaskType)
+
+
+@dataclass(kw_only=True, frozen=True)
+class Vec2Type(UType):
+    def __eq__(self, other):
+        return isinstance(other, Vec2Type)
+
+
+@dataclass(kw_only=True, frozen=True)
+class Vec3Type(UType):
+    def __eq__(self, other):
+        return isinstance(other, Vec3Type)
+
+
+@dataclass(kw_only=True, frozen=True)
+class Mat3Type(UType):
+    def __eq__(self, other):
+        return isinstance(other, Mat3Type)
+
+
 @dataclass(kw_only=True, frozen=True)
 class SliceType(UType):
     def __eq__(self, other):
@@ -290,6 +339,13 @@ class AnyType(UType):
             "bool": BoolType(),
             "str": StrType(),
             "list": ListType(),
+            "map": MapType(),
+            "strbuilder": StrBuilderType(),
+            "file": FileType(),
+            "task": TaskType(),
+            "vec2": Vec2Type(),
+            "vec3": Vec3Type(),
+            "mat3": Mat3Type(),
             "slice": SliceType(),
             "range": RangeType(),
             "function": FunctionType(),
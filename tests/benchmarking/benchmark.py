@@ -1,6 +1,32 @@
+"""Statistical benchmark harness for the references in src/.
+
+Each test exists as .nbis, .c and .py; every variant is compiled once,
+run WARMUP times unmeasured and RUNS times measured, and reported as
+median wall time with the median absolute deviation (MAD) as the spread
+estimate (both are robust against scheduler outliers, unlike mean/stddev).
+
+    --perf            capture cycles/instructions/cache-misses per run
+                      via `perf stat` (skipped if perf is unavailable)
+    --save-baseline   write medians to out/baseline.json (with the
+                      current commit) for later comparison
+    --baseline FILE   compare against a saved baseline; deltas beyond
+                      both --threshold and 3x the combined MAD are
+                      flagged as regressions/improvements
+
+Exits non-zero if any regression is flagged, so the comparison can gate CI.
+"""
+
+import argparse
+import json
 import os
+import re
+import shutil
+import statistics
 import subprocess
+import sys
+import time
 from collections import defaultdict
+from datetime import datetime, timezone
 from pathlib import Path
 
 from tqdm import tqdm
@@ -13,57 +39,246 @@ os.makedirs(out, exist_ok=True)
 
 actions = {
     "py": {"compile": "cp {src} {bin}", "run": "python3 {bin}"},
-    "c": {"compile": "gcc {src} -o {bin}", "run": "{bin}"},
+    "c": {"compile": "gcc -O3 {src} -o {bin}", "run": "{bin}"},
     "nbis": {"compile": "nbis build {src} -o {bin}", "run": "{bin}"},
 }
 
+PERF_EVENTS = ["cycles", "instructions", "cache-misses"]
 
-files = os.listdir(path / "src")
-tests = defaultdict(dict)
-for file in files:
-    filepath = path / "src" / file
-    name = filepath.stem
-    ending = filepath.suffix[1:]
-    if ending not in actions:
-        continue
-    tests[name][ending] = {"src": filepath, "bin": out / (filepath.name + ".bin")}
 
-print(f"Collected {len(tests)} tests")
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--warmup", type=int, default=3, metavar="N")
+    parser.add_argument("--runs", type=int, default=20, metavar="M")
+    parser.add_argument(
+        "--perf", action="store_true", help="capture perf counters per run"
+    )
+    parser.add_argument(
+        "--save-baseline",
+        nargs="?",
+        const=str(out / "baseline.json"),
+        default=None,
+        metavar="FILE",
+        help="write results as the new baseline",
+    )
+    parser.add_argument(
+        "--baseline",
+        default=None,
+        metavar="FILE",
+        help="compare against a saved baseline",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5.0,
+        metavar="PCT",
+        help="minimum %% delta to flag against the baseline",
+    )
+    parser.add_argument(
+        "--only", default=None, metavar="NAME", help="run a single test"
+    )
+    return parser.parse_args()
 
-with tqdm(total=len(tests) * len(actions), desc="Compiling tests") as pbar:
-    for name, test in tests.items():
-        for ending, filepath in test.items():
-            src = filepath["src"]
-            bin = filepath["bin"]
 
-            cmd = actions[ending]["compile"].format(bin=bin, src=src)
-            subprocess.run(cmd, shell=True, stdout=subprocess.DEVNULL)
-            pbar.update()
+def collect(only=None):
+    tests = defaultdict(dict)
+    for file in os.listdir(path / "src"):
+        filepath = path / "src" / file
+        name = filepath.stem
+        ending = filepath.suffix[1:]
+        if ending not in actions:
+            continue
+        if only and name != only:
+            continue
+        tests[name][ending] = {"src": filepath, "bin": out / (filepath.name + ".bin")}
+    return tests
 
 
-print("\n" + "=" * 80)
-print("Starting Benchmarks")
-print("=" * 80 + "\n")
+def compile_tests(tests):
+    total = sum(len(test) for test in tests.values())
+    with tqdm(total=total, desc="Compiling tests") as pbar:
+        for name, test in tests.items():
+            for ending, filepath in test.items():
+                cmd = actions[ending]["compile"].format(
+                    bin=filepath["bin"], src=filepath["src"]
+                )
+                subprocess.run(cmd, shell=True, stdout=subprocess.DEVNULL)
+                pbar.update()
 
-for name, test in tests.items():
-    print("\n" + "#" * 80)
-    print(f"# Benchmark: {name}")
-    print("#" * 80 + "\n")
 
-    for ending, filepath in test.items():
-        bin_path = filepath["bin"]
+def run_once(cmd):
+    """One measured run: wall time in seconds, or None on failure."""
+    start = time.perf_counter()
+    proc = subprocess.run(
+        cmd, shell=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL
+    )
+    elapsed = time.perf_counter() - start
+    return elapsed if proc.returncode == 0 else None
 
-        if not bin_path.exists():
+
+def run_perf(cmd):
+    """One run under `perf stat`, returning {event: count} (best effort)."""
+    proc = subprocess.run(
+        f"perf stat -x, -e {','.join(PERF_EVENTS)} {cmd}",
+        shell=True,
+        stdout=subprocess.DEVNULL,
+        stderr=subprocess.PIPE,
+        text=True,
+    )
+    counters = {}
+    for line in proc.stderr.splitlines():
+        # CSV format: value,unit,event,... ("<not counted>" on failure)
+        parts = line.split(",")
+        if len(parts) < 3:
             continue
+        event = next((e for e in PERF_EVENTS if parts[2].startswith(e)), None)
+        if event and re.fullmatch(r"\d+", parts[0]):
+            counters[event] = int(parts[0])
+    return counters
+
+
+def measure(cmd, warmup, runs, perf=False):
+    for _ in range(warmup):
+        if run_once(cmd) is None:
+            return None
+
+    times = []
+    for _ in range(runs):
+        elapsed = run_once(cmd)
+        if elapsed is None:
+            return None
+        times.append(elapsed)
+
+    median = statistics.median(times)
+    result = {
+        "median": median,
+        "mad": statistics.median(abs(t - median) for t in times),
+        "min": min(times),
+        "max": max(times),
+        "runs": runs,
+    }
+
+    if perf:
+        counters = run_perf(cmd)
+        if counters:
+            result["perf"] = counters
+    return result
+
+
+def fmt_time(seconds):
+    return f"{seconds * 1000:.1f} ms" if seconds < 1 else f"{seconds:.3f} s"
+
+
+def git_commit():
+    proc = subprocess.run(
+        ["git", "rev-parse", "--short", "HEAD"],
+        cwd=path,
+        capture_output=True,
+        text=True,
+    )
+    return proc.stdout.strip() if proc.returncode == 0 else None
+
+
+def compare(results, baseline, threshold):
+    """Print deltas against a baseline; return the flagged regressions."""
+    regressions = []
+    print(f"\nComparison against baseline ({baseline.get('commit', 'unknown')}):")
+    for name, langs in results.items():
+        for ending, stats in langs.items():
+            base = baseline.get("results", {}).get(name, {}).get(ending)
+            if not base or not stats:
+                continue
+            delta = 100 * (stats["median"] / base["median"] - 1)
+            # Both medians must disagree by more than their combined
+            # spread before a delta is trusted.
+            noise = 3 * (stats["mad"] + base.get("mad", 0))
+            significant = (
+                abs(delta) >= threshold
+                and abs(stats["median"] - base["median"]) > noise
+            )
+            marker = ""
+            if significant:
+                marker = "  << REGRESSION" if delta > 0 else "  << improvement"
+                if delta > 0:
+                    regressions.append(f"{name}/{ending}")
+            print(
+                f"  {name}/{ending}: {fmt_time(base['median'])} -> "
+                f"{fmt_time(stats['median'])} ({delta:+.1f}%){marker}"
+            )
+    return regressions
+
+
+def main():
+    args = parse_args()
+
+    tests = collect(args.only)
+    print(f"Collected {len(tests)} tests")
+    compile_tests(tests)
+
+    use_perf = args.perf
+    if use_perf and not shutil.which("perf"):
+        print("perf not found, skipping counter capture", file=sys.stderr)
+        use_perf = False
+
+    results = defaultdict(dict)
+    for name, test in tests.items():
+        print(f"\n# {name}")
+        for ending, filepath in test.items():
+            if not filepath["bin"].exists():
+                continue
+
+            cmd = actions[ending]["run"].format(bin=filepath["bin"])
+            stats = measure(cmd, args.warmup, args.runs, perf=use_perf)
+            results[name][ending] = stats
+            if stats is None:
+                print(f"  {ending:>4}: FAILED")
+                continue
+
+            line = (
+                f"  {ending:>4}: {fmt_time(stats['median'])}"
+                f" ± {fmt_time(stats['mad'])}"
+                f"  (min {fmt_time(stats['min'])}, max {fmt_time(stats['max'])},"
+                f" {stats['runs']} runs)"
+            )
+            if "perf" in stats:
+                perf = stats["perf"]
+                ipc = (
+                    perf["instructions"] / perf["cycles"]
+                    if perf.get("cycles")
+                    else 0
+                )
+                line += (
+                    f"\n        {perf.get('cycles', 0):,} cycles,"
+                    f" {perf.get('instructions', 0):,} instructions"
+                    f" (IPC {ipc:.2f}), {perf.get('cache-misses', 0):,}"
+                    f" cache misses"
+                )
+            print(line)
 
-        run_cmd = actions[ending]["run"].format(bin=bin_path)
+    if args.save_baseline:
+        baseline_path = Path(args.save_baseline)
+        baseline_path.parent.mkdir(parents=True, exist_ok=True)
+        baseline_path.write_text(
+            json.dumps(
+                {
+                    "commit": git_commit(),
+                    "date": datetime.now(timezone.utc).isoformat(),
+                    "warmup": args.warmup,
+                    "runs": args.runs,
+                    "results": results,
+                },
+                indent=2,
+            )
+        )
+        print(f"\nBaseline written to {baseline_path}")
 
-        print("-" * 60)
-        print(f"Language: {ending}")
-        print(f"Command : {run_cmd}")
-        print("-" * 60)
+    if args.baseline:
+        baseline = json.loads(Path(args.baseline).read_text())
+        regressions = compare(results, baseline, args.threshold)
+        if regressions:
+            print(f"\n{len(regressions)} regression(s): {', '.join(regressions)}")
+            sys.exit(1)
 
-        benchmark_cmd = f"hyperfine -N --warmup 10 --runs 50 --style basic '{run_cmd}'"
 
-        subprocess.run(benchmark_cmd, shell=True)
-        print()
+if __name__ == "__main__":
+    main()